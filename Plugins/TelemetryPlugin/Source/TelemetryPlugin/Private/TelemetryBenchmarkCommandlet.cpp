@@ -0,0 +1,320 @@
+#include "TelemetryBenchmarkCommandlet.h"
+
+// Runs against the local collector, which shipping builds leave out
+#if !UE_BUILD_SHIPPING
+#include "TelemetrySubsystem.h"
+#include "TelemetryLocalCollector.h"
+#include "TelemetryCountingMalloc.h"
+#include "InputAction.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	/** Not timed - lets queues, batch and body buffers reach their working size */
+	constexpr double WarmupSeconds = 1.0;
+
+	/** Give up waiting for the collector after this long */
+	constexpr double DrainTimeoutSeconds = 15.0;
+
+	/** Advance HTTP client and server until Predicate holds or the timeout passes */
+	template <typename PredicateType>
+	void TickUntil(PredicateType&& Predicate, double TimeoutSeconds)
+	{
+		const double EndTime = FPlatformTime::Seconds() + TimeoutSeconds;
+		double LastTime = FPlatformTime::Seconds();
+		while (!Predicate() && FPlatformTime::Seconds() < EndTime)
+		{
+			const double Now = FPlatformTime::Seconds();
+			FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTime));
+			LastTime = Now;
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+}
+#endif
+
+UTelemetryBenchmarkCommandlet::UTelemetryBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Benchmark the telemetry pipeline against a local collector");
+	HelpUsage = TEXT("-run=TelemetryBenchmark [-Rate=2000] [-Duration=10] [-Format=Json|NDJson|Binary] [-Compression=None|Gzip|Deflate] [-Output=<path>]");
+}
+
+int32 UTelemetryBenchmarkCommandlet::Main(const FString& Params)
+{
+#if UE_BUILD_SHIPPING
+	UE_LOG(LogTemp, Error, TEXT("[Telemetry] TelemetryBenchmark is not available in shipping builds"));
+	return 1;
+#else
+	const TCHAR* Cmd = *Params;
+
+	// Scenario
+	int32 Rate = 2000;
+	float Duration = 10.0f;
+	int32 FrameRate = 60;
+	int32 BatchSize = 50;
+	float FlushInterval = 2.0f;
+	int32 Port = 18080;
+	FString FormatName = TEXT("Json");
+	FString CompressionName = TEXT("None");
+	FString OutputPath;
+	FString ExternalURL;
+	FParse::Value(Cmd, TEXT("Rate="), Rate);
+	FParse::Value(Cmd, TEXT("Duration="), Duration);
+	FParse::Value(Cmd, TEXT("FrameRate="), FrameRate);
+	FParse::Value(Cmd, TEXT("BatchSize="), BatchSize);
+	FParse::Value(Cmd, TEXT("FlushInterval="), FlushInterval);
+	FParse::Value(Cmd, TEXT("Port="), Port);
+	FParse::Value(Cmd, TEXT("Format="), FormatName);
+	FParse::Value(Cmd, TEXT("Compression="), CompressionName);
+	FParse::Value(Cmd, TEXT("Output="), OutputPath);
+	FParse::Value(Cmd, TEXT("URL="), ExternalURL);
+	const bool bLocalCollector = ExternalURL.IsEmpty();
+
+	Rate = FMath::Max(1, Rate);
+	FrameRate = FMath::Max(1, FrameRate);
+
+	const ETelemetryWireFormat WireFormat = FormatName == TEXT("Binary") ? ETelemetryWireFormat::Binary : ETelemetryWireFormat::Json;
+	const ETelemetryBatchFormat BatchFormat = FormatName == TEXT("NDJson") ? ETelemetryBatchFormat::NDJson : ETelemetryBatchFormat::JsonArray;
+	ETelemetryCompression Compression = ETelemetryCompression::None;
+	if (CompressionName == TEXT("Gzip"))
+	{
+		Compression = ETelemetryCompression::Gzip;
+	}
+	else if (CompressionName == TEXT("Deflate"))
+	{
+		Compression = ETelemetryCompression::Deflate;
+	}
+
+	// Local collector, unless this run is one of many clients of a shared TelemetryCollector
+	FTelemetryLocalCollector Collector(Port);
+	if (bLocalCollector && !Collector.Start())
+	{
+		return 1;
+	}
+	const double ClockOrigin = FPlatformTime::Seconds();
+	Collector.SetClockOrigin(ClockOrigin);
+
+	// Subsystem, through a standalone game instance like the game would own it
+	TStrongObjectPtr<UGameInstance> GameInstance(NewObject<UGameInstance>(GEngine));
+	GameInstance->InitializeStandalone();
+	UTelemetrySubsystem* Telemetry = GameInstance->GetSubsystem<UTelemetrySubsystem>();
+	if (!Telemetry)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Benchmark could not create the telemetry subsystem"));
+		return 1;
+	}
+
+	// Before StartNewSession, so the game's own spooled batches are not replayed to the local collector
+	Telemetry->ConfigureSpool(false, 1);
+	Telemetry->ConfigureAdaptivePositionSampling(FTelemetryAdaptiveSamplingSettings());
+	Telemetry->Configure(bLocalCollector ? Collector.GetURL() : ExternalURL, WireFormat);
+	Telemetry->ConfigureBatching(BatchSize, FlushInterval, BatchFormat);
+	Telemetry->ConfigureCompression(Compression, 1024);
+	Telemetry->StartNewSession();
+	Telemetry->StartRun();
+
+	TArray<TStrongObjectPtr<UInputAction>> InputActions;
+	for (const TCHAR* ActionName : {TEXT("IA_Jump"), TEXT("IA_Move"), TEXT("IA_Attack"), TEXT("IA_Dash")})
+	{
+		InputActions.Emplace(NewObject<UInputAction>(GetTransientPackage(), ActionName));
+	}
+
+	// Typical mix: mostly position, some input, occasional damage and death
+	int64 EventIndex = 0;
+	auto SendEvent = [&](double GameTime)
+	{
+		const float Time = static_cast<float>(GameTime);
+		const FVector Position(EventIndex * 3.0, 0.0, 100.0 + FMath::Sin(GameTime) * 50.0);
+		const int64 Slot = EventIndex++ % 100;
+		if (Slot < 80)
+		{
+			Telemetry->SendPositionUpdate(Position, Time);
+		}
+		else if (Slot < 95)
+		{
+			Telemetry->SendPlayerInputAction(InputActions[Slot % InputActions.Num()].Get(), Time);
+		}
+		else if (Slot < 99)
+		{
+			Telemetry->SendDamageEvent(10.0f, 100.0f, 90.0f, TEXT("Spikes"), Position, Time);
+		}
+		else
+		{
+			Telemetry->SendDeathEvent(TEXT("Spikes"), Position, Time);
+		}
+	};
+
+	FTelemetryCountingMalloc& CountingMalloc = FTelemetryCountingMalloc::Get();
+	CountingMalloc.ResetAllocationCount();
+	const double FrameSeconds = 1.0 / FrameRate;
+	const double EventsPerFrame = static_cast<double>(Rate) / FrameRate;
+
+	int64 MeasuredEvents = 0;
+	uint64 MeasuredCycles = 0;
+	TArray<double> FrameNsPerEvent;
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Benchmark: %d events/s for %.1fs, %s/%s, batch %d"),
+		Rate, Duration, *FormatName, *CompressionName, BatchSize);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double MeasureStart = StartTime + WarmupSeconds;
+	const double EndTime = MeasureStart + Duration;
+	double EventBudget = 0.0;
+	double LastFrameTime = StartTime;
+
+	while (FPlatformTime::Seconds() < EndTime)
+	{
+		const double FrameStart = FPlatformTime::Seconds();
+		const bool bMeasuring = FrameStart >= MeasureStart;
+
+		EventBudget += EventsPerFrame;
+		const int32 NumEvents = FMath::FloorToInt32(EventBudget);
+		EventBudget -= NumEvents;
+
+		if (bMeasuring)
+		{
+			CountingMalloc.StartCounting();
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Index = 0; Index < NumEvents; ++Index)
+		{
+			SendEvent(FPlatformTime::Seconds() - ClockOrigin);
+		}
+		const uint64 FrameCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		if (bMeasuring)
+		{
+			CountingMalloc.StopCounting();
+			MeasuredCycles += FrameCycles;
+			MeasuredEvents += NumEvents;
+			if (NumEvents > 0)
+			{
+				FrameNsPerEvent.Add(FPlatformTime::ToMilliseconds64(FrameCycles) * 1.0e6 / NumEvents);
+			}
+		}
+
+		// Let the HTTP client and the collector run, then wait out the frame
+		const double Now = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastFrameTime));
+		LastFrameTime = Now;
+
+		const double Remaining = FrameStart + FrameSeconds - FPlatformTime::Seconds();
+		if (Remaining > 0.0)
+		{
+			FPlatformProcess::Sleep(static_cast<float>(Remaining));
+		}
+	}
+
+	Telemetry->EndRun(TEXT("benchmark"));
+	Telemetry->EndSession();
+
+	// Sampling, coalescing, summaries and delivery reports make the calls a poor guide to what goes out -
+	// the worker counts what it actually put into upload bodies, so wait for it to finish uploading
+	FTelemetryBackpressureStats Backpressure;
+	TickUntil([&]()
+	{
+		Backpressure = Telemetry->GetBackpressureStats();
+		const bool bUploaded = Backpressure.BacklogEvents == 0 && Backpressure.WaitingBatches == 0 && Backpressure.InFlightRequests == 0;
+		return bUploaded && (!bLocalCollector || Collector.GetStats().Events >= Backpressure.UploadedEvents);
+	}, DrainTimeoutSeconds);
+	const int64 EventsSent = Backpressure.UploadedEvents;
+	const int64 EventsDropped = Backpressure.DroppedEvents + Backpressure.ShedEvents;
+
+	const FTelemetryCompressionStats CompressionStats = Telemetry->GetCompressionStats();
+	GameInstance->Shutdown();
+	GameInstance.Reset();
+
+	// Report
+	FTelemetryLocalCollector::FStats Stats = Collector.GetStats();
+	Collector.Stop();
+
+	Stats.LatenciesMs.Sort();
+	FrameNsPerEvent.Sort();
+
+	const double NsPerEvent = MeasuredEvents > 0 ? FPlatformTime::ToMilliseconds64(MeasuredCycles) * 1.0e6 / MeasuredEvents : 0.0;
+	const double AllocationsPerEvent = MeasuredEvents > 0 ? static_cast<double>(CountingMalloc.GetAllocationCount()) / MeasuredEvents : 0.0;
+	const double WireBytesPerEvent = Stats.Events > 0 ? static_cast<double>(Stats.WireBytes) / Stats.Events : 0.0;
+
+	TSharedRef<FJsonObject> Scenario = MakeShared<FJsonObject>();
+	Scenario->SetNumberField(TEXT("rate"), Rate);
+	Scenario->SetNumberField(TEXT("duration_s"), Duration);
+	Scenario->SetNumberField(TEXT("frame_rate"), FrameRate);
+	Scenario->SetStringField(TEXT("format"), FormatName);
+	Scenario->SetStringField(TEXT("compression"), CompressionName);
+	Scenario->SetNumberField(TEXT("batch_size"), BatchSize);
+	Scenario->SetNumberField(TEXT("flush_interval_s"), FlushInterval);
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("benchmark"), TEXT("telemetry"));
+	Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Report->SetStringField(TEXT("machine_id"), FPlatformProcess::ComputerName());
+	Report->SetObjectField(TEXT("scenario"), Scenario);
+	Report->SetNumberField(TEXT("events_generated"), EventIndex);
+	Report->SetNumberField(TEXT("events_sent"), EventsSent);
+	Report->SetNumberField(TEXT("events_measured"), MeasuredEvents);
+	Report->SetNumberField(TEXT("events_delivered"), Stats.Events);
+	Report->SetNumberField(TEXT("events_dropped"), Backpressure.DroppedEvents);
+	Report->SetNumberField(TEXT("events_shed"), Backpressure.ShedEvents);
+	Report->SetNumberField(TEXT("uploads_retried"), Backpressure.RetriedUploads);
+	Report->SetNumberField(TEXT("uploads_failed"), Backpressure.FailedUploads);
+	Report->SetNumberField(TEXT("events_lost"), FMath::Max<int64>(0, EventsSent - Stats.Events));
+	Report->SetNumberField(TEXT("sequence_gaps"), Stats.MissingEvents);
+	Report->SetNumberField(TEXT("duplicate_events"), Stats.DuplicateEvents);
+	Report->SetNumberField(TEXT("duplicate_batches"), Stats.DuplicateBatches);
+	Report->SetNumberField(TEXT("game_thread_ns_per_event"), NsPerEvent);
+	Report->SetNumberField(TEXT("game_thread_ns_per_event_p99_frame"), FTelemetryLocalCollector::GetPercentile(FrameNsPerEvent, 0.99));
+	Report->SetNumberField(TEXT("allocations_per_event"), AllocationsPerEvent);
+	Report->SetNumberField(TEXT("requests"), Stats.Requests);
+	Report->SetNumberField(TEXT("rejected_requests"), Stats.RejectedRequests);
+	Report->SetNumberField(TEXT("wire_bytes"), Stats.WireBytes);
+	Report->SetNumberField(TEXT("decoded_bytes"), Stats.DecodedBytes);
+	Report->SetNumberField(TEXT("wire_bytes_per_event"), WireBytesPerEvent);
+	Report->SetNumberField(TEXT("compression_ratio"), CompressionStats.GetRatio());
+	Report->SetNumberField(TEXT("latency_ms_p50"), FTelemetryLocalCollector::GetPercentile(Stats.LatenciesMs, 0.50));
+	Report->SetNumberField(TEXT("latency_ms_p95"), FTelemetryLocalCollector::GetPercentile(Stats.LatenciesMs, 0.95));
+	Report->SetNumberField(TEXT("latency_ms_p99"), FTelemetryLocalCollector::GetPercentile(Stats.LatenciesMs, 0.99));
+	Report->SetNumberField(TEXT("latency_ms_max"), Stats.LatenciesMs.IsEmpty() ? 0.0 : Stats.LatenciesMs.Last());
+
+	FString ReportString;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportString));
+
+	if (OutputPath.IsEmpty())
+	{
+		OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("Benchmark"),
+			FString::Printf(TEXT("TelemetryBenchmark_%s.json"), *FDateTime::Now().ToString()));
+	}
+	if (!FFileHelper::SaveStringToFile(ReportString, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Could not write benchmark report to %s"), *OutputPath);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Benchmark: %.1f ns/event, %.3f allocs/event, %.1f wire bytes/event, latency p50 %.1f ms p99 %.1f ms, %lld/%lld delivered, %lld dropped"),
+		NsPerEvent, AllocationsPerEvent, WireBytesPerEvent,
+		FTelemetryLocalCollector::GetPercentile(Stats.LatenciesMs, 0.50), FTelemetryLocalCollector::GetPercentile(Stats.LatenciesMs, 0.99),
+		Stats.Events, EventsSent, EventsDropped);
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Benchmark report written to %s"), *OutputPath);
+
+	// Delivery is only known to the external collector
+	if (bLocalCollector && Stats.Events != EventsSent)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Benchmark collector received %lld events, the client uploaded %lld"), Stats.Events, EventsSent);
+		return 1;
+	}
+	return 0;
+#endif
+}
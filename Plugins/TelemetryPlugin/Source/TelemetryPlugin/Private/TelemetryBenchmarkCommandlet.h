@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TelemetryBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless benchmark of the telemetry pipeline
+ * Drives UTelemetrySubsystem through its public API at a fixed event rate against an in-process
+ * local collector, then writes a JSON report: game thread ns/event, allocations/event,
+ * bytes on the wire, capture-to-collector latency and dropped events.
+ *
+ * USAGE:
+ * UnrealEditor-Cmd <Project> -run=TelemetryBenchmark [-Rate=2000] [-Duration=10] [-FrameRate=60]
+ *     [-Format=Json|NDJson|Binary] [-Compression=None|Gzip|Deflate] [-BatchSize=50]
+ *     [-FlushInterval=2] [-Port=18080] [-URL=<collector>] [-Output=<path>]
+ * With -URL the events go to an external collector (e.g. a shared TelemetryCollector run), and
+ * delivery, bytes and latency are only reported by that collector.
+ * Returns non-zero if no events reached the local collector.
+ */
+UCLASS()
+class UTelemetryBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTelemetryBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,405 @@
+#include "TelemetryBinaryFormat.h"
+#include "TelemetryStringTable.h"
+#include "Containers/StringConv.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "TelemetryBinaryFormat writes native byte order and assumes little-endian");
+
+namespace TelemetryBinaryFormat
+{
+	namespace
+	{
+		/** Common record prefix: type tag, frame, game time, sequence, engine frame and capture time deltas */
+		constexpr int32 CommonSize = sizeof(uint8) + sizeof(int32) + sizeof(float) + 3 * sizeof(int32);
+
+		/** Version 1 records had only the type tag, frame and game time */
+		constexpr int32 CommonSizeV1 = sizeof(uint8) + sizeof(int32) + sizeof(float);
+		constexpr int32 HeaderSizeV1 = 24;
+		constexpr int32 PositionSize = 3 * sizeof(float);
+		constexpr int32 StringIndexSize = sizeof(uint16);
+
+		/** Appends raw little-endian values to a byte array */
+		struct FByteWriter
+		{
+			TArray<uint8>& Data;
+
+			template <typename T>
+			void Write(T Value)
+			{
+				static_assert(std::is_arithmetic_v<T>, "Only plain numeric values go on the wire");
+				const int32 Offset = Data.AddUninitialized(sizeof(T));
+				FMemory::Memcpy(Data.GetData() + Offset, &Value, sizeof(T));
+			}
+
+			void WriteBytes(const void* Bytes, int32 Num)
+			{
+				Data.Append(static_cast<const uint8*>(Bytes), Num);
+			}
+		};
+
+		/** Bounds-checked reader over an encoded batch */
+		struct FByteReader
+		{
+			TConstArrayView<uint8> Data;
+			int32 Offset = 0;
+			bool bOverflow = false;
+
+			template <typename T>
+			T Read()
+			{
+				T Value{};
+				if (Offset + static_cast<int32>(sizeof(T)) > Data.Num())
+				{
+					bOverflow = true;
+					return Value;
+				}
+				FMemory::Memcpy(&Value, Data.GetData() + Offset, sizeof(T));
+				Offset += sizeof(T);
+				return Value;
+			}
+
+			FString ReadString()
+			{
+				const uint16 Length = Read<uint16>();
+				if (bOverflow || Offset + Length > Data.Num())
+				{
+					bOverflow = true;
+					return FString();
+				}
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const UTF8CHAR*>(Data.GetData() + Offset), Length);
+				Offset += Length;
+				return FString(Converted.Length(), Converted.Get());
+			}
+		};
+
+		/** Deduplicating string table written after the header */
+		struct FStringTable
+		{
+			TArray<FString> Strings;
+			TMap<FName, uint16> NameIndices;
+			TMap<uint32, uint16> SessionStringIndices;
+
+			uint16 Add(const FString& Value)
+			{
+				if (Strings.Num() >= MAX_uint16)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Binary string table full - dropping string '%s'"), *Value);
+					return 0;
+				}
+				return static_cast<uint16>(Strings.Add(Value));
+			}
+
+			uint16 Add(FName Name)
+			{
+				if (const uint16* Existing = NameIndices.Find(Name))
+				{
+					return *Existing;
+				}
+				const uint16 Index = Add(Name.ToString());
+				NameIndices.Add(Name, Index);
+				return Index;
+			}
+
+			uint16 Add(const FTelemetryStringTable* SessionStrings, uint32 SessionIndex)
+			{
+				if (const uint16* Existing = SessionStringIndices.Find(SessionIndex))
+				{
+					return *Existing;
+				}
+				static const FString Empty;
+				const uint16 Index = Add(SessionStrings ? SessionStrings->Get(SessionIndex) : Empty);
+				SessionStringIndices.Add(SessionIndex, Index);
+				return Index;
+			}
+		};
+
+		bool HasStringPayload(ETelemetryEventType Type, uint16 Version = SchemaVersion)
+		{
+			// Run IDs and end reasons joined the string table in version 3
+			const bool bIsRunRecord = Type == ETelemetryEventType::RunStart || Type == ETelemetryEventType::RunEnd;
+			return Type == ETelemetryEventType::InputReceived
+				|| Type == ETelemetryEventType::Damage
+				|| Type == ETelemetryEventType::Death
+				|| (bIsRunRecord && Version >= 3);
+		}
+	}
+
+	int32 GetRecordSize(ETelemetryEventType Type)
+	{
+		switch (Type)
+		{
+		case ETelemetryEventType::SessionStart:
+		case ETelemetryEventType::SessionEnd:
+			return CommonSize;
+		case ETelemetryEventType::Position:
+			return CommonSize + PositionSize;
+		case ETelemetryEventType::RunStart:
+		case ETelemetryEventType::RunEnd:
+		case ETelemetryEventType::InputReceived:
+			return CommonSize + StringIndexSize;
+		case ETelemetryEventType::Damage:
+			return CommonSize + PositionSize + 3 * sizeof(float) + StringIndexSize;
+		case ETelemetryEventType::Death:
+			return CommonSize + PositionSize + StringIndexSize;
+		default:
+			return INDEX_NONE;
+		}
+	}
+
+	void EncodeBatch(
+		const FString& MachineID,
+		const FString& SessionID,
+		const FTelemetryStringTable* SessionStrings,
+		TConstArrayView<FTelemetryEventRecord> Records,
+		TArray<uint8>& OutData)
+	{
+		// Build string table and size the output up front
+		FStringTable StringTable;
+		StringTable.Add(MachineID);
+		StringTable.Add(SessionID);
+
+		TArray<uint16, TInlineAllocator<64>> StringIndices;
+		StringIndices.SetNumUninitialized(Records.Num());
+
+		int32 EventCount = 0;
+		int32 RecordBytes = 0;
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			const FTelemetryEventRecord& Record = Records[Index];
+			const int32 RecordSize = GetRecordSize(Record.Type);
+			if (RecordSize == INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (Record.Type == ETelemetryEventType::InputReceived)
+			{
+				StringIndices[Index] = StringTable.Add(Record.Name);
+			}
+			else
+			{
+				StringIndices[Index] = HasStringPayload(Record.Type) ? StringTable.Add(SessionStrings, Record.StringIndex) : 0;
+			}
+			RecordBytes += RecordSize;
+			++EventCount;
+		}
+
+		// ASCII estimate - IDs and asset names rarely need more
+		int32 StringBytes = 0;
+		for (const FString& String : StringTable.Strings)
+		{
+			StringBytes += sizeof(uint16) + String.Len();
+		}
+
+		OutData.Reserve(OutData.Num() + HeaderSize + StringBytes + RecordBytes);
+		FByteWriter Writer{OutData};
+
+		// Header
+		const FTelemetryEventRecord* FirstRecord = Records.Num() > 0 ? &Records[0] : nullptr;
+		const int32 BaseFrame = FirstRecord ? FirstRecord->Frame : 0;
+		const float BaseGameTime = FirstRecord ? FirstRecord->GameTime : 0.0f;
+		const uint32 BaseSequence = FirstRecord ? FirstRecord->Sequence : 0;
+		const uint32 BaseEngineFrame = FirstRecord ? FirstRecord->EngineFrame : 0;
+		const double BaseCaptureTime = FirstRecord ? FirstRecord->CaptureTime : 0.0;
+
+		Writer.Write<uint32>(Magic);
+		Writer.Write<uint16>(SchemaVersion);
+		Writer.Write<uint16>(0);
+		Writer.Write<uint32>(EventCount);
+		Writer.Write<uint16>(static_cast<uint16>(StringTable.Strings.Num()));
+		Writer.Write<uint16>(0);
+		Writer.Write<int32>(BaseFrame);
+		Writer.Write<float>(BaseGameTime);
+		Writer.Write<uint32>(BaseSequence);
+		Writer.Write<uint32>(BaseEngineFrame);
+		Writer.Write<double>(BaseCaptureTime);
+
+		// String table
+		for (const FString& String : StringTable.Strings)
+		{
+			const FTCHARToUTF8 Utf8(*String, String.Len());
+			const uint16 Length = static_cast<uint16>(FMath::Min(Utf8.Length(), static_cast<int32>(MAX_uint16)));
+			Writer.Write<uint16>(Length);
+			Writer.WriteBytes(Utf8.Get(), Length);
+		}
+
+		// Records - game time is tracked exactly as the decoder will rebuild it, so deltas never drift
+		int32 PrevFrame = BaseFrame;
+		float PrevGameTime = BaseGameTime;
+		uint32 PrevSequence = BaseSequence;
+		uint32 PrevEngineFrame = BaseEngineFrame;
+		int64 PrevCaptureMicros = 0;
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			const FTelemetryEventRecord& Record = Records[Index];
+			if (GetRecordSize(Record.Type) == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const float GameTimeDelta = Record.GameTime - PrevGameTime;
+			Writer.Write<uint8>(static_cast<uint8>(Record.Type));
+			Writer.Write<int32>(Record.Frame - PrevFrame);
+			Writer.Write<float>(GameTimeDelta);
+			PrevFrame = Record.Frame;
+			PrevGameTime += GameTimeDelta;
+
+			// Capture times are kept in whole microseconds from the base, so they do not drift either
+			const int64 CaptureMicros = FMath::RoundToInt64((Record.CaptureTime - BaseCaptureTime) * 1000000.0);
+			Writer.Write<int32>(static_cast<int32>(Record.Sequence - PrevSequence));
+			Writer.Write<int32>(static_cast<int32>(Record.EngineFrame - PrevEngineFrame));
+			Writer.Write<int32>(static_cast<int32>(CaptureMicros - PrevCaptureMicros));
+			PrevSequence = Record.Sequence;
+			PrevEngineFrame = Record.EngineFrame;
+			PrevCaptureMicros = CaptureMicros;
+
+			if (Record.HasPosition())
+			{
+				Writer.Write<float>(Record.Position.X);
+				Writer.Write<float>(Record.Position.Y);
+				Writer.Write<float>(Record.Position.Z);
+			}
+
+			if (Record.Type == ETelemetryEventType::Damage)
+			{
+				Writer.Write<float>(Record.DamageAmount);
+				Writer.Write<float>(Record.HealthBefore);
+				Writer.Write<float>(Record.HealthAfter);
+			}
+
+			if (HasStringPayload(Record.Type))
+			{
+				Writer.Write<uint16>(StringIndices[Index]);
+			}
+		}
+	}
+
+	bool DecodeBatch(TConstArrayView<uint8> Data, FDecodedBatch& OutBatch, FString* OutError)
+	{
+		auto Fail = [OutError](const TCHAR* Message)
+		{
+			if (OutError)
+			{
+				*OutError = Message;
+			}
+			return false;
+		};
+
+		FByteReader Reader{Data};
+
+		if (Data.Num() < HeaderSizeV1)
+		{
+			return Fail(TEXT("Batch shorter than header"));
+		}
+
+		if (Reader.Read<uint32>() != Magic)
+		{
+			return Fail(TEXT("Bad magic"));
+		}
+
+		OutBatch.SchemaVersion = Reader.Read<uint16>();
+		if (OutBatch.SchemaVersion < 1 || OutBatch.SchemaVersion > SchemaVersion)
+		{
+			return Fail(TEXT("Unsupported schema version"));
+		}
+		const bool bHasTiming = OutBatch.SchemaVersion >= 2;
+
+		Reader.Read<uint16>(); // Flags
+		const uint32 EventCount = Reader.Read<uint32>();
+		const uint16 StringCount = Reader.Read<uint16>();
+		Reader.Read<uint16>(); // Reserved
+		int32 Frame = Reader.Read<int32>();
+		float GameTime = Reader.Read<float>();
+		uint32 Sequence = bHasTiming ? Reader.Read<uint32>() : 0;
+		uint32 EngineFrame = bHasTiming ? Reader.Read<uint32>() : 0;
+		const double BaseCaptureTime = bHasTiming ? Reader.Read<double>() : 0.0;
+		int64 CaptureMicros = 0;
+
+		if (StringCount < 2)
+		{
+			return Fail(TEXT("String table missing machine/session IDs"));
+		}
+
+		TArray<FString>& Strings = OutBatch.Strings;
+		Strings.Reset(StringCount);
+		for (uint16 Index = 0; Index < StringCount; ++Index)
+		{
+			Strings.Add(Reader.ReadString());
+		}
+
+		if (Reader.bOverflow)
+		{
+			return Fail(TEXT("Truncated string table"));
+		}
+
+		OutBatch.MachineID = Strings[0];
+		OutBatch.SessionID = Strings[1];
+
+		// Guard the reservation against a corrupt count
+		OutBatch.Records.Reset();
+		OutBatch.Records.Reserve(FMath::Min<uint32>(EventCount, Data.Num() / (bHasTiming ? CommonSize : CommonSizeV1)));
+
+		for (uint32 EventIndex = 0; EventIndex < EventCount; ++EventIndex)
+		{
+			FTelemetryEventRecord& Record = OutBatch.Records.AddDefaulted_GetRef();
+			Record.Type = static_cast<ETelemetryEventType>(Reader.Read<uint8>());
+			if (GetRecordSize(Record.Type) == INDEX_NONE)
+			{
+				return Fail(TEXT("Unknown event type tag"));
+			}
+
+			Frame += Reader.Read<int32>();
+			GameTime += Reader.Read<float>();
+			Record.Frame = Frame;
+			Record.GameTime = GameTime;
+
+			if (bHasTiming)
+			{
+				Sequence += static_cast<uint32>(Reader.Read<int32>());
+				EngineFrame += static_cast<uint32>(Reader.Read<int32>());
+				CaptureMicros += Reader.Read<int32>();
+				Record.Sequence = Sequence;
+				Record.EngineFrame = EngineFrame;
+				Record.CaptureTime = BaseCaptureTime + CaptureMicros / 1000000.0;
+			}
+
+			if (Record.HasPosition())
+			{
+				Record.Position.X = Reader.Read<float>();
+				Record.Position.Y = Reader.Read<float>();
+				Record.Position.Z = Reader.Read<float>();
+			}
+
+			if (Record.Type == ETelemetryEventType::Damage)
+			{
+				Record.DamageAmount = Reader.Read<float>();
+				Record.HealthBefore = Reader.Read<float>();
+				Record.HealthAfter = Reader.Read<float>();
+			}
+
+			if (HasStringPayload(Record.Type, OutBatch.SchemaVersion))
+			{
+				const uint16 StringIndex = Reader.Read<uint16>();
+				if (!Strings.IsValidIndex(StringIndex))
+				{
+					return Fail(TEXT("String index out of range"));
+				}
+				// Action names are asset names; free-form strings stay in the batch's own table
+				if (Record.Type == ETelemetryEventType::InputReceived)
+				{
+					Record.Name = FName(*Strings[StringIndex]);
+				}
+				else
+				{
+					Record.StringIndex = StringIndex;
+				}
+			}
+
+			if (Reader.bOverflow)
+			{
+				return Fail(TEXT("Truncated record"));
+			}
+		}
+
+		return true;
+	}
+}
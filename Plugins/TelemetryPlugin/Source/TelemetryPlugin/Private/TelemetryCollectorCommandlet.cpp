@@ -0,0 +1,139 @@
+#include "TelemetryCollectorCommandlet.h"
+
+// Serves the local collector, which shipping builds leave out
+#if !UE_BUILD_SHIPPING
+#include "TelemetryLocalCollector.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+#endif
+
+UTelemetryCollectorCommandlet::UTelemetryCollectorCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Run a local mock telemetry collector with optional fault injection");
+	HelpUsage = TEXT("-run=TelemetryCollector [-Port=18080] [-Duration=0] [-Latency=<ms>] [-Jitter=<ms>] [-ErrorRate=0] [-TimeoutRate=0] [-Seed=0] [-Output=<path>]");
+}
+
+int32 UTelemetryCollectorCommandlet::Main(const FString& Params)
+{
+#if UE_BUILD_SHIPPING
+	UE_LOG(LogTemp, Error, TEXT("[Telemetry] TelemetryCollector is not available in shipping builds"));
+	return 1;
+#else
+	const TCHAR* Cmd = *Params;
+
+	int32 Port = 18080;
+	FString Path = TEXT("/telemetry");
+	float Duration = 0.0f;
+	float ReportInterval = 5.0f;
+	FString OutputPath;
+	FTelemetryLocalCollector::FFaultSettings Faults;
+	FParse::Value(Cmd, TEXT("Port="), Port);
+	FParse::Value(Cmd, TEXT("Path="), Path);
+	FParse::Value(Cmd, TEXT("Duration="), Duration);
+	FParse::Value(Cmd, TEXT("ReportInterval="), ReportInterval);
+	FParse::Value(Cmd, TEXT("Output="), OutputPath);
+	FParse::Value(Cmd, TEXT("Latency="), Faults.LatencyMs);
+	FParse::Value(Cmd, TEXT("Jitter="), Faults.LatencyJitterMs);
+	FParse::Value(Cmd, TEXT("ErrorRate="), Faults.ErrorRate);
+	FParse::Value(Cmd, TEXT("TimeoutRate="), Faults.TimeoutRate);
+	FParse::Value(Cmd, TEXT("Seed="), Faults.Seed);
+
+	FTelemetryLocalCollector Collector(Port, Path);
+	Collector.SetFaults(Faults);
+	if (!Collector.Start())
+	{
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Collector: latency %.0f+%.0f ms, errors %.1f%%, timeouts %.1f%%, seed %d"),
+		Faults.LatencyMs, Faults.LatencyJitterMs, Faults.ErrorRate * 100.0f, Faults.TimeoutRate * 100.0f, Faults.Seed);
+
+	const double StartTime = FPlatformTime::Seconds();
+	double LastTime = StartTime;
+	double LastReportTime = StartTime;
+	FTelemetryLocalCollector::FStats LastStats;
+
+	while (!IsEngineExitRequested() && (Duration <= 0.0f || FPlatformTime::Seconds() - StartTime < Duration))
+	{
+		const double Now = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTime));
+		LastTime = Now;
+
+		if (ReportInterval > 0.0f && Now - LastReportTime >= ReportInterval)
+		{
+			const FTelemetryLocalCollector::FStats& Stats = Collector.GetStats();
+			const double Elapsed = Now - LastReportTime;
+			UE_LOG(LogTemp, Display, TEXT("[Telemetry] Collector: %.1f req/s, %.0f events/s, %.1f KB/s, %lld rejected, %d delayed"),
+				(Stats.Requests - LastStats.Requests) / Elapsed,
+				(Stats.Events - LastStats.Events) / Elapsed,
+				(Stats.WireBytes - LastStats.WireBytes) / Elapsed / 1024.0,
+				Stats.RejectedRequests, Collector.GetNumDelayedResponses());
+
+			LastStats.Requests = Stats.Requests;
+			LastStats.Events = Stats.Events;
+			LastStats.WireBytes = Stats.WireBytes;
+			LastReportTime = Now;
+		}
+
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_DOUBLE_SMALL_NUMBER);
+	FTelemetryLocalCollector::FStats Stats = Collector.GetStats();
+	Collector.Stop();
+
+	Stats.RequestMs.Sort();
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("collector"), TEXT("telemetry"));
+	Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Report->SetNumberField(TEXT("duration_s"), Elapsed);
+	Report->SetNumberField(TEXT("latency_ms"), Faults.LatencyMs);
+	Report->SetNumberField(TEXT("jitter_ms"), Faults.LatencyJitterMs);
+	Report->SetNumberField(TEXT("error_rate"), Faults.ErrorRate);
+	Report->SetNumberField(TEXT("timeout_rate"), Faults.TimeoutRate);
+	Report->SetNumberField(TEXT("seed"), Faults.Seed);
+	Report->SetNumberField(TEXT("requests"), Stats.Requests);
+	Report->SetNumberField(TEXT("rejected_requests"), Stats.RejectedRequests);
+	Report->SetNumberField(TEXT("injected_errors"), Stats.InjectedErrors);
+	Report->SetNumberField(TEXT("injected_timeouts"), Stats.InjectedTimeouts);
+	Report->SetNumberField(TEXT("events"), Stats.Events);
+	Report->SetNumberField(TEXT("sequence_gaps"), Stats.MissingEvents);
+	Report->SetNumberField(TEXT("duplicate_events"), Stats.DuplicateEvents);
+	Report->SetNumberField(TEXT("duplicate_batches"), Stats.DuplicateBatches);
+	Report->SetNumberField(TEXT("wire_bytes"), Stats.WireBytes);
+	Report->SetNumberField(TEXT("decoded_bytes"), Stats.DecodedBytes);
+	Report->SetNumberField(TEXT("requests_per_s"), Stats.Requests / Elapsed);
+	Report->SetNumberField(TEXT("events_per_s"), Stats.Events / Elapsed);
+	Report->SetNumberField(TEXT("request_ms_p50"), FTelemetryLocalCollector::GetPercentile(Stats.RequestMs, 0.50));
+	Report->SetNumberField(TEXT("request_ms_p99"), FTelemetryLocalCollector::GetPercentile(Stats.RequestMs, 0.99));
+	Report->SetNumberField(TEXT("request_ms_max"), Stats.RequestMs.IsEmpty() ? 0.0 : Stats.RequestMs.Last());
+
+	FString ReportString;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportString));
+
+	if (OutputPath.IsEmpty())
+	{
+		OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("Collector"),
+			FString::Printf(TEXT("TelemetryCollector_%s.json"), *FDateTime::Now().ToString()));
+	}
+	if (!FFileHelper::SaveStringToFile(ReportString, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Could not write collector report to %s"), *OutputPath);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Collector: %lld requests, %lld events, %lld rejected - report written to %s"),
+		Stats.Requests, Stats.Events, Stats.RejectedRequests, *OutputPath);
+
+	return Stats.RejectedRequests > 0 ? 1 : 0;
+#endif
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TelemetryCollectorCommandlet.generated.h"
+
+/**
+ * Standalone mock collector for load tests
+ * Serves FTelemetryLocalCollector until the duration passes or the process is asked to exit,
+ * logging throughput every report interval and writing a JSON summary at the end.
+ * Point any number of game clients or TelemetryBenchmark runs (-URL=) at it.
+ *
+ * USAGE:
+ * UnrealEditor-Cmd <Project> -run=TelemetryCollector [-Port=18080] [-Path=/telemetry] [-Duration=0]
+ *     [-Latency=<ms>] [-Jitter=<ms>] [-ErrorRate=0.0] [-TimeoutRate=0.0] [-Seed=0]
+ *     [-ReportInterval=5] [-Output=<path>]
+ * Duration 0 runs until Ctrl+C.
+ */
+UCLASS()
+class UTelemetryCollectorCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTelemetryCollectorCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,114 @@
+#include "TelemetryCompression.h"
+#include "Misc/Compression.h"
+
+#if !UE_BUILD_SHIPPING
+#include "zlib.h"
+#endif
+
+namespace TelemetryCompression
+{
+	namespace
+	{
+		FName GetFormatName(ETelemetryCompression Method)
+		{
+			switch (Method)
+			{
+			case ETelemetryCompression::Gzip:    return NAME_Gzip;
+			case ETelemetryCompression::Deflate: return NAME_Zlib;
+			default:                             return NAME_None;
+			}
+		}
+	}
+
+	const TCHAR* GetContentEncoding(ETelemetryCompression Method)
+	{
+		switch (Method)
+		{
+		case ETelemetryCompression::Gzip:    return TEXT("gzip");
+		case ETelemetryCompression::Deflate: return TEXT("deflate"); // HTTP "deflate" is the zlib container
+		default:                             return nullptr;
+		}
+	}
+
+	bool Compress(ETelemetryCompression Method, TConstArrayView<uint8> Uncompressed, TArray<uint8>& OutCompressed)
+	{
+		const FName FormatName = GetFormatName(Method);
+		if (FormatName.IsNone() || Uncompressed.IsEmpty())
+		{
+			return false;
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Uncompressed.Num());
+		OutCompressed.SetNumUninitialized(CompressedSize, EAllowShrinking::No);
+
+		if (!FCompression::CompressMemory(FormatName, OutCompressed.GetData(), CompressedSize,
+			Uncompressed.GetData(), Uncompressed.Num(), COMPRESS_BiasSpeed))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] %s compression failed, sending uncompressed"), *FormatName.ToString());
+			return false;
+		}
+
+		OutCompressed.SetNum(CompressedSize, EAllowShrinking::No);
+		return CompressedSize < Uncompressed.Num();
+	}
+
+	ETelemetryCompression FromContentEncoding(const FString& ContentEncoding)
+	{
+		if (ContentEncoding.Equals(TEXT("gzip"), ESearchCase::IgnoreCase))
+		{
+			return ETelemetryCompression::Gzip;
+		}
+		if (ContentEncoding.Equals(TEXT("deflate"), ESearchCase::IgnoreCase))
+		{
+			return ETelemetryCompression::Deflate;
+		}
+		return ETelemetryCompression::None;
+	}
+
+#if !UE_BUILD_SHIPPING
+	bool Decompress(ETelemetryCompression Method, TConstArrayView<uint8> Compressed, TArray<uint8>& OutUncompressed,
+		int32 MaxUncompressedBytes)
+	{
+		OutUncompressed.Reset();
+		if (Method == ETelemetryCompression::None || Compressed.IsEmpty())
+		{
+			return false;
+		}
+
+		// FCompression needs the exact uncompressed size up front, which an HTTP body does not carry,
+		// so inflate with zlib directly (windowBits 15 + 32 accepts both gzip and zlib containers)
+		z_stream Stream = {};
+		Stream.next_in = const_cast<Bytef*>(Compressed.GetData());
+		Stream.avail_in = Compressed.Num();
+		if (inflateInit2(&Stream, 15 + 32) != Z_OK)
+		{
+			return false;
+		}
+
+		int Result = Z_OK;
+		while (Result == Z_OK)
+		{
+			const int32 Offset = OutUncompressed.Num();
+			const int32 Grow = FMath::Max(Compressed.Num() * 2, 4096);
+			if (Offset + Grow > MaxUncompressedBytes)
+			{
+				break;
+			}
+			OutUncompressed.AddUninitialized(Grow);
+			Stream.next_out = OutUncompressed.GetData() + Offset;
+			Stream.avail_out = Grow;
+
+			Result = inflate(&Stream, Z_NO_FLUSH);
+			OutUncompressed.SetNum(Offset + Grow - Stream.avail_out, EAllowShrinking::No);
+		}
+		inflateEnd(&Stream);
+
+		if (Result != Z_STREAM_END)
+		{
+			OutUncompressed.Reset();
+			return false;
+		}
+		return true;
+	}
+#endif
+}
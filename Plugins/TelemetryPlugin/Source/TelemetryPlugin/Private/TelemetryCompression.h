@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryTypes.h"
+
+/**
+ * Upload body compression helpers
+ * Wraps FCompression so the worker only deals with ETelemetryCompression
+ */
+namespace TelemetryCompression
+{
+	/** Value for the Content-Encoding header, or nullptr for no compression */
+	const TCHAR* GetContentEncoding(ETelemetryCompression Method);
+
+	/**
+	 * Compress a body with the given method
+	 * @return false if compression failed or did not make the body smaller
+	 */
+	bool Compress(ETelemetryCompression Method, TConstArrayView<uint8> Uncompressed, TArray<uint8>& OutCompressed);
+
+	/** Method for a Content-Encoding header value, None if empty or not recognised */
+	ETelemetryCompression FromContentEncoding(const FString& ContentEncoding);
+
+#if !UE_BUILD_SHIPPING
+	/**
+	 * Decompress a body produced by Compress (local collector only, so not in shipping builds)
+	 * @return false if the data is corrupt or expands beyond MaxUncompressedBytes
+	 */
+	bool Decompress(ETelemetryCompression Method, TConstArrayView<uint8> Compressed, TArray<uint8>& OutUncompressed,
+		int32 MaxUncompressedBytes = 64 * 1024 * 1024);
+#endif
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Benchmark and test tooling - left out of shipping builds
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include <atomic>
+
+/**
+ * FMalloc proxy that counts allocations made by one thread
+ * Installed over GMalloc once, on first use, and never removed: other threads keep allocating
+ * through whichever GMalloc they loaded, so swapping it back and forth around a measurement
+ * would leave them calling into a proxy with nothing to forward to. Everything is forwarded to
+ * the allocator it wraps; counting is switched on and off instead.
+ */
+class FTelemetryCountingMalloc final : public FMalloc
+{
+public:
+	/** The process-wide proxy, installed over GMalloc the first time this is called */
+	static FTelemetryCountingMalloc& Get()
+	{
+		// Deliberately leaked - frees can arrive through it until the process exits
+		static FTelemetryCountingMalloc* const Instance = []
+		{
+			FTelemetryCountingMalloc* Proxy = new FTelemetryCountingMalloc(GMalloc);
+			GMalloc = Proxy;
+			return Proxy;
+		}();
+		return *Instance;
+	}
+
+	/** Count allocations made by the calling thread until StopCounting */
+	void StartCounting()
+	{
+		CountedThreadId.store(FPlatformTLS::GetCurrentThreadId(), std::memory_order_relaxed);
+		bCounting.store(true, std::memory_order_release);
+	}
+
+	void StopCounting() { bCounting.store(false, std::memory_order_release); }
+
+	/** Malloc and Realloc calls made by the counted thread while counting */
+	uint64 GetAllocationCount() const { return AllocationCount.load(std::memory_order_relaxed); }
+	void ResetAllocationCount() { AllocationCount.store(0, std::memory_order_relaxed); }
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return Inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return Inner->TryMalloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+		return Inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+		return Inner->TryRealloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override { Inner->Free(Original); }
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return TEXT("TelemetryCountingMalloc"); }
+
+private:
+	explicit FTelemetryCountingMalloc(FMalloc* InInner)
+		: Inner(InInner)
+	{
+	}
+
+	void CountAllocation()
+	{
+		if (bCounting.load(std::memory_order_acquire)
+			&& FPlatformTLS::GetCurrentThreadId() == CountedThreadId.load(std::memory_order_relaxed))
+		{
+			AllocationCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	FMalloc* const Inner;
+	std::atomic<bool> bCounting{false};
+	std::atomic<uint32> CountedThreadId{0};
+	std::atomic<uint64> AllocationCount{0};
+};
+
+#endif // !UE_BUILD_SHIPPING
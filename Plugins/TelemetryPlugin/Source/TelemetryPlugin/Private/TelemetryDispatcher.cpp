@@ -0,0 +1,211 @@
+#include "TelemetryDispatcher.h"
+#include "TelemetryPlugin.h"
+#include "TelemetryWorker.h"
+#include "TelemetrySpool.h"
+#include "TelemetryStreamTransport.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe> FTelemetryDispatcher::Get()
+{
+	return FTelemetryPluginModule::Get().GetDispatcher();
+}
+
+FTelemetryDispatcher::FTelemetryDispatcher()
+	: MachineName(FPlatformProcess::ComputerName())
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("TelemetryDispatcher"), 0, TPri_BelowNormal);
+}
+
+FTelemetryDispatcher::~FTelemetryDispatcher()
+{
+	Shutdown();
+
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+}
+
+void FTelemetryDispatcher::Shutdown()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	for (TPair<FString, FSharedStream>& Stream : Streams)
+	{
+		Stream.Value.Transport->Close();
+	}
+	Streams.Reset();
+}
+
+void FTelemetryDispatcher::Register(FTelemetryWorker* Worker)
+{
+	{
+		FScopeLock Lock(&WorkersLock);
+		Workers.AddUnique(Worker);
+	}
+	Wake();
+}
+
+void FTelemetryDispatcher::Unregister(FTelemetryWorker* Worker)
+{
+	FScopeLock Lock(&WorkersLock);
+	Workers.Remove(Worker);
+}
+
+int32 FTelemetryDispatcher::GetNumWorkers() const
+{
+	FScopeLock Lock(&WorkersLock);
+	return Workers.Num();
+}
+
+void FTelemetryDispatcher::Wake()
+{
+	WakeEvent->Trigger();
+}
+
+void FTelemetryDispatcher::OnUploadFinished()
+{
+	InFlightRequests.fetch_sub(1, std::memory_order_relaxed);
+
+	// The freed slot may go to any worker, not just the one whose upload finished
+	WakeEvent->Trigger();
+}
+
+TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe> FTelemetryDispatcher::GetSpool(const FString& Directory, int64 MaxBytes)
+{
+	FScopeLock Lock(&SpoolLock);
+
+	// Created lazily so the directory scan happens on the dispatcher thread, not in Initialize
+	TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe>& Spool = Spools.FindOrAdd(Directory);
+	if (!Spool)
+	{
+		const FString SpoolDirectory = Directory.IsEmpty()
+			? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("Spool"))
+			: Directory;
+		Spool = MakeShared<FTelemetrySpool, ESPMode::ThreadSafe>(SpoolDirectory, MaxBytes);
+	}
+	else
+	{
+		Spool->SetMaxBytes(MaxBytes);
+	}
+	return Spool;
+}
+
+TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> FTelemetryDispatcher::AcquireStream(const FString& URL,
+	const FTelemetryStreamingSettings& Settings)
+{
+	check(IsInGameThread());
+
+	FSharedStream& Stream = Streams.FindOrAdd(URL);
+	if (!Stream.Transport)
+	{
+		Stream.Transport = MakeShared<FTelemetryStreamTransport, ESPMode::ThreadSafe>(MachineName);
+		Stream.Transport->SetSettings(Settings);
+		Stream.Transport->Open(URL);
+	}
+	++Stream.Users;
+	return Stream.Transport;
+}
+
+void FTelemetryDispatcher::ReleaseStream(const TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe>& Stream)
+{
+	check(IsInGameThread());
+
+	for (auto It = Streams.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Transport == Stream)
+		{
+			// Unacknowledged frames go back to the workers' final POSTs
+			if (--It->Value.Users <= 0)
+			{
+				It->Value.Transport->Close();
+				It.RemoveCurrent();
+			}
+			return;
+		}
+	}
+}
+
+FString FTelemetryDispatcher::MakeUniqueSessionID(const FString& BaseID)
+{
+	FScopeLock Lock(&SessionLock);
+
+	// PIE clients started in the same second would otherwise share machine name and timestamp
+	FString SessionID = BaseID;
+	for (int32 Suffix = 2; SessionIDs.Contains(SessionID); ++Suffix)
+	{
+		SessionID = FString::Printf(TEXT("%s_%d"), *BaseID, Suffix);
+	}
+	SessionIDs.Add(SessionID);
+	return SessionID;
+}
+
+uint32 FTelemetryDispatcher::Run()
+{
+	while (!bStopRequested.load())
+	{
+		const double Remaining = GetSecondsUntilNextTick();
+		const uint32 WaitMs = Remaining < 0.0 ? MAX_uint32 : static_cast<uint32>(Remaining * 1000.0);
+		WakeEvent->Wait(WaitMs);
+
+		TickWorkers();
+	}
+	return 0;
+}
+
+void FTelemetryDispatcher::Stop()
+{
+	bStopRequested.store(true);
+	WakeEvent->Trigger();
+}
+
+void FTelemetryDispatcher::Tick()
+{
+	TickWorkers();
+}
+
+void FTelemetryDispatcher::TickWorkers()
+{
+	FScopeLock Lock(&WorkersLock);
+	if (Workers.IsEmpty())
+	{
+		return;
+	}
+
+	// Rotated so no instance always gets the free upload slots first
+	FirstWorker = FirstWorker % Workers.Num();
+	for (int32 Index = 0; Index < Workers.Num(); ++Index)
+	{
+		Workers[(FirstWorker + Index) % Workers.Num()]->Tick();
+	}
+	++FirstWorker;
+}
+
+double FTelemetryDispatcher::GetSecondsUntilNextTick() const
+{
+	FScopeLock Lock(&WorkersLock);
+
+	double Earliest = -1.0;
+	for (const FTelemetryWorker* Worker : Workers)
+	{
+		const double Remaining = Worker->GetSecondsUntilNextTick();
+		if (Remaining >= 0.0)
+		{
+			Earliest = Earliest < 0.0 ? Remaining : FMath::Min(Earliest, Remaining);
+		}
+	}
+	return Earliest;
+}
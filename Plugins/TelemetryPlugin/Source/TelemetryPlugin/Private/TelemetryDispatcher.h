@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Misc/SingleThreadRunnable.h"
+#include "TelemetryTypes.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+class FTelemetryWorker;
+class FTelemetrySpool;
+class FTelemetryStreamTransport;
+
+/**
+ * Process-wide home of the telemetry workers, owned by the plugin module
+ * Every game instance (PIE clients, in-process bots) keeps its own UTelemetrySubsystem and
+ * worker, so session, run and sequence bookkeeping stay separate in the data. What multiplies
+ * with the instance count is shared here instead:
+ * - one thread drains and uploads for all workers, rotating which goes first each pass
+ * - uploads draw on one in-flight budget, so 16 clients do not open 16 times the connections
+ * - the spool directory has a single owner, so no instance replays a segment another is sending
+ * - one WebSocket per collector URL carries every instance's frames
+ * Workers only run on the dispatcher thread, except for their final flush in Shutdown.
+ */
+class FTelemetryDispatcher : public FRunnable, public FSingleThreadRunnable, public TSharedFromThis<FTelemetryDispatcher, ESPMode::ThreadSafe>
+{
+public:
+	/** The module's dispatcher, created on first use */
+	static TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe> Get();
+
+	FTelemetryDispatcher();
+	virtual ~FTelemetryDispatcher() override;
+
+	/** Stop the thread - workers still registered are flushed by their own Shutdown */
+	void Shutdown();
+
+	/** Start or stop servicing a worker (any thread); Unregister waits for a pass in progress */
+	void Register(FTelemetryWorker* Worker);
+	void Unregister(FTelemetryWorker* Worker);
+
+	/** Run a pass soon - new events, a freed upload slot, changed settings */
+	void Wake();
+
+	/** Upload slots across all workers - OnUploadFinished runs on the HTTP thread */
+	void OnUploadStarted() { InFlightRequests.fetch_add(1, std::memory_order_relaxed); }
+	void OnUploadFinished();
+	int32 GetInFlightRequests() const { return InFlightRequests.load(std::memory_order_relaxed); }
+
+	/**
+	 * The spool shared by every worker writing to Directory, created on first use (dispatcher thread)
+	 * @param Directory - Segment directory, empty for Saved/Telemetry/Spool
+	 */
+	TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe> GetSpool(const FString& Directory, int64 MaxBytes);
+
+	/**
+	 * Stream to URL, opened if this is its first user (game thread)
+	 * Settings of the first user apply until the stream is closed.
+	 */
+	TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> AcquireStream(const FString& URL, const FTelemetryStreamingSettings& Settings);
+
+	/** Give up a stream from AcquireStream, closing it when its last user leaves (game thread) */
+	void ReleaseStream(const TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe>& Stream);
+
+	/** BaseID, or BaseID with a counter if another instance in this process already used it */
+	FString MakeUniqueSessionID(const FString& BaseID);
+
+	const FString& GetMachineName() const { return MachineName; }
+
+	int32 GetNumWorkers() const;
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	virtual FSingleThreadRunnable* GetSingleThreadInterface() override { return this; }
+
+	// FSingleThreadRunnable
+	virtual void Tick() override;
+
+private:
+	/** Tick every registered worker once */
+	void TickWorkers();
+
+	/** Seconds until any worker has timed work, or -1 if none has */
+	double GetSecondsUntilNextTick() const;
+
+	const FString MachineName;
+
+	/** Registered workers, guarded by WorkersLock - held for a whole pass */
+	TArray<FTelemetryWorker*> Workers;
+	int32 FirstWorker = 0;
+	mutable FCriticalSection WorkersLock;
+
+	std::atomic<int32> InFlightRequests{0};
+
+	/** Spools by directory, guarded by SpoolLock */
+	TMap<FString, TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe>> Spools;
+	FCriticalSection SpoolLock;
+
+	struct FSharedStream
+	{
+		TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> Transport;
+		int32 Users = 0;
+	};
+
+	/** Open streams by URL (game thread only) */
+	TMap<FString, FSharedStream> Streams;
+
+	/** Session IDs handed out in this process, guarded by SessionLock */
+	TSet<FString> SessionIDs;
+	FCriticalSection SessionLock;
+
+	std::atomic<bool> bStopRequested{false};
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+};
@@ -0,0 +1,128 @@
+#include "TelemetryEventPolicy.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	/** Console overrides for one event type, -1 means "use the ini value" */
+	struct FPolicyConsoleVariables
+	{
+		TAutoConsoleVariable<float> SampleRate;
+		TAutoConsoleVariable<float> MaxEventsPerSecond;
+		TAutoConsoleVariable<float> CoalesceWindow;
+
+		explicit FPolicyConsoleVariables(const TCHAR* TypeName)
+			: SampleRate(
+				*FString::Printf(TEXT("Telemetry.%s.SampleRate"), TypeName), -1.0f,
+				*FString::Printf(TEXT("Fraction of %s events kept, 0-1 (-1 = DefaultGame.ini)"), TypeName))
+			, MaxEventsPerSecond(
+				*FString::Printf(TEXT("Telemetry.%s.MaxPerSecond"), TypeName), -1.0f,
+				*FString::Printf(TEXT("Max %s events per second, 0 = unlimited (-1 = DefaultGame.ini)"), TypeName))
+			, CoalesceWindow(
+				*FString::Printf(TEXT("Telemetry.%s.CoalesceWindow"), TypeName), -1.0f,
+				*FString::Printf(TEXT("Seconds over which %s events are merged, 0 = off (-1 = DefaultGame.ini)"), TypeName))
+		{
+		}
+	};
+
+	FPolicyConsoleVariables CVarPosition(TEXT("Position"));
+	FPolicyConsoleVariables CVarInput(TEXT("Input"));
+	FPolicyConsoleVariables CVarDamage(TEXT("Damage"));
+	FPolicyConsoleVariables CVarDeath(TEXT("Death"));
+
+	const FPolicyConsoleVariables* GetConsoleVariables(ETelemetryEventType Type)
+	{
+		switch (Type)
+		{
+		case ETelemetryEventType::Position:      return &CVarPosition;
+		case ETelemetryEventType::InputReceived: return &CVarInput;
+		case ETelemetryEventType::Damage:        return &CVarDamage;
+		case ETelemetryEventType::Death:         return &CVarDeath;
+		default:                                 return nullptr;
+		}
+	}
+
+	/** Console value if set, ini value otherwise */
+	float Resolve(const TAutoConsoleVariable<float>& Override, const std::atomic<float>& IniValue)
+	{
+		const float Value = Override.GetValueOnAnyThread();
+		return Value >= 0.0f ? Value : IniValue.load(std::memory_order_relaxed);
+	}
+}
+
+FTelemetryEventPolicies::FTelemetryEventPolicies()
+{
+	const double Now = FPlatformTime::Seconds();
+	for (FTypeState& State : States)
+	{
+		State.LastRefillTime = Now;
+	}
+}
+
+bool FTelemetryEventPolicies::HasPolicy(ETelemetryEventType Type)
+{
+	return GetConsoleVariables(Type) != nullptr;
+}
+
+void FTelemetryEventPolicies::SetPolicy(ETelemetryEventType Type, const FTelemetryEventPolicy& Policy)
+{
+	check(HasPolicy(Type));
+
+	FTypeState& State = States[static_cast<uint8>(Type)];
+	State.SampleRate.store(FMath::Clamp(Policy.SampleRate, 0.0f, 1.0f));
+	State.MaxEventsPerSecond.store(FMath::Max(0.0f, Policy.MaxEventsPerSecond));
+	State.CoalesceWindow.store(FMath::Max(0.0f, Policy.CoalesceWindow));
+}
+
+bool FTelemetryEventPolicies::ShouldCapture(ETelemetryEventType Type)
+{
+	const FPolicyConsoleVariables* ConsoleVariables = GetConsoleVariables(Type);
+	if (!ConsoleVariables)
+	{
+		return true;
+	}
+
+	FTypeState& State = States[static_cast<uint8>(Type)];
+
+	// Keep event N when N * Rate crosses an integer - evenly spaced and deterministic
+	const float SampleRate = FMath::Clamp(Resolve(ConsoleVariables->SampleRate, State.SampleRate), 0.0f, 1.0f);
+	if (SampleRate < 1.0f)
+	{
+		const uint64 Index = State.SampleCounter.fetch_add(1, std::memory_order_relaxed);
+		if (FMath::FloorToInt64((Index + 1) * static_cast<double>(SampleRate)) == FMath::FloorToInt64(Index * static_cast<double>(SampleRate)))
+		{
+			NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+	}
+
+	const float MaxPerSecond = Resolve(ConsoleVariables->MaxEventsPerSecond, State.MaxEventsPerSecond);
+	if (MaxPerSecond > 0.0f)
+	{
+		FScopeLock Lock(&State.BucketLock);
+
+		const double Now = FPlatformTime::Seconds();
+		const double Burst = FMath::Max(1.0, static_cast<double>(MaxPerSecond));
+		State.Tokens = FMath::Min(Burst, State.Tokens + (Now - State.LastRefillTime) * MaxPerSecond);
+		State.LastRefillTime = Now;
+
+		if (State.Tokens < 1.0)
+		{
+			NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		State.Tokens -= 1.0;
+	}
+
+	return true;
+}
+
+float FTelemetryEventPolicies::GetCoalesceWindow(ETelemetryEventType Type) const
+{
+	const FPolicyConsoleVariables* ConsoleVariables = GetConsoleVariables(Type);
+	if (!ConsoleVariables || Type == ETelemetryEventType::Death)
+	{
+		return 0.0f;
+	}
+
+	return FMath::Max(0.0f, Resolve(ConsoleVariables->CoalesceWindow, States[static_cast<uint8>(Type)].CoalesceWindow));
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryTypes.h"
+#include "TelemetryEventRecord.h"
+#include <atomic>
+
+/**
+ * Per-event-type capture policies (sampling, rate limit, coalescing window)
+ * Values come from the subsystem's ini settings; Telemetry.<Type>.* console variables override
+ * them at runtime when set to 0 or more. Shared by the producers (ShouldCapture, any thread)
+ * and the worker (GetCoalesceWindow).
+ */
+class FTelemetryEventPolicies
+{
+public:
+	FTelemetryEventPolicies();
+
+	void SetPolicy(ETelemetryEventType Type, const FTelemetryEventPolicy& Policy);
+
+	/**
+	 * Sampling and rate limit check, done before the event is built - safe from any thread
+	 * @return false if the event should be dropped
+	 */
+	bool ShouldCapture(ETelemetryEventType Type);
+
+	/** Coalescing window in seconds, 0 if the type is not coalesced */
+	float GetCoalesceWindow(ETelemetryEventType Type) const;
+
+	/** Events dropped by sampling or rate limiting */
+	int64 GetNumSuppressed() const { return NumSuppressed.load(std::memory_order_relaxed); }
+
+	/** Types that can carry a policy - lifecycle events are always captured */
+	static bool HasPolicy(ETelemetryEventType Type);
+
+private:
+	struct FTypeState
+	{
+		/** Ini values, overridden by console variables */
+		std::atomic<float> SampleRate{1.0f};
+		std::atomic<float> MaxEventsPerSecond{0.0f};
+		std::atomic<float> CoalesceWindow{0.0f};
+
+		/** Events seen, for evenly spaced sampling */
+		std::atomic<uint64> SampleCounter{0};
+
+		/** Token bucket, guarded by BucketLock */
+		double Tokens = 0.0;
+		double LastRefillTime = 0.0;
+		FCriticalSection BucketLock;
+	};
+
+	/** Indexed by ETelemetryEventType - only types with a policy are ever read */
+	FTypeState States[NumTelemetryEventTypes];
+	static_assert(static_cast<int32>(ETelemetryEventType::InputReceived) < NumTelemetryEventTypes
+		&& static_cast<int32>(ETelemetryEventType::Death) < NumTelemetryEventTypes, "Policy types must index States");
+
+	std::atomic<int64> NumSuppressed{0};
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Bounded lock-free multi-producer / single-consumer ring of plain values
+ * All slots are allocated up front, so enqueue and dequeue never touch the heap
+ * (unlike TQueue, which allocates a node per element).
+ * Based on Dmitry Vyukov's bounded MPMC queue, specialised for a single consumer.
+ */
+template <typename T>
+class TTelemetryEventQueue
+{
+public:
+	/** @param InCapacity - Rounded up to a power of two */
+	explicit TTelemetryEventQueue(uint32 InCapacity)
+	{
+		const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+		Mask = Capacity - 1;
+		Slots = MakeUnique<FSlot[]>(Capacity);
+		for (uint32 Index = 0; Index < Capacity; ++Index)
+		{
+			Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Add a value - safe to call from any thread
+	 * @return false if the queue is full (the value is left untouched)
+	 */
+	bool TryEnqueue(const T& Value)
+	{
+		uint64 Position = EnqueuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			FSlot& Slot = Slots[Position & Mask];
+			const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+			const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position);
+
+			if (Difference == 0)
+			{
+				if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+				{
+					Slot.Value = Value;
+					Slot.Sequence.store(Position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (Difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				Position = EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/** Remove the oldest value - consumer thread only */
+	bool Dequeue(T& OutValue)
+	{
+		FSlot& Slot = Slots[DequeuePosition & Mask];
+		const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+		if (static_cast<int64>(Sequence) - static_cast<int64>(DequeuePosition + 1) < 0)
+		{
+			return false;
+		}
+
+		OutValue = Slot.Value;
+		Slot.Sequence.store(DequeuePosition + Mask + 1, std::memory_order_release);
+		++DequeuePosition;
+		return true;
+	}
+
+	uint32 GetCapacity() const { return static_cast<uint32>(Mask + 1); }
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence{0};
+		T Value;
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+	uint64 Mask = 0;
+
+	/** Producers and the consumer work on separate cache lines */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePosition{0};
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePosition = 0;
+};
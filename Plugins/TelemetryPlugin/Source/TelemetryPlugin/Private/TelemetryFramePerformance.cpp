@@ -0,0 +1,189 @@
+#include "TelemetryFramePerformance.h"
+#include "TelemetryJsonWriter.h"
+#include "RenderCore.h"
+#include "Misc/CoreDelegates.h"
+#include "HAL/PlatformMemory.h"
+
+void FTelemetryFrameHistogram::Add(double ValueMs)
+{
+	int32 Index = 0;
+	if (ValueMs >= MinValueMs)
+	{
+		Index = 1 + FMath::FloorToInt32(FMath::Log2(ValueMs / MinValueMs) * BucketsPerOctave);
+		Index = FMath::Min(Index, NumBuckets - 1);
+	}
+
+	++Buckets[Index];
+	++Count;
+	SumMs += ValueMs;
+	MaxMs = FMath::Max(MaxMs, ValueMs);
+}
+
+double FTelemetryFrameHistogram::GetBucketLowerBound(int32 Index)
+{
+	return Index <= 0 ? 0.0 : MinValueMs * FMath::Pow(2.0, static_cast<double>(Index - 1) / BucketsPerOctave);
+}
+
+double FTelemetryFrameHistogram::GetPercentile(double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint64 Rank = FMath::Max<uint64>(1, FMath::CeilToInt64(Count * FMath::Clamp(Percentile, 0.0, 100.0) / 100.0));
+	uint64 Seen = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Seen += Buckets[Index];
+		if (Seen >= Rank)
+		{
+			return Index == NumBuckets - 1 ? MaxMs : FMath::Min(MaxMs, GetBucketLowerBound(Index + 1));
+		}
+	}
+	return MaxMs;
+}
+
+void FTelemetryFrameHistogram::WriteJson(FTelemetryJsonWriter& Writer) const
+{
+	Writer.WriteRaw("{\"count\":");
+	Writer.WriteInt(Count);
+	Writer.WriteRaw(",\"mean\":");
+	Writer.WriteFloat(Count > 0 ? static_cast<float>(SumMs / Count) : 0.0f);
+	Writer.WriteRaw(",\"p50\":");
+	Writer.WriteFloat(static_cast<float>(GetPercentile(50.0)));
+	Writer.WriteRaw(",\"p95\":");
+	Writer.WriteFloat(static_cast<float>(GetPercentile(95.0)));
+	Writer.WriteRaw(",\"p99\":");
+	Writer.WriteFloat(static_cast<float>(GetPercentile(99.0)));
+	Writer.WriteRaw(",\"max\":");
+	Writer.WriteFloat(static_cast<float>(MaxMs));
+
+	// Sparse - a steady run only fills a handful of buckets
+	Writer.WriteRaw(",\"buckets\":[");
+	bool bFirst = true;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		if (Buckets[Index] == 0)
+		{
+			continue;
+		}
+		if (!bFirst)
+		{
+			Writer.WriteChar(',');
+		}
+		bFirst = false;
+		Writer.WriteChar('[');
+		Writer.WriteFloat(static_cast<float>(GetBucketLowerBound(Index)));
+		Writer.WriteChar(',');
+		Writer.WriteInt(Buckets[Index]);
+		Writer.WriteChar(']');
+	}
+	Writer.WriteRaw("]}");
+}
+
+void FTelemetryFramePerformance::WriteJsonFields(FTelemetryJsonWriter& Writer) const
+{
+	Writer.WriteRaw(",\"frame_ms\":");
+	FrameTime.WriteJson(Writer);
+	Writer.WriteRaw(",\"game_thread_ms\":");
+	GameThreadTime.WriteJson(Writer);
+	Writer.WriteRaw(",\"render_thread_ms\":");
+	RenderThreadTime.WriteJson(Writer);
+
+	Writer.WriteRaw(",\"hitches\":[");
+	for (int32 Index = 0; Index < HitchThresholdsMs.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			Writer.WriteChar(',');
+		}
+		Writer.WriteRaw("{\"threshold_ms\":");
+		Writer.WriteFloat(HitchThresholdsMs[Index]);
+		Writer.WriteRaw(",\"count\":");
+		Writer.WriteInt(HitchCounts[Index]);
+		Writer.WriteChar('}');
+	}
+	Writer.WriteChar(']');
+
+	Writer.WriteRaw(",\"peak_used_physical_mb\":");
+	Writer.WriteFloat(static_cast<float>(PeakUsedPhysical / (1024.0 * 1024.0)));
+	Writer.WriteRaw(",\"peak_used_virtual_mb\":");
+	Writer.WriteFloat(static_cast<float>(PeakUsedVirtual / (1024.0 * 1024.0)));
+}
+
+FTelemetryFramePerformanceCollector::~FTelemetryFramePerformanceCollector()
+{
+	if (IsRunning())
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	}
+}
+
+void FTelemetryFramePerformanceCollector::Start(const FTelemetryFramePerformanceSettings& Settings)
+{
+	Current = FTelemetryFramePerformance();
+	Current.HitchThresholdsMs = Settings.HitchThresholdsMs;
+	Current.HitchThresholdsMs.Sort();
+	Current.HitchCounts.SetNumZeroed(Current.HitchThresholdsMs.Num());
+
+	MemorySampleInterval = FMath::Max(0.0f, Settings.MemorySampleInterval);
+	LastFrameEndTime = 0.0;
+	NextMemorySampleTime = 0.0;
+
+	if (!IsRunning())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FTelemetryFramePerformanceCollector::OnEndFrame);
+	}
+}
+
+FTelemetryFramePerformance FTelemetryFramePerformanceCollector::Stop()
+{
+	if (IsRunning())
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		EndFrameHandle.Reset();
+	}
+
+	// Make sure even a run shorter than the sample interval has its high-water marks
+	SampleMemory();
+
+	return MoveTemp(Current);
+}
+
+void FTelemetryFramePerformanceCollector::OnEndFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// The frame that called Start is only partly inside the run
+	if (LastFrameEndTime > 0.0)
+	{
+		const double FrameMs = (Now - LastFrameEndTime) * 1000.0;
+		Current.FrameTime.Add(FrameMs);
+
+		// Both are the previous frame's cycle counts, 0 without a renderer
+		Current.GameThreadTime.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+		Current.RenderThreadTime.Add(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+
+		// Thresholds are sorted, so stop at the first one the frame stays under
+		for (int32 Index = 0; Index < Current.HitchThresholdsMs.Num() && FrameMs >= Current.HitchThresholdsMs[Index]; ++Index)
+		{
+			++Current.HitchCounts[Index];
+		}
+	}
+	LastFrameEndTime = Now;
+
+	// Reading memory stats is a syscall on most platforms - not every frame
+	if (Now >= NextMemorySampleTime)
+	{
+		SampleMemory();
+		NextMemorySampleTime = Now + MemorySampleInterval;
+	}
+}
+
+void FTelemetryFramePerformanceCollector::SampleMemory()
+{
+	const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+	Current.PeakUsedPhysical = FMath::Max<uint64>(Current.PeakUsedPhysical, Stats.UsedPhysical);
+	Current.PeakUsedVirtual = FMath::Max<uint64>(Current.PeakUsedVirtual, Stats.UsedVirtual);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryTypes.h"
+
+class FTelemetryJsonWriter;
+
+/**
+ * Streaming histogram of millisecond values with fixed memory
+ * Buckets are log-spaced, BucketsPerOctave per doubling from MinValueMs, so relative
+ * precision is the same for a 2 ms frame and a 500 ms hitch (~19% wide buckets).
+ * Bucket 0 holds everything below MinValueMs, the last bucket everything above the range.
+ */
+struct FTelemetryFrameHistogram
+{
+	static constexpr double MinValueMs = 0.5;
+	static constexpr int32 BucketsPerOctave = 4;
+	static constexpr int32 NumOctaves = 16;
+	static constexpr int32 NumBuckets = BucketsPerOctave * NumOctaves + 2;
+
+	uint32 Buckets[NumBuckets] = {};
+	uint32 Count = 0;
+	double SumMs = 0.0;
+	double MaxMs = 0.0;
+
+	void Add(double ValueMs);
+
+	/** Smallest value that lands in the bucket */
+	static double GetBucketLowerBound(int32 Index);
+
+	/** Upper edge of the bucket holding the given percentile (0-100), capped at MaxMs */
+	double GetPercentile(double Percentile) const;
+
+	/** Stream as {"count":..,"mean":..,"p50":..,"p95":..,"p99":..,"max":..,"buckets":[[lower_ms,count],..]} */
+	void WriteJson(FTelemetryJsonWriter& Writer) const;
+};
+
+/** Everything the collector gathered over one run */
+struct FTelemetryFramePerformance
+{
+	FTelemetryFrameHistogram FrameTime;
+	FTelemetryFrameHistogram GameThreadTime;
+	FTelemetryFrameHistogram RenderThreadTime;
+
+	/** Parallel arrays - frames whose total time reached each threshold */
+	TArray<float> HitchThresholdsMs;
+	TArray<uint32> HitchCounts;
+
+	/** Highest sampled memory use during the run, in bytes */
+	uint64 PeakUsedPhysical = 0;
+	uint64 PeakUsedVirtual = 0;
+
+	/** Stream the frame_performance event fields, starting with a leading comma */
+	void WriteJsonFields(FTelemetryJsonWriter& Writer) const;
+};
+
+/**
+ * Collects frame performance while a run is active
+ * Hooks FCoreDelegates::OnEndFrame between Start and Stop. Game thread only.
+ */
+class FTelemetryFramePerformanceCollector
+{
+public:
+	~FTelemetryFramePerformanceCollector();
+
+	/** Reset and start sampling every frame */
+	void Start(const FTelemetryFramePerformanceSettings& Settings);
+
+	/** Stop sampling and hand over what was collected */
+	FTelemetryFramePerformance Stop();
+
+	bool IsRunning() const { return EndFrameHandle.IsValid(); }
+
+private:
+	void OnEndFrame();
+	void SampleMemory();
+
+	FTelemetryFramePerformance Current;
+	FDelegateHandle EndFrameHandle;
+
+	/** Real time at the end of the previous frame, 0 before the first one */
+	double LastFrameEndTime = 0.0;
+
+	double NextMemorySampleTime = 0.0;
+	float MemorySampleInterval = 0.5f;
+};
@@ -0,0 +1,94 @@
+#include "TelemetryGhostFile.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+
+bool FTelemetryGhostRecording::Load(const FString& Path)
+{
+	using namespace TelemetryGhostFile;
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Could not read ghost file %s"), *Path);
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	uint32 MagicValue = 0;
+	uint16 VersionValue = 0;
+	uint16 Flags = 0;
+	Reader << MagicValue << VersionValue << Flags << RunID << SampleRate;
+	if (Reader.IsError() || MagicValue != Magic || VersionValue != Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] %s is not a version %u ghost file"), *Path, Version);
+		return false;
+	}
+
+	Samples.Reset();
+	Inputs.Reset();
+	TArray<FName> Names;
+	float FirstTime = -1.0f;
+
+	while (Reader.Tell() < Reader.TotalSize())
+	{
+		uint8 Tag = 0;
+		Reader << Tag;
+
+		if (Tag == static_cast<uint8>(ERecordTag::Transform))
+		{
+			float Time;
+			FVector3f Location;
+			uint16 Pitch, Yaw, Roll;
+			Reader << Time << Location.X << Location.Y << Location.Z << Pitch << Yaw << Roll;
+			if (Reader.IsError())
+			{
+				break;
+			}
+
+			FirstTime = FirstTime < 0.0f ? Time : FirstTime;
+			const FRotator Rotation(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw),
+				FRotator::DecompressAxisFromShort(Roll));
+			Samples.Add({Time - FirstTime, FVector(Location), Rotation.Quaternion()});
+		}
+		else if (Tag == static_cast<uint8>(ERecordTag::Name))
+		{
+			uint16 Index;
+			FString Name;
+			Reader << Index << Name;
+			if (Reader.IsError() || Index != Names.Num())
+			{
+				break;
+			}
+			Names.Add(FName(*Name));
+		}
+		else if (Tag == static_cast<uint8>(ERecordTag::Input))
+		{
+			float Time, Duration;
+			uint16 NameIndex;
+			Reader << Time << NameIndex << Duration;
+			if (Reader.IsError() || !Names.IsValidIndex(NameIndex))
+			{
+				break;
+			}
+			Inputs.Add({Time, Names[NameIndex], Duration});
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	// Inputs may precede the first transform, and spans are written when they end
+	const float InputOffset = FirstTime < 0.0f ? 0.0f : FirstTime;
+	for (FTelemetryGhostInput& Input : Inputs)
+	{
+		Input.Time = FMath::Max(0.0f, Input.Time - InputOffset);
+	}
+	Inputs.StableSort([](const FTelemetryGhostInput& A, const FTelemetryGhostInput& B) { return A.Time < B.Time; });
+
+	if (Reader.Tell() < Reader.TotalSize())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Ghost file %s is truncated - loaded %d samples"), *Path, Samples.Num());
+	}
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Per-run ghost recording (.tlmg)
+ * Header: magic "TLMG", version, flags, run ID, sample rate. Then a stream of tagged records
+ * appended as the run is played, so a file cut short by a crash still loads up to its last
+ * complete record:
+ * - Transform: time, location (3 floats), pitch/yaw/roll as 16-bit angles (23 bytes)
+ * - Name: index and string, written once before an action's first input
+ * - Input: time, name index, duration
+ */
+namespace TelemetryGhostFile
+{
+	constexpr uint32 Magic = 0x474D4C54; // "TLMG"
+	constexpr uint16 Version = 1;
+	const TCHAR* const Extension = TEXT(".tlmg");
+
+	enum class ERecordTag : uint8
+	{
+		Transform = 0,
+		Name = 1,
+		Input = 2
+	};
+}
+
+/** One sampled pawn transform, time relative to the first sample */
+struct FTelemetryGhostSample
+{
+	float Time = 0.0f;
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+};
+
+/** One input action press, time relative to the first sample */
+struct FTelemetryGhostInput
+{
+	float Time = 0.0f;
+	FName Action;
+	float Duration = 0.0f;
+};
+
+/** A loaded ghost file, samples and inputs in time order */
+struct FTelemetryGhostRecording
+{
+	FString RunID;
+	float SampleRate = 0.0f;
+	TArray<FTelemetryGhostSample> Samples;
+	TArray<FTelemetryGhostInput> Inputs;
+
+	float GetDuration() const { return Samples.Num() > 0 ? Samples.Last().Time : 0.0f; }
+
+	/**
+	 * Read a ghost file, keeping everything up to the first incomplete record
+	 * @return false if the file is missing or not a ghost file of a known version
+	 */
+	bool Load(const FString& Path);
+};
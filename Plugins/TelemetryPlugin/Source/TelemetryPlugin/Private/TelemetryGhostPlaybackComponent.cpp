@@ -0,0 +1,134 @@
+#include "TelemetryGhostPlaybackComponent.h"
+#include "TelemetryGhostFile.h"
+#include "GameFramework/Actor.h"
+#include "Algo/BinarySearch.h"
+
+UTelemetryGhostPlaybackComponent::UTelemetryGhostPlaybackComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+bool UTelemetryGhostPlaybackComponent::LoadRecording(const FString& Path)
+{
+	Stop();
+
+	TSharedPtr<FTelemetryGhostRecording> Loaded = MakeShared<FTelemetryGhostRecording>();
+	if (!Loaded->Load(Path) || Loaded->Samples.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] No ghost samples in %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Loaded ghost %s: %d samples, %d inputs, %.1fs"),
+		*Loaded->RunID, Loaded->Samples.Num(), Loaded->Inputs.Num(), Loaded->GetDuration());
+
+	Recording = MoveTemp(Loaded);
+	PlaybackTime = 0.0f;
+	Seek();
+	return true;
+}
+
+void UTelemetryGhostPlaybackComponent::Play(float StartTime)
+{
+	if (!Recording)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Cannot play ghost - no recording loaded"));
+		return;
+	}
+
+	PlaybackTime = FMath::Clamp(StartTime, 0.0f, Recording->GetDuration());
+	Seek();
+	ApplyPlaybackTime();
+	SetComponentTickEnabled(true);
+}
+
+void UTelemetryGhostPlaybackComponent::Stop()
+{
+	SetComponentTickEnabled(false);
+}
+
+bool UTelemetryGhostPlaybackComponent::IsPlaying() const
+{
+	return IsComponentTickEnabled();
+}
+
+float UTelemetryGhostPlaybackComponent::GetDuration() const
+{
+	return Recording ? Recording->GetDuration() : 0.0f;
+}
+
+void UTelemetryGhostPlaybackComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!Recording)
+	{
+		Stop();
+		return;
+	}
+
+	const float Duration = Recording->GetDuration();
+	PlaybackTime += DeltaTime * PlaybackRate;
+
+	if (PlaybackTime < Duration)
+	{
+		ApplyPlaybackTime();
+		return;
+	}
+
+	// Finish the pass at the last sample so its trailing inputs are raised too
+	PlaybackTime = Duration;
+	ApplyPlaybackTime();
+
+	if (bLoop && Duration > 0.0f)
+	{
+		PlaybackTime = 0.0f;
+		Seek();
+		return;
+	}
+
+	Stop();
+	OnPlaybackFinished.Broadcast();
+}
+
+void UTelemetryGhostPlaybackComponent::Seek()
+{
+	const TArray<FTelemetryGhostSample>& Samples = Recording->Samples;
+	SampleCursor = FMath::Max(0, Algo::UpperBoundBy(Samples, PlaybackTime, &FTelemetryGhostSample::Time) - 1);
+	InputCursor = Algo::LowerBoundBy(Recording->Inputs, PlaybackTime, &FTelemetryGhostInput::Time);
+}
+
+void UTelemetryGhostPlaybackComponent::ApplyPlaybackTime()
+{
+	// Held locally - an OnGhostInput handler may load another recording
+	const TSharedPtr<FTelemetryGhostRecording> Current = Recording;
+	const TArray<FTelemetryGhostSample>& Samples = Current->Samples;
+	while (SampleCursor + 1 < Samples.Num() && Samples[SampleCursor + 1].Time <= PlaybackTime)
+	{
+		++SampleCursor;
+	}
+
+	const FTelemetryGhostSample& From = Samples[SampleCursor];
+	FVector Location = From.Location;
+	FQuat Rotation = From.Rotation;
+	if (SampleCursor + 1 < Samples.Num())
+	{
+		const FTelemetryGhostSample& To = Samples[SampleCursor + 1];
+		const float Alpha = FMath::Clamp((PlaybackTime - From.Time) / FMath::Max(To.Time - From.Time, UE_KINDA_SMALL_NUMBER), 0.0f, 1.0f);
+		Location = FMath::Lerp(From.Location, To.Location, Alpha);
+		Rotation = FQuat::Slerp(From.Rotation, To.Rotation, Alpha);
+	}
+
+	if (AActor* Owner = GetOwner())
+	{
+		Owner->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	const TArray<FTelemetryGhostInput>& Inputs = Current->Inputs;
+	while (Recording == Current && InputCursor < Inputs.Num() && Inputs[InputCursor].Time <= PlaybackTime)
+	{
+		const FTelemetryGhostInput& Input = Inputs[InputCursor++];
+		OnGhostInput.Broadcast(Input.Action, Input.Duration);
+	}
+}
@@ -0,0 +1,211 @@
+#include "TelemetryGhostRecorder.h"
+#include "TelemetryGhostFile.h"
+#include "TelemetryEventQueue.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+
+/** One ghost record as captured, written to disk in the compact tagged layout */
+struct FTelemetryGhostRecord
+{
+	TelemetryGhostFile::ERecordTag Tag = TelemetryGhostFile::ERecordTag::Transform;
+	float Time = 0.0f;
+	FVector3f Location = FVector3f::ZeroVector;
+	uint16 Pitch = 0;
+	uint16 Yaw = 0;
+	uint16 Roll = 0;
+	FName Action;
+	float Duration = 0.0f;
+};
+
+struct FTelemetryGhostRecorder::FStream
+{
+	explicit FStream(uint32 Capacity)
+		: Ring(Capacity)
+	{
+	}
+
+	/** Append everything queued so far to the file (writer tasks only, one at a time) */
+	void Drain()
+	{
+		bDrainQueued.store(false, std::memory_order_relaxed);
+		if (!Writer)
+		{
+			return;
+		}
+
+		FTelemetryGhostRecord Record;
+		while (Ring.Dequeue(Record))
+		{
+			QueuedCount.fetch_sub(1, std::memory_order_relaxed);
+			uint8 Tag = static_cast<uint8>(Record.Tag);
+
+			if (Record.Tag == TelemetryGhostFile::ERecordTag::Transform)
+			{
+				*Writer << Tag << Record.Time << Record.Location.X << Record.Location.Y << Record.Location.Z
+					<< Record.Pitch << Record.Yaw << Record.Roll;
+				continue;
+			}
+
+			// Action names are written once per file and referenced by index after that
+			uint16* NameIndex = NameIndices.Find(Record.Action);
+			if (!NameIndex)
+			{
+				uint8 NameTag = static_cast<uint8>(TelemetryGhostFile::ERecordTag::Name);
+				uint16 NewIndex = static_cast<uint16>(NameIndices.Num());
+				FString Name = Record.Action.ToString();
+				*Writer << NameTag << NewIndex << Name;
+				NameIndex = &NameIndices.Add(Record.Action, NewIndex);
+			}
+			*Writer << Tag << Record.Time << *NameIndex << Record.Duration;
+		}
+	}
+
+	/** Queue a drain behind the previous one - never two writers at once */
+	void ScheduleDrain(const TSharedPtr<FStream, ESPMode::ThreadSafe>& Self)
+	{
+		bDrainQueued.store(true, std::memory_order_relaxed);
+		LastWrite = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Self]() { Self->Drain(); }, UE::Tasks::Prerequisites(LastWrite));
+	}
+
+	TTelemetryEventQueue<FTelemetryGhostRecord> Ring;
+	TUniquePtr<FArchive> Writer;
+	TMap<FName, uint16> NameIndices;
+	FString Path;
+
+	/** Last writer task, each new one runs after it (game thread only) */
+	UE::Tasks::FTask LastWrite;
+
+	std::atomic<int32> QueuedCount{0};
+	std::atomic<bool> bDrainQueued{false};
+	std::atomic<int64> DroppedCount{0};
+};
+
+FTelemetryGhostRecorder::~FTelemetryGhostRecorder()
+{
+	Stop();
+}
+
+bool FTelemetryGhostRecorder::Start(const FString& Path, const FString& RunID, const FTelemetryGhostSettings& Settings, APlayerController* InPlayerController)
+{
+	Stop();
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Could not open ghost file %s"), *Path);
+		return false;
+	}
+
+	uint32 Magic = TelemetryGhostFile::Magic;
+	uint16 Version = TelemetryGhostFile::Version;
+	uint16 Flags = 0;
+	FString RunIDValue = RunID;
+	float SampleRate = FMath::Max(1.0f, Settings.SampleRate);
+	*Writer << Magic << Version << Flags << RunIDValue << SampleRate;
+
+	TSharedPtr<FStream, ESPMode::ThreadSafe> NewStream = MakeShared<FStream, ESPMode::ThreadSafe>(FMath::Max(64, Settings.BufferCapacity));
+	NewStream->Writer = MoveTemp(Writer);
+	NewStream->Path = Path;
+	{
+		FScopeLock Lock(&StreamLock);
+		Stream = NewStream;
+	}
+
+	PlayerController = InPlayerController;
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FTelemetryGhostRecorder::SampleTransform), 1.0f / SampleRate);
+	return true;
+}
+
+void FTelemetryGhostRecorder::Stop()
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+	PlayerController.Reset();
+
+	TSharedPtr<FStream, ESPMode::ThreadSafe> Finished;
+	{
+		FScopeLock Lock(&StreamLock);
+		Finished = MoveTemp(Stream);
+	}
+
+	// The last drain closes the file - the task keeps the stream alive until then
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Finished]()
+	{
+		Finished->Drain();
+		Finished->Writer->Close();
+		Finished->Writer.Reset();
+
+		const int64 Dropped = Finished->DroppedCount.load(std::memory_order_relaxed);
+		if (Dropped > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Ghost recorder dropped %lld records for %s - raise BufferCapacity"),
+				Dropped, *Finished->Path);
+		}
+	}, UE::Tasks::Prerequisites(Finished->LastWrite));
+}
+
+void FTelemetryGhostRecorder::RecordInput(FName Action, float GameTime, float Duration)
+{
+	FScopeLock Lock(&StreamLock);
+	if (!Stream)
+	{
+		return;
+	}
+
+	FTelemetryGhostRecord Record;
+	Record.Tag = TelemetryGhostFile::ERecordTag::Input;
+	Record.Time = GameTime;
+	Record.Action = Action;
+	Record.Duration = Duration;
+	if (!Stream->Ring.TryEnqueue(Record))
+	{
+		Stream->DroppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	Stream->QueuedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool FTelemetryGhostRecorder::SampleTransform(float DeltaTime)
+{
+	const APlayerController* Controller = PlayerController.Get();
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	if (!Pawn)
+	{
+		return true;
+	}
+
+	const FVector Location = Pawn->GetActorLocation();
+	const FRotator Rotation = Pawn->GetActorRotation();
+
+	FTelemetryGhostRecord Record;
+	Record.Tag = TelemetryGhostFile::ERecordTag::Transform;
+	Record.Time = Pawn->GetWorld()->GetTimeSeconds();
+	Record.Location = FVector3f(Location);
+	Record.Pitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+	Record.Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	Record.Roll = FRotator::CompressAxisToShort(Rotation.Roll);
+
+	// Writers are only scheduled from here on the game thread, so one is never queued twice
+	FScopeLock Lock(&StreamLock);
+	if (!Stream->Ring.TryEnqueue(Record))
+	{
+		Stream->DroppedCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	else if (Stream->QueuedCount.fetch_add(1, std::memory_order_relaxed) + 1 >= static_cast<int32>(Stream->Ring.GetCapacity() / 2)
+		&& !Stream->bDrainQueued.load(std::memory_order_relaxed))
+	{
+		Stream->ScheduleDrain(Stream);
+	}
+	return true;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "TelemetryTypes.h"
+
+class APlayerController;
+
+/**
+ * Records one run's pawn transforms and input presses to a ghost file (see TelemetryGhostFile.h)
+ * Producers only push fixed-size records into a preallocated ring; whenever it is half full a
+ * background task appends its contents to the open file. Memory use is fixed by BufferCapacity
+ * no matter how long the run is - if the disk falls behind, records are dropped, never buffered.
+ */
+class FTelemetryGhostRecorder
+{
+public:
+	~FTelemetryGhostRecorder();
+
+	/**
+	 * Open the run's ghost file and start sampling the controller's pawn (game thread only)
+	 * @return false if the file could not be created
+	 */
+	bool Start(const FString& Path, const FString& RunID, const FTelemetryGhostSettings& Settings, APlayerController* PlayerController);
+
+	/** Stop sampling, the file is finished and closed in the background (game thread only) */
+	void Stop();
+
+	bool IsRecording() const { return TickerHandle.IsValid(); }
+
+	/** Add an input press to the recording - safe to call from any thread */
+	void RecordInput(FName Action, float GameTime, float Duration);
+
+private:
+	struct FStream;
+
+	bool SampleTransform(float DeltaTime);
+
+	/** File, ring and writer state of the run being recorded, shared with the writer tasks */
+	TSharedPtr<FStream, ESPMode::ThreadSafe> Stream;
+	FCriticalSection StreamLock;
+
+	TWeakObjectPtr<APlayerController> PlayerController;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,230 @@
+#include "TelemetryHeatmap.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+	/** Bytes of one serialized non-zero cell */
+	constexpr int32 CellEntrySize = sizeof(uint8) + sizeof(uint32);
+	constexpr int32 HeaderSize = sizeof(uint32) + sizeof(uint16) + 2 * sizeof(uint8) + sizeof(float) + sizeof(uint32);
+}
+
+FTelemetryHeatmap::FTelemetryHeatmap(float InCellSize, ETelemetryHeatmapPlane InPlane)
+{
+	Reset(InCellSize, InPlane);
+}
+
+void FTelemetryHeatmap::Reset(float InCellSize, ETelemetryHeatmapPlane InPlane)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	Plane = InPlane;
+	Tiles.Reset();
+}
+
+FIntPoint FTelemetryHeatmap::ToCell(const FVector& Position) const
+{
+	FVector2D Projected;
+	switch (Plane)
+	{
+	case ETelemetryHeatmapPlane::XY: Projected = FVector2D(Position.X, Position.Y); break;
+	case ETelemetryHeatmapPlane::YZ: Projected = FVector2D(Position.Y, Position.Z); break;
+	default:                         Projected = FVector2D(Position.X, Position.Z); break;
+	}
+
+	return FIntPoint(FMath::FloorToInt32(Projected.X / CellSize), FMath::FloorToInt32(Projected.Y / CellSize));
+}
+
+FTelemetryHeatmap::FTile& FTelemetryHeatmap::FindOrAddTile(const FIntPoint& TileCoord)
+{
+	TUniquePtr<FTile>& Tile = Tiles.FindOrAdd(TileCoord);
+	if (!Tile)
+	{
+		Tile = MakeUnique<FTile>();
+	}
+	return *Tile;
+}
+
+void FTelemetryHeatmap::Add(ETelemetryHeatmapLayer Layer, const FVector& Position, uint32 Count)
+{
+	const FIntPoint Cell = ToCell(Position);
+
+	// Arithmetic shift and mask give floor division for negative cells too
+	FTile& Tile = FindOrAddTile(FIntPoint(Cell.X >> TileShift, Cell.Y >> TileShift));
+	const int32 CellIndex = (Cell.Y & (TileCells - 1)) * TileCells + (Cell.X & (TileCells - 1));
+	Tile.Counts[static_cast<int32>(Layer)][CellIndex] += Count;
+}
+
+bool FTelemetryHeatmap::Merge(const FTelemetryHeatmap& Other)
+{
+	if (Other.CellSize != CellSize || Other.Plane != Plane)
+	{
+		return false;
+	}
+
+	for (const TPair<FIntPoint, TUniquePtr<FTile>>& OtherTile : Other.Tiles)
+	{
+		FTile& Tile = FindOrAddTile(OtherTile.Key);
+		for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+		{
+			for (int32 CellIndex = 0; CellIndex < CellsPerTile; ++CellIndex)
+			{
+				Tile.Counts[Layer][CellIndex] += OtherTile.Value->Counts[Layer][CellIndex];
+			}
+		}
+	}
+	return true;
+}
+
+uint32 FTelemetryHeatmap::GetCount(ETelemetryHeatmapLayer Layer, const FIntPoint& Cell) const
+{
+	const TUniquePtr<FTile>* Tile = Tiles.Find(FIntPoint(Cell.X >> TileShift, Cell.Y >> TileShift));
+	if (!Tile)
+	{
+		return 0;
+	}
+
+	const int32 CellIndex = (Cell.Y & (TileCells - 1)) * TileCells + (Cell.X & (TileCells - 1));
+	return (*Tile)->Counts[static_cast<int32>(Layer)][CellIndex];
+}
+
+void FTelemetryHeatmap::ForEachCell(TFunctionRef<void(ETelemetryHeatmapLayer Layer, const FIntPoint& Cell, uint32 Count)> Visitor) const
+{
+	for (const TPair<FIntPoint, TUniquePtr<FTile>>& Tile : Tiles)
+	{
+		for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+		{
+			for (int32 CellIndex = 0; CellIndex < CellsPerTile; ++CellIndex)
+			{
+				if (const uint32 Count = Tile.Value->Counts[Layer][CellIndex])
+				{
+					const FIntPoint Cell(
+						(Tile.Key.X << TileShift) + CellIndex % TileCells,
+						(Tile.Key.Y << TileShift) + CellIndex / TileCells);
+					Visitor(static_cast<ETelemetryHeatmapLayer>(Layer), Cell, Count);
+				}
+			}
+		}
+	}
+}
+
+void FTelemetryHeatmap::Serialize(TArray<uint8>& OutData) const
+{
+	TArray<FIntPoint> TileCoords;
+	Tiles.GetKeys(TileCoords);
+	TileCoords.Sort([](const FIntPoint& A, const FIntPoint& B)
+	{
+		return A.Y != B.Y ? A.Y < B.Y : A.X < B.X;
+	});
+
+	FMemoryWriter Writer(OutData, false, true);
+	uint32 MagicValue = Magic;
+	uint16 Version = SchemaVersion;
+	uint8 PlaneValue = static_cast<uint8>(Plane);
+	uint8 LayerCount = NumLayers;
+	float CellSizeValue = CellSize;
+	uint32 TileCount = TileCoords.Num();
+	Writer << MagicValue << Version << PlaneValue << LayerCount << CellSizeValue << TileCount;
+
+	for (FIntPoint& TileCoord : TileCoords)
+	{
+		const FTile& Tile = *Tiles.FindChecked(TileCoord);
+		Writer << TileCoord.X << TileCoord.Y;
+
+		for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+		{
+			uint16 CellCount = 0;
+			for (const uint32 Count : Tile.Counts[Layer])
+			{
+				CellCount += Count != 0 ? 1 : 0;
+			}
+			Writer << CellCount;
+
+			for (int32 CellIndex = 0; CellIndex < CellsPerTile; ++CellIndex)
+			{
+				uint32 Count = Tile.Counts[Layer][CellIndex];
+				if (Count != 0)
+				{
+					uint8 Index = static_cast<uint8>(CellIndex);
+					Writer << Index << Count;
+				}
+			}
+		}
+	}
+}
+
+bool FTelemetryHeatmap::Deserialize(TConstArrayView<uint8> Data, FTelemetryHeatmap& OutHeatmap, FString* OutError)
+{
+	auto Fail = [OutError](const TCHAR* Message)
+	{
+		if (OutError)
+		{
+			*OutError = Message;
+		}
+		return false;
+	};
+
+	if (Data.Num() < HeaderSize)
+	{
+		return Fail(TEXT("Heatmap shorter than header"));
+	}
+
+	// FMemoryReader needs a TArray - this copy is offline-tool cost only
+	const TArray<uint8> Bytes(Data.GetData(), Data.Num());
+	FMemoryReader Reader(Bytes, true);
+
+	uint32 MagicValue = 0;
+	uint16 Version = 0;
+	uint8 PlaneValue = 0;
+	uint8 LayerCount = 0;
+	float CellSizeValue = 0.0f;
+	uint32 TileCount = 0;
+	Reader << MagicValue << Version << PlaneValue << LayerCount << CellSizeValue << TileCount;
+
+	if (MagicValue != Magic)
+	{
+		return Fail(TEXT("Bad magic"));
+	}
+	if (Version != SchemaVersion)
+	{
+		return Fail(TEXT("Unsupported schema version"));
+	}
+	if (PlaneValue > static_cast<uint8>(ETelemetryHeatmapPlane::YZ) || LayerCount != NumLayers || !(CellSizeValue >= 1.0f))
+	{
+		return Fail(TEXT("Bad heatmap settings"));
+	}
+
+	OutHeatmap.Reset(CellSizeValue, static_cast<ETelemetryHeatmapPlane>(PlaneValue));
+
+	const int32 MinTileSize = 2 * sizeof(int32) + NumLayers * sizeof(uint16);
+	for (uint32 TileIndex = 0; TileIndex < TileCount; ++TileIndex)
+	{
+		if (Reader.TotalSize() - Reader.Tell() < MinTileSize)
+		{
+			return Fail(TEXT("Truncated tile"));
+		}
+
+		FIntPoint TileCoord;
+		Reader << TileCoord.X << TileCoord.Y;
+		FTile& Tile = OutHeatmap.FindOrAddTile(TileCoord);
+
+		for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+		{
+			uint16 CellCount = 0;
+			Reader << CellCount;
+			if (CellCount > CellsPerTile || Reader.TotalSize() - Reader.Tell() < CellCount * CellEntrySize)
+			{
+				return Fail(TEXT("Truncated cell list"));
+			}
+
+			for (uint16 Entry = 0; Entry < CellCount; ++Entry)
+			{
+				uint8 CellIndex = 0;
+				uint32 Count = 0;
+				Reader << CellIndex << Count;
+				Tile.Counts[Layer][CellIndex] += Count;
+			}
+		}
+	}
+
+	return !Reader.IsError() || Fail(TEXT("Read error"));
+}
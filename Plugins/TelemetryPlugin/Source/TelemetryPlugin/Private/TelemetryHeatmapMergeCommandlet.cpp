@@ -0,0 +1,216 @@
+#include "TelemetryHeatmapMergeCommandlet.h"
+#include "TelemetryHeatmap.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/FileManager.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	/** Merges grids into the first one seen, skipping any with other settings */
+	struct FHeatmapMerger
+	{
+		FTelemetryHeatmap Result;
+		bool bHasResult = false;
+		int32 NumMerged = 0;
+		int32 NumSkipped = 0;
+
+		void Add(const FTelemetryHeatmap& Heatmap, const FString& Source)
+		{
+			if (!bHasResult)
+			{
+				Result.Reset(Heatmap.GetCellSize(), Heatmap.GetPlane());
+				bHasResult = true;
+			}
+
+			if (Result.Merge(Heatmap))
+			{
+				++NumMerged;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Skipping heatmap from %s - cell size %.1f / plane %d differ from %.1f / %d"),
+					*Source, Heatmap.GetCellSize(), static_cast<int32>(Heatmap.GetPlane()),
+					Result.GetCellSize(), static_cast<int32>(Result.GetPlane()));
+				++NumSkipped;
+			}
+		}
+
+		void AddEncoded(TConstArrayView<uint8> Data, const FString& Source)
+		{
+			FTelemetryHeatmap Heatmap;
+			FString Error;
+			if (FTelemetryHeatmap::Deserialize(Data, Heatmap, &Error))
+			{
+				Add(Heatmap, Source);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Skipping unreadable heatmap from %s: %s"), *Source, *Error);
+				++NumSkipped;
+			}
+		}
+
+		void AddJsonEvent(const TSharedPtr<FJsonObject>& Event, const FString& Source)
+		{
+			FString EventType;
+			FString Data;
+			if (!Event.IsValid()
+				|| !Event->TryGetStringField(TEXT("event_type"), EventType) || EventType != TEXT("heatmap")
+				|| !Event->TryGetStringField(TEXT("data"), Data))
+			{
+				return;
+			}
+
+			TArray<uint8> Bytes;
+			if (FBase64::Decode(Data, Bytes))
+			{
+				AddEncoded(Bytes, Source);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Skipping heatmap with bad base64 in %s"), *Source);
+				++NumSkipped;
+			}
+		}
+
+		/** A JSON array of events or NDJSON, one event per line */
+		void AddJsonFile(const FString& Path)
+		{
+			FString Text;
+			if (!FFileHelper::LoadFileToString(Text, *Path))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Could not read %s"), *Path);
+				return;
+			}
+
+			TArray<TSharedPtr<FJsonValue>> Events;
+			if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Events))
+			{
+				for (const TSharedPtr<FJsonValue>& Event : Events)
+				{
+					AddJsonEvent(Event.IsValid() ? Event->AsObject() : nullptr, Path);
+				}
+				return;
+			}
+
+			TArray<FString> Lines;
+			Text.ParseIntoArrayLines(Lines);
+			for (const FString& Line : Lines)
+			{
+				TSharedPtr<FJsonObject> Event;
+				if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Event))
+				{
+					AddJsonEvent(Event, Path);
+				}
+			}
+		}
+
+		void AddFile(const FString& Path)
+		{
+			const FString Extension = FPaths::GetExtension(Path).ToLower();
+			if (Extension == TEXT("tlmh"))
+			{
+				TArray<uint8> Bytes;
+				if (FFileHelper::LoadFileToArray(Bytes, *Path))
+				{
+					AddEncoded(Bytes, Path);
+				}
+			}
+			else if (Extension == TEXT("json") || Extension == TEXT("ndjson"))
+			{
+				AddJsonFile(Path);
+			}
+		}
+	};
+}
+
+UTelemetryHeatmapMergeCommandlet::UTelemetryHeatmapMergeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Merge telemetry heatmaps from many sessions into one grid");
+	HelpUsage = TEXT("-run=TelemetryHeatmapMerge -Input=<file or directory> [-Output=<path.tlmh>] [-Csv=<path.csv>]");
+}
+
+int32 UTelemetryHeatmapMergeCommandlet::Main(const FString& Params)
+{
+	const TCHAR* Cmd = *Params;
+
+	FString InputPath;
+	FString OutputPath;
+	FString CsvPath;
+	FParse::Value(Cmd, TEXT("Input="), InputPath);
+	FParse::Value(Cmd, TEXT("Output="), OutputPath);
+	FParse::Value(Cmd, TEXT("Csv="), CsvPath);
+
+	if (InputPath.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	TArray<FString> Files;
+	if (IFileManager::Get().DirectoryExists(*InputPath))
+	{
+		IFileManager::Get().FindFilesRecursive(Files, *InputPath, TEXT("*.*"), true, false);
+		Files.Sort();
+	}
+	else
+	{
+		Files.Add(InputPath);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FHeatmapMerger Merger;
+	for (const FString& File : Files)
+	{
+		Merger.AddFile(File);
+	}
+
+	if (!Merger.bHasResult)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] No heatmaps found in %s"), *InputPath);
+		return 1;
+	}
+
+	if (OutputPath.IsEmpty())
+	{
+		OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("Heatmaps"),
+			FString::Printf(TEXT("Heatmap_%s.tlmh"), *FDateTime::Now().ToString()));
+	}
+
+	TArray<uint8> Encoded;
+	Merger.Result.Serialize(Encoded);
+	if (!FFileHelper::SaveArrayToFile(Encoded, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Could not write merged heatmap to %s"), *OutputPath);
+		return 1;
+	}
+
+	if (!CsvPath.IsEmpty())
+	{
+		static const TCHAR* const LayerNames[] = {TEXT("position"), TEXT("damage"), TEXT("death")};
+
+		FString Csv = TEXT("layer,cell_x,cell_y,count\n");
+		Merger.Result.ForEachCell([&Csv](ETelemetryHeatmapLayer Layer, const FIntPoint& Cell, uint32 Count)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%d,%u\n"), LayerNames[static_cast<int32>(Layer)], Cell.X, Cell.Y, Count);
+		});
+		if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Telemetry] Could not write heatmap CSV to %s"), *CsvPath);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Merged %d heatmaps (%d skipped) into %d tiles in %.2fs - written to %s"),
+		Merger.NumMerged, Merger.NumSkipped, Merger.Result.GetNumTiles(), FPlatformTime::Seconds() - StartTime, *OutputPath);
+
+	return 0;
+}
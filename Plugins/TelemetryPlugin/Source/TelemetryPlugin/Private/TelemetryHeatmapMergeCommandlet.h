@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TelemetryHeatmapMergeCommandlet.generated.h"
+
+/**
+ * Offline merge of heatmaps from many sessions into one grid
+ * Reads raw .tlmh files and heatmap events from .json/.ndjson exports (base64 "data" field),
+ * sums every grid with the same cell size and plane, and writes the result.
+ *
+ * USAGE:
+ * UnrealEditor-Cmd <Project> -run=TelemetryHeatmapMerge -Input=<file or directory>
+ *     [-Output=<path.tlmh>] [-Csv=<path.csv>]
+ * The CSV has one row per non-zero cell: layer,cell_x,cell_y,count
+ */
+UCLASS()
+class UTelemetryHeatmapMergeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTelemetryHeatmapMergeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
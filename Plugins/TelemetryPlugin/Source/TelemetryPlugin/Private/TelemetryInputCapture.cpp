@@ -0,0 +1,128 @@
+#include "TelemetryInputCapture.h"
+#include "TelemetrySubsystem.h"
+#include "EnhancedInputComponent.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+bool UTelemetryInputCapture::Start(UTelemetrySubsystem* InTelemetry, APlayerController* PlayerController, const UInputMappingContext* MappingContext)
+{
+	Stop();
+
+	UEnhancedInputComponent* EnhancedInput = PlayerController ? Cast<UEnhancedInputComponent>(PlayerController->InputComponent) : nullptr;
+	if (!EnhancedInput || !MappingContext)
+	{
+		return false;
+	}
+
+	// Several keys usually map to the same action - bind each action once
+	TSet<const UInputAction*> Actions;
+	for (const FEnhancedActionKeyMapping& Mapping : MappingContext->GetMappings())
+	{
+		if (Mapping.Action)
+		{
+			Actions.Add(Mapping.Action);
+		}
+	}
+	if (Actions.IsEmpty())
+	{
+		return false;
+	}
+
+	for (const UInputAction* Action : Actions)
+	{
+		BindingHandles.Add(EnhancedInput->BindAction(Action, ETriggerEvent::Started, this, &UTelemetryInputCapture::OnStarted).GetHandle());
+		BindingHandles.Add(EnhancedInput->BindAction(Action, ETriggerEvent::Triggered, this, &UTelemetryInputCapture::OnTriggered).GetHandle());
+		BindingHandles.Add(EnhancedInput->BindAction(Action, ETriggerEvent::Completed, this, &UTelemetryInputCapture::OnCompleted).GetHandle());
+		BindingHandles.Add(EnhancedInput->BindAction(Action, ETriggerEvent::Canceled, this, &UTelemetryInputCapture::OnCanceled).GetHandle());
+	}
+
+	Telemetry = InTelemetry;
+	InputComponent = EnhancedInput;
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Capturing %d input actions from %s"), Actions.Num(), *MappingContext->GetName());
+	return true;
+}
+
+void UTelemetryInputCapture::Stop()
+{
+	if (UEnhancedInputComponent* EnhancedInput = InputComponent.Get())
+	{
+		for (const uint32 Handle : BindingHandles)
+		{
+			EnhancedInput->RemoveBindingByHandle(Handle);
+		}
+	}
+
+	BindingHandles.Reset();
+	OpenSpans.Reset();
+	InputComponent.Reset();
+	Telemetry.Reset();
+}
+
+void UTelemetryInputCapture::OnStarted(const FInputActionInstance& Instance)
+{
+	UpdateSpan(Instance);
+}
+
+void UTelemetryInputCapture::OnTriggered(const FInputActionInstance& Instance)
+{
+	++UpdateSpan(Instance).TriggerCount;
+}
+
+void UTelemetryInputCapture::OnCompleted(const FInputActionInstance& Instance)
+{
+	FinishSpan(Instance, false);
+}
+
+void UTelemetryInputCapture::OnCanceled(const FInputActionInstance& Instance)
+{
+	FinishSpan(Instance, true);
+}
+
+FTelemetryInputSpan& UTelemetryInputCapture::UpdateSpan(const FInputActionInstance& Instance)
+{
+	const FInputActionValue& Value = Instance.GetValue();
+	const FVector3f Axes(Value.Get<FVector>());
+
+	FTelemetryInputSpan* Span = OpenSpans.Find(Instance.GetSourceAction());
+	if (!Span)
+	{
+		Span = &OpenSpans.Add(Instance.GetSourceAction());
+		Span->Action = Instance.GetSourceAction() ? Instance.GetSourceAction()->GetFName() : NAME_None;
+		Span->StartTime = GetGameTime();
+		Span->NumAxes = FMath::Max(1, static_cast<int32>(Value.GetValueType()));
+		Span->MinValue = Axes;
+		Span->MaxValue = Axes;
+		return *Span;
+	}
+
+	Span->MinValue = Span->MinValue.ComponentMin(Axes);
+	Span->MaxValue = Span->MaxValue.ComponentMax(Axes);
+	return *Span;
+}
+
+void UTelemetryInputCapture::FinishSpan(const FInputActionInstance& Instance, bool bCanceled)
+{
+	FTelemetryInputSpan Span;
+	if (!OpenSpans.RemoveAndCopyValue(Instance.GetSourceAction(), Span))
+	{
+		return;
+	}
+
+	Span.Duration = FMath::Max(0.0f, GetGameTime() - Span.StartTime);
+	Span.bCanceled = bCanceled;
+
+	if (UTelemetrySubsystem* TelemetrySubsystem = Telemetry.Get())
+	{
+		TelemetrySubsystem->SendInputSpan(MoveTemp(Span));
+	}
+}
+
+float UTelemetryInputCapture::GetGameTime() const
+{
+	const UEnhancedInputComponent* EnhancedInput = InputComponent.Get();
+	const UWorld* World = EnhancedInput ? EnhancedInput->GetWorld() : nullptr;
+	return World ? World->GetTimeSeconds() : 0.0f;
+}
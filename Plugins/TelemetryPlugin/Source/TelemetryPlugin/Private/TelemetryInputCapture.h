@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "TelemetryInputSpan.h"
+#include "TelemetryInputCapture.generated.h"
+
+class APlayerController;
+class UEnhancedInputComponent;
+class UInputAction;
+class UInputMappingContext;
+class UTelemetrySubsystem;
+struct FInputActionInstance;
+
+/**
+ * Listens to a local player's Enhanced Input component and turns every press of a mapped
+ * action into one input span
+ * Bindings are added next to the game's own, so nothing is consumed and no Blueprint runs
+ * per frame. A held action that fires Triggered every frame still produces a single span.
+ */
+UCLASS()
+class UTelemetryInputCapture : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Bind every action of the mapping context on the controller's input component
+	 * @return false if the controller has no Enhanced Input component or the context no mappings
+	 */
+	bool Start(UTelemetrySubsystem* InTelemetry, APlayerController* PlayerController, const UInputMappingContext* MappingContext);
+
+	/** Remove the bindings and drop any open spans */
+	void Stop();
+
+	bool IsCapturing() const { return InputComponent.IsValid(); }
+
+private:
+	void OnStarted(const FInputActionInstance& Instance);
+	void OnTriggered(const FInputActionInstance& Instance);
+	void OnCompleted(const FInputActionInstance& Instance);
+	void OnCanceled(const FInputActionInstance& Instance);
+
+	/** Fold the instance's value into the open span for its action, opening one if needed */
+	FTelemetryInputSpan& UpdateSpan(const FInputActionInstance& Instance);
+
+	/** Close the action's span and hand it to the subsystem */
+	void FinishSpan(const FInputActionInstance& Instance, bool bCanceled);
+
+	float GetGameTime() const;
+
+	TWeakObjectPtr<UTelemetrySubsystem> Telemetry;
+	TWeakObjectPtr<UEnhancedInputComponent> InputComponent;
+	TArray<uint32> BindingHandles;
+
+	/** Spans of actions currently held, keyed by action */
+	TMap<TObjectKey<UInputAction>, FTelemetryInputSpan> OpenSpans;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One press of an input action, from start to completion
+ * Every Triggered in between is folded into the trigger count and the value range.
+ */
+struct FTelemetryInputSpan
+{
+	FName Action;
+
+	/** Game time the action started */
+	float StartTime = 0.0f;
+
+	/** Seconds from start to completion or cancellation */
+	float Duration = 0.0f;
+
+	int32 TriggerCount = 0;
+
+	/** Components of the action value that are meaningful (1 for bool/Axis1D, up to 3) */
+	int32 NumAxes = 1;
+
+	/** Per-axis value range over the span */
+	FVector3f MinValue = FVector3f::ZeroVector;
+	FVector3f MaxValue = FVector3f::ZeroVector;
+
+	/** Ended by cancellation (e.g. a hold released early) rather than completion */
+	bool bCanceled = false;
+};
@@ -0,0 +1,96 @@
+#include "TelemetryJsonWriter.h"
+#include "Misc/StringBuilder.h"
+
+void FTelemetryJsonWriter::WriteInt(int64 Value)
+{
+	ANSICHAR Digits[24];
+	const int32 Length = FCStringAnsi::Snprintf(Digits, UE_ARRAY_COUNT(Digits), "%lld", static_cast<long long>(Value));
+	Buffer.Append(reinterpret_cast<const uint8*>(Digits), Length);
+}
+
+void FTelemetryJsonWriter::WriteFloat(float Value)
+{
+	if (!FMath::IsFinite(Value))
+	{
+		WriteRaw("null");
+		return;
+	}
+
+	// Most game values round-trip in 6-8 digits; 9 always does
+	ANSICHAR Digits[32];
+	int32 Length = 0;
+	for (int32 Precision = 6; Precision <= 9; ++Precision)
+	{
+		Length = FCStringAnsi::Snprintf(Digits, UE_ARRAY_COUNT(Digits), "%.*g", Precision, static_cast<double>(Value));
+		if (Precision == 9 || static_cast<float>(FCStringAnsi::Atod(Digits)) == Value)
+		{
+			break;
+		}
+	}
+	Buffer.Append(reinterpret_cast<const uint8*>(Digits), Length);
+}
+
+void FTelemetryJsonWriter::WriteString(FStringView Value)
+{
+	WriteChar('"');
+
+	// Names and IDs fit the stack buffer; anything longer takes the allocating path
+	UTF8CHAR Utf8[512];
+	const int32 Utf8Length = FPlatformString::ConvertedLength<UTF8CHAR>(Value.GetData(), Value.Len());
+	if (Utf8Length <= UE_ARRAY_COUNT(Utf8))
+	{
+		FPlatformString::Convert(Utf8, UE_ARRAY_COUNT(Utf8), Value.GetData(), Value.Len());
+		WriteEscapedUtf8(Utf8, Utf8Length);
+	}
+	else
+	{
+		const FTCHARToUTF8 Converted(Value.GetData(), Value.Len());
+		WriteEscapedUtf8(reinterpret_cast<const UTF8CHAR*>(Converted.Get()), Converted.Length());
+	}
+
+	WriteChar('"');
+}
+
+void FTelemetryJsonWriter::WriteName(FName Value)
+{
+	// Producers turn empty strings into None - keep them empty on the wire
+	if (Value.IsNone())
+	{
+		WriteRaw("\"\"");
+		return;
+	}
+
+	TStringBuilder<256> Builder;
+	Value.AppendString(Builder);
+	WriteString(Builder.ToView());
+}
+
+void FTelemetryJsonWriter::WriteEscapedUtf8(const UTF8CHAR* Utf8, int32 Length)
+{
+	static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		const uint8 Byte = static_cast<uint8>(Utf8[Index]);
+		switch (Byte)
+		{
+		case '"':  WriteRaw("\\\""); break;
+		case '\\': WriteRaw("\\\\"); break;
+		case '\n': WriteRaw("\\n"); break;
+		case '\r': WriteRaw("\\r"); break;
+		case '\t': WriteRaw("\\t"); break;
+		default:
+			if (Byte < 0x20)
+			{
+				const ANSICHAR Escape[] = {'\\', 'u', '0', '0', HexDigits[Byte >> 4], HexDigits[Byte & 0xF]};
+				Buffer.Append(reinterpret_cast<const uint8*>(Escape), UE_ARRAY_COUNT(Escape));
+			}
+			else
+			{
+				// Multi-byte UTF-8 sequences pass through unchanged
+				Buffer.Add(Byte);
+			}
+			break;
+		}
+	}
+}
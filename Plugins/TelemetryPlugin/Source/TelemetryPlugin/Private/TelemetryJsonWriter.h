@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Minimal streaming JSON writer that appends UTF-8 straight into a caller-owned byte buffer
+ * Used instead of FJsonObject + TJsonWriter on the hot path: no DOM nodes, no TCHAR
+ * strings, and no heap traffic once the buffer has grown to its working size.
+ * The caller is responsible for structure (braces, commas) - this only formats values.
+ */
+class FTelemetryJsonWriter
+{
+public:
+	explicit FTelemetryJsonWriter(TArray<uint8>& InBuffer)
+		: Buffer(InBuffer)
+	{
+	}
+
+	/** Append pre-built JSON text, e.g. a literal key or a cached prefix */
+	void WriteRaw(const ANSICHAR* Literal)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(Literal), FCStringAnsi::Strlen(Literal));
+	}
+
+	void WriteRaw(TConstArrayView<uint8> Bytes)
+	{
+		Buffer.Append(Bytes.GetData(), Bytes.Num());
+	}
+
+	void WriteChar(ANSICHAR Char)
+	{
+		Buffer.Add(static_cast<uint8>(Char));
+	}
+
+	void WriteInt(int64 Value);
+
+	/** Fewest digits (6-9) that read back as the same float, or null for NaN/Inf which JSON cannot represent */
+	void WriteFloat(float Value);
+
+	/** Quoted, escaped string */
+	void WriteString(FStringView Value);
+
+	/** Quoted, escaped FName without building an FString */
+	void WriteName(FName Value);
+
+private:
+	/** Append UTF-8 bytes with JSON escaping applied */
+	void WriteEscapedUtf8(const UTF8CHAR* Utf8, int32 Length);
+
+	TArray<uint8>& Buffer;
+};
@@ -0,0 +1,70 @@
+#include "TelemetryLatency.h"
+#include "TelemetryJsonWriter.h"
+#include "TelemetryStats.h"
+
+void FTelemetryDeliveryReport::WriteJsonFields(FTelemetryJsonWriter& Writer) const
+{
+	Writer.WriteRaw(",\"interval\":");
+	Writer.WriteFloat(static_cast<float>(Interval));
+	Writer.WriteRaw(",\"batches\":");
+	Writer.WriteInt(Batches);
+	Writer.WriteRaw(",\"failed_batches\":");
+	Writer.WriteInt(FailedBatches);
+	Writer.WriteRaw(",\"last_seq\":");
+	Writer.WriteInt(LastSequence);
+	Writer.WriteRaw(",\"shed_events\":");
+	Writer.WriteInt(ShedEvents);
+	Writer.WriteRaw(",\"dropped_events\":");
+	Writer.WriteInt(DroppedEvents);
+	Writer.WriteRaw(",\"delivery_ms\":");
+	Delivery.WriteJson(Writer);
+	Writer.WriteRaw(",\"queue_ms\":");
+	Queue.WriteJson(Writer);
+	Writer.WriteRaw(",\"serialize_ms\":");
+	Serialize.WriteJson(Writer);
+	Writer.WriteRaw(",\"round_trip_ms\":");
+	RoundTrip.WriteJson(Writer);
+}
+
+void FTelemetryLatencyTracker::AddBatch(const FTelemetryBatchTiming& Timing, double ResponseTime, bool bAccepted)
+{
+	// Spool replays carry no timing - their events were captured in an earlier session
+	if (Timing.CaptureTimes.IsEmpty())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (!bAccepted)
+	{
+		++Current.FailedBatches;
+		return;
+	}
+
+	++Current.Batches;
+	Current.Serialize.Add((Timing.SerializeEnd - Timing.SerializeStart) * 1000.0);
+	Current.RoundTrip.Add((ResponseTime - Timing.SendTime) * 1000.0);
+	for (const double CaptureTime : Timing.CaptureTimes)
+	{
+		Current.Delivery.Add((ResponseTime - CaptureTime) * 1000.0);
+		Current.Queue.Add(FMath::Max(0.0, Timing.SerializeStart - CaptureTime) * 1000.0);
+	}
+
+	SET_FLOAT_STAT(STAT_TelemetryDeliveryLatencyP50, Current.Delivery.GetPercentile(50.0));
+	SET_FLOAT_STAT(STAT_TelemetryDeliveryLatencyP95, Current.Delivery.GetPercentile(95.0));
+	SET_FLOAT_STAT(STAT_TelemetryDeliveryLatencyP99, Current.Delivery.GetPercentile(99.0));
+}
+
+bool FTelemetryLatencyTracker::HasSamples() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Current.Batches > 0 || Current.FailedBatches > 0;
+}
+
+FTelemetryDeliveryReport FTelemetryLatencyTracker::TakeReport()
+{
+	FScopeLock ScopeLock(&Lock);
+	FTelemetryDeliveryReport Report = Current;
+	Current = FTelemetryDeliveryReport();
+	return Report;
+}
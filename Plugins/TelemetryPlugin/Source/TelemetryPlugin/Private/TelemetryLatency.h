@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryFramePerformance.h"
+
+class FTelemetryJsonWriter;
+
+/**
+ * When one upload body passed each stage, on the FPlatformTime::Seconds clock
+ * Travels with the body through the waiting queue, the stream and the HTTP request.
+ */
+struct FTelemetryBatchTiming
+{
+	/** Capture time of every event in the body */
+	TArray<double> CaptureTimes;
+
+	double SerializeStart = 0.0;
+	double SerializeEnd = 0.0;
+
+	/** Handed to the HTTP module or put on the stream, 0 until then */
+	double SendTime = 0.0;
+};
+
+/** Delivery latency gathered since the previous delivery_report */
+struct FTelemetryDeliveryReport
+{
+	/** Capture to collector response, per event */
+	FTelemetryFrameHistogram Delivery;
+
+	/** Capture to serialization, per event - time spent in the queue, coalescing and batching */
+	FTelemetryFrameHistogram Queue;
+
+	/** Serialization and compression, per batch */
+	FTelemetryFrameHistogram Serialize;
+
+	/** Send to collector response, per batch */
+	FTelemetryFrameHistogram RoundTrip;
+
+	int32 Batches = 0;
+	int32 FailedBatches = 0;
+
+	/** Filled in by the worker when the report is sent */
+	double Interval = 0.0;
+	uint32 LastSequence = 0;
+	int64 ShedEvents = 0;
+	int64 DroppedEvents = 0;
+
+	/** Stream the delivery_report event fields, starting with a leading comma */
+	void WriteJsonFields(FTelemetryJsonWriter& Writer) const;
+};
+
+/**
+ * Collects per-batch timings as the collector answers
+ * AddBatch runs on the HTTP thread (POST) or the game thread (stream acks); the worker takes a
+ * report every DeliveryReportInterval. Percentiles of the current window are also published
+ * as "stat Telemetry" values.
+ */
+class FTelemetryLatencyTracker
+{
+public:
+	/** The collector answered for a batch - rejected batches only count as failed */
+	void AddBatch(const FTelemetryBatchTiming& Timing, double ResponseTime, bool bAccepted);
+
+	bool HasSamples() const;
+
+	/** Hand over everything since the last call and start a new window */
+	FTelemetryDeliveryReport TakeReport();
+
+private:
+	FTelemetryDeliveryReport Current;
+	mutable FCriticalSection Lock;
+};
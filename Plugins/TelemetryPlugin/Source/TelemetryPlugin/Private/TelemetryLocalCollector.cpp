@@ -0,0 +1,481 @@
+#include "TelemetryLocalCollector.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "TelemetryBinaryFormat.h"
+#include "TelemetryCompression.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "HttpPath.h"
+#include "IHttpRouter.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	/** First value of a request header (header names are case-insensitive) */
+	FString GetHeader(const FHttpServerRequest& Request, const TCHAR* Name)
+	{
+		const TArray<FString>* Values = Request.Headers.Find(Name);
+		return Values && Values->Num() > 0 ? (*Values)[0] : FString();
+	}
+
+	bool HasNumber(const FJsonObject& Object, const TCHAR* Field)
+	{
+		double Value;
+		return Object.TryGetNumberField(Field, Value);
+	}
+
+	bool HasString(const FJsonObject& Object, const TCHAR* Field)
+	{
+		FString Value;
+		return Object.TryGetStringField(Field, Value);
+	}
+
+	bool HasPosition(const FJsonObject& Object)
+	{
+		const TSharedPtr<FJsonObject>* Position;
+		return Object.TryGetObjectField(TEXT("player_pos"), Position)
+			&& HasNumber(**Position, TEXT("x")) && HasNumber(**Position, TEXT("y")) && HasNumber(**Position, TEXT("z"));
+	}
+
+	/**
+	 * Check one JSON event against the layout the worker writes and collect its game_time and sequence
+	 * Dictionary definitions are validated but not counted as events
+	 */
+	bool AddJsonEvent(const TSharedPtr<FJsonObject>& Event, TArray<FTelemetryLocalCollector::FDecodedEvent>& OutEvents,
+		FString& OutSessionID, FString& OutError)
+	{
+		FString EventType;
+		double GameTime = 0.0;
+		if (!Event.IsValid()
+			|| !HasString(*Event, TEXT("machine_id"))
+			|| !Event->TryGetStringField(TEXT("session_id"), OutSessionID)
+			|| !Event->TryGetStringField(TEXT("event_type"), EventType)
+			|| !HasNumber(*Event, TEXT("frame"))
+			|| !Event->TryGetNumberField(TEXT("game_time"), GameTime))
+		{
+			OutError = TEXT("event is missing a base field");
+			return false;
+		}
+
+		bool bValid = true;
+		if (EventType == TEXT("position"))
+		{
+			bValid = HasPosition(*Event);
+		}
+		else if (EventType == TEXT("input_received"))
+		{
+			const TSharedPtr<FJsonObject>* InputAction;
+			bValid = Event->TryGetObjectField(TEXT("input_action"), InputAction)
+				&& (HasString(**InputAction, TEXT("action_name")) || HasNumber(**InputAction, TEXT("action_id")));
+		}
+		else if (EventType == TEXT("damage"))
+		{
+			bValid = HasPosition(*Event)
+				&& HasNumber(*Event, TEXT("damage"))
+				&& HasNumber(*Event, TEXT("health_before"))
+				&& HasNumber(*Event, TEXT("health_after"))
+				&& (HasString(*Event, TEXT("damage_source")) || HasNumber(*Event, TEXT("damage_source_id")));
+		}
+		else if (EventType == TEXT("death"))
+		{
+			bValid = HasPosition(*Event) && (HasString(*Event, TEXT("cause")) || HasNumber(*Event, TEXT("cause_id")));
+		}
+		else if (EventType == TEXT("run_end"))
+		{
+			bValid = HasString(*Event, TEXT("run_id")) && HasString(*Event, TEXT("end_reason"));
+		}
+		else if (EventType == TEXT("run_start"))
+		{
+			bValid = HasString(*Event, TEXT("run_id"));
+		}
+		else if (EventType == TEXT("input_span"))
+		{
+			const TSharedPtr<FJsonObject>* InputAction;
+			const TArray<TSharedPtr<FJsonValue>>* ValueMin;
+			const TArray<TSharedPtr<FJsonValue>>* ValueMax;
+			bValid = Event->TryGetObjectField(TEXT("input_action"), InputAction) && HasString(**InputAction, TEXT("action_name"))
+				&& HasNumber(*Event, TEXT("start_time"))
+				&& HasNumber(*Event, TEXT("duration"))
+				&& HasNumber(*Event, TEXT("trigger_count"))
+				&& Event->TryGetArrayField(TEXT("value_min"), ValueMin)
+				&& Event->TryGetArrayField(TEXT("value_max"), ValueMax) && ValueMin->Num() == ValueMax->Num();
+		}
+		else if (EventType == TEXT("position_frame"))
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Actors;
+			const TArray<TSharedPtr<FJsonValue>>* X;
+			const TArray<TSharedPtr<FJsonValue>>* Y;
+			const TArray<TSharedPtr<FJsonValue>>* Z;
+			bValid = Event->TryGetArrayField(TEXT("actors"), Actors)
+				&& Event->TryGetArrayField(TEXT("x"), X) && X->Num() == Actors->Num()
+				&& Event->TryGetArrayField(TEXT("y"), Y) && Y->Num() == Actors->Num()
+				&& Event->TryGetArrayField(TEXT("z"), Z) && Z->Num() == Actors->Num();
+		}
+		else if (EventType == TEXT("heatmap"))
+		{
+			bValid = HasString(*Event, TEXT("scope"))
+				&& HasNumber(*Event, TEXT("cell_size"))
+				&& HasString(*Event, TEXT("data"));
+		}
+		else if (EventType == TEXT("run_summary"))
+		{
+			const TSharedPtr<FJsonObject>* InputCounts;
+			bValid = HasString(*Event, TEXT("run_id"))
+				&& HasNumber(*Event, TEXT("distance_travelled"))
+				&& HasNumber(*Event, TEXT("rooms_cleared"))
+				&& Event->TryGetObjectField(TEXT("input_counts"), InputCounts);
+		}
+		else if (EventType == TEXT("frame_performance"))
+		{
+			const TSharedPtr<FJsonObject>* FrameTime;
+			const TArray<TSharedPtr<FJsonValue>>* Hitches;
+			bValid = HasString(*Event, TEXT("run_id"))
+				&& Event->TryGetObjectField(TEXT("frame_ms"), FrameTime) && HasNumber(**FrameTime, TEXT("count"))
+				&& Event->TryGetArrayField(TEXT("hitches"), Hitches)
+				&& HasNumber(*Event, TEXT("peak_used_physical_mb"));
+		}
+		else if (EventType == TEXT("delivery_report"))
+		{
+			const TSharedPtr<FJsonObject>* Delivery;
+			bValid = HasNumber(*Event, TEXT("batches"))
+				&& HasNumber(*Event, TEXT("last_seq"))
+				&& Event->TryGetObjectField(TEXT("delivery_ms"), Delivery) && HasNumber(**Delivery, TEXT("p99"));
+		}
+		else if (EventType == TEXT("dictionary"))
+		{
+			if (!HasNumber(*Event, TEXT("string_id")) || !HasString(*Event, TEXT("value")))
+			{
+				OutError = TEXT("dictionary event without string_id/value");
+				return false;
+			}
+			return true;
+		}
+		else if (EventType != TEXT("session_start") && EventType != TEXT("session_end"))
+		{
+			OutError = FString::Printf(TEXT("unknown event_type '%s'"), *EventType);
+			return false;
+		}
+
+		double Sequence = 0.0;
+		if (!bValid
+			|| !Event->TryGetNumberField(TEXT("seq"), Sequence)
+			|| !HasNumber(*Event, TEXT("engine_frame"))
+			|| !HasNumber(*Event, TEXT("capture_us")))
+		{
+			OutError = FString::Printf(TEXT("%s event is missing a field"), *EventType);
+			return false;
+		}
+
+		OutEvents.Add({static_cast<float>(GameTime), static_cast<uint32>(Sequence)});
+		return true;
+	}
+}
+
+FTelemetryLocalCollector::FTelemetryLocalCollector(uint32 InPort, const FString& InPath)
+	: Port(InPort)
+	, Path(InPath)
+{
+}
+
+FTelemetryLocalCollector::~FTelemetryLocalCollector()
+{
+	Stop();
+}
+
+bool FTelemetryLocalCollector::Start()
+{
+	FHttpServerModule& HttpServer = FHttpServerModule::Get();
+
+	Router = HttpServer.GetHttpRouter(Port, /*bFailOnBindFailure*/ true);
+	if (!Router)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Local collector could not bind port %u"), Port);
+		return false;
+	}
+
+	RouteHandle = Router->BindRoute(FHttpPath(Path), EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateRaw(this, &FTelemetryLocalCollector::HandleRequest));
+	if (!RouteHandle)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Local collector could not bind route %s"), *Path);
+		Router.Reset();
+		return false;
+	}
+
+	HttpServer.StartAllListeners();
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FTelemetryLocalCollector::TickDelayedResponses));
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Local collector listening on %s"), *GetURL());
+	return true;
+}
+
+void FTelemetryLocalCollector::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// Answer whatever is still held back so clients are not left hanging
+	for (FDelayedResponse& Delayed : DelayedResponses)
+	{
+		Delayed.OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::ServiceUnavail));
+	}
+	DelayedResponses.Reset();
+
+	if (Router && RouteHandle)
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+	RouteHandle.Reset();
+	Router.Reset();
+}
+
+FString FTelemetryLocalCollector::GetURL() const
+{
+	return FString::Printf(TEXT("http://127.0.0.1:%u%s"), Port, *Path);
+}
+
+double FTelemetryLocalCollector::GetPercentile(TConstArrayView<double> SortedValues, double Fraction)
+{
+	if (SortedValues.IsEmpty())
+	{
+		return 0.0;
+	}
+	const int32 Index = FMath::Clamp(FMath::FloorToInt32(Fraction * (SortedValues.Num() - 1)), 0, SortedValues.Num() - 1);
+	return SortedValues[Index];
+}
+
+void FTelemetryLocalCollector::SetFaults(const FFaultSettings& InFaults)
+{
+	Faults = InFaults;
+	FaultStream.Initialize(Faults.Seed);
+}
+
+bool FTelemetryLocalCollector::TickDelayedResponses(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < DelayedResponses.Num();)
+	{
+		if (DelayedResponses[Index].DueTime > Now)
+		{
+			++Index;
+			continue;
+		}
+
+		FDelayedResponse Delayed = MoveTemp(DelayedResponses[Index]);
+		DelayedResponses.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Delayed.OnComplete(MakeResponse(Delayed.bError));
+	}
+	return true;
+}
+
+TUniquePtr<FHttpServerResponse> FTelemetryLocalCollector::MakeResponse(bool bError) const
+{
+	if (!bError)
+	{
+		return FHttpServerResponse::Ok();
+	}
+
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Error(EHttpServerResponseCodes::ServerError);
+	if (Faults.RetryAfterSeconds > 0)
+	{
+		Response->Headers.Add(TEXT("Retry-After"), {FString::FromInt(Faults.RetryAfterSeconds)});
+	}
+	return Response;
+}
+
+bool FTelemetryLocalCollector::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const double ReceiveTime = FPlatformTime::Seconds();
+
+	++Stats.Requests;
+	Stats.WireBytes += Request.Body.Num();
+
+	// Faults are drawn first so the sequence only depends on request order
+	const bool bTimeout = Faults.TimeoutRate > 0.0f && FaultStream.FRand() < Faults.TimeoutRate;
+	const bool bError = !bTimeout && Faults.ErrorRate > 0.0f && FaultStream.FRand() < Faults.ErrorRate;
+	const double DelaySeconds = (Faults.LatencyMs + FaultStream.FRandRange(0.0f, Faults.LatencyJitterMs)) / 1000.0;
+
+	if (bTimeout)
+	{
+		// Never answered - the client's request timeout fires
+		++Stats.InjectedTimeouts;
+		return true;
+	}
+
+	TConstArrayView<uint8> Body = Request.Body;
+	TArray<uint8> Decompressed;
+
+	const FString ContentEncoding = GetHeader(Request, TEXT("Content-Encoding"));
+	const ETelemetryCompression Compression = TelemetryCompression::FromContentEncoding(ContentEncoding);
+	bool bValid = ContentEncoding.IsEmpty() || Compression != ETelemetryCompression::None;
+	if (bValid && Compression != ETelemetryCompression::None)
+	{
+		bValid = TelemetryCompression::Decompress(Compression, Request.Body, Decompressed);
+		Body = Decompressed;
+	}
+
+	FString Error = bValid ? FString() : FString::Printf(TEXT("cannot decode Content-Encoding '%s'"), *ContentEncoding);
+	TArray<FDecodedEvent> Events;
+	FString SessionID;
+	bValid = bValid && DecodeEvents(GetHeader(Request, TEXT("Content-Type")), Body, Events, SessionID, Error);
+
+	Stats.RequestMs.Add((FPlatformTime::Seconds() - ReceiveTime) * 1000.0);
+
+	if (!bValid)
+	{
+		++Stats.RejectedRequests;
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Local collector rejected request: %s"), *Error);
+		OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("invalid_batch"), Error));
+		return true;
+	}
+
+	Stats.DecodedBytes += Body.Num();
+
+	// Sent again after a lost response - acknowledged, but already counted
+	const FString IdempotencyKey = GetHeader(Request, TEXT("Idempotency-Key"));
+	const bool bDuplicate = !bError && !IdempotencyKey.IsEmpty() && AcceptedKeys.Contains(IdempotencyKey);
+
+	if (!bError && !bDuplicate && ClockOrigin >= 0.0)
+	{
+		const double Now = ReceiveTime - ClockOrigin;
+		for (const FDecodedEvent& Event : Events)
+		{
+			Stats.LatenciesMs.Add((Now - Event.GameTime) * 1000.0);
+		}
+	}
+
+	if (bError)
+	{
+		// Rejected batches are not counted as delivered - the client keeps them for retry
+		++Stats.InjectedErrors;
+	}
+	else if (bDuplicate)
+	{
+		++Stats.DuplicateBatches;
+	}
+	else
+	{
+		if (!IdempotencyKey.IsEmpty())
+		{
+			AcceptedKeys.Add(IdempotencyKey);
+		}
+		Stats.Events += Events.Num();
+		AddSequences(SessionID, Events);
+	}
+
+	if (DelaySeconds > 0.0)
+	{
+		DelayedResponses.Add({ReceiveTime + DelaySeconds, bError, OnComplete});
+	}
+	else
+	{
+		OnComplete(MakeResponse(bError));
+	}
+	return true;
+}
+
+void FTelemetryLocalCollector::AddSequences(const FString& SessionID, TConstArrayView<FDecodedEvent> Events)
+{
+	FSessionSequences& Session = ReceivedSequences.FindOrAdd(SessionID);
+	for (const FDecodedEvent& Event : Events)
+	{
+		// Batches from clients without sequence numbers (version 1 binary) carry 0
+		if (Event.Sequence == 0)
+		{
+			continue;
+		}
+
+		if (static_cast<int32>(Event.Sequence) >= Session.Received.Num())
+		{
+			Session.Received.Add(false, Event.Sequence + 1 - Session.Received.Num());
+		}
+		if (Session.Received[Event.Sequence])
+		{
+			++Stats.DuplicateEvents;
+			continue;
+		}
+
+		// Every number passed over is missing until it turns up, e.g. in a retried batch
+		Session.Received[Event.Sequence] = true;
+		if (Event.Sequence > Session.Highest)
+		{
+			Stats.MissingEvents += Event.Sequence - Session.Highest - 1;
+			Session.Highest = Event.Sequence;
+		}
+		else
+		{
+			--Stats.MissingEvents;
+		}
+	}
+}
+
+bool FTelemetryLocalCollector::DecodeEvents(const FString& ContentType, TConstArrayView<uint8> Body, TArray<FDecodedEvent>& OutEvents,
+	FString& OutSessionID, FString& OutError)
+{
+	if (ContentType.StartsWith(TelemetryBinaryFormat::ContentType))
+	{
+		TelemetryBinaryFormat::FDecodedBatch Batch;
+		if (!TelemetryBinaryFormat::DecodeBatch(Body, Batch, &OutError))
+		{
+			return false;
+		}
+
+		OutSessionID = Batch.SessionID;
+		for (const FTelemetryEventRecord& Record : Batch.Records)
+		{
+			OutEvents.Add({Record.GameTime, Record.Sequence});
+		}
+		return true;
+	}
+
+	const FUTF8ToTCHAR Text(reinterpret_cast<const UTF8CHAR*>(Body.GetData()), Body.Num());
+	const FString BodyString(Text.Length(), Text.Get());
+
+	if (ContentType.StartsWith(TEXT("application/x-ndjson")))
+	{
+		TArray<FString> Lines;
+		BodyString.ParseIntoArrayLines(Lines);
+		for (const FString& Line : Lines)
+		{
+			TSharedPtr<FJsonObject> Event;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Event))
+			{
+				OutError = TEXT("NDJSON line is not a JSON object");
+				return false;
+			}
+			if (!AddJsonEvent(Event, OutEvents, OutSessionID, OutError))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Events;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BodyString), Events))
+	{
+		OutError = TEXT("body is not a JSON array");
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Event : Events)
+	{
+		const TSharedPtr<FJsonObject>* EventObject;
+		if (!Event->TryGetObject(EventObject) || !AddJsonEvent(*EventObject, OutEvents, OutSessionID, OutError))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif // !UE_BUILD_SHIPPING
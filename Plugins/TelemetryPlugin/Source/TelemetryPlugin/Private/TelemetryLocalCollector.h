@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Development tooling on the HTTPServer module, which shipping builds do not link - see TelemetryPlugin.Build.cs
+#if !UE_BUILD_SHIPPING
+
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+#include "Containers/Ticker.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+/**
+ * In-process stand-in for the telemetry collector
+ * Listens on the engine's HTTP server, accepts every upload format the plugin produces
+ * (JSON array, NDJSON, binary; uncompressed, gzip or deflate), validates the event schema
+ * and counts what arrives, so benchmarks and load tests need no network or external server.
+ * Collector-side slowdowns can be reproduced with seeded latency, error and timeout injection.
+ * Requests are handled on the game thread while the core ticker runs.
+ */
+class FTelemetryLocalCollector
+{
+public:
+	/** Misbehaviour to inject, drawn from a seeded stream so runs are reproducible */
+	struct FFaultSettings
+	{
+		/** Delay before every response, in milliseconds, plus up to LatencyJitterMs extra */
+		float LatencyMs = 0.0f;
+		float LatencyJitterMs = 0.0f;
+
+		/** Fraction of requests answered with 500 */
+		float ErrorRate = 0.0f;
+
+		/** Fraction of requests never answered, so the client times out */
+		float TimeoutRate = 0.0f;
+
+		/** Sent as Retry-After with injected errors, in seconds - 0 sends none */
+		int32 RetryAfterSeconds = 0;
+
+		int32 Seed = 0;
+	};
+
+	/** Totals since Start or the last ResetStats */
+	struct FStats
+	{
+		int64 Requests = 0;
+		int64 RejectedRequests = 0;
+		int64 InjectedErrors = 0;
+		int64 InjectedTimeouts = 0;
+		int64 Events = 0;
+
+		/** Body bytes as received, and after decompression */
+		int64 WireBytes = 0;
+		int64 DecodedBytes = 0;
+
+		/** Decode + validation time of every request, in milliseconds */
+		TArray<double> RequestMs;
+
+		/** Capture-to-receive delay of every event, in milliseconds (needs SetClockOrigin) */
+		TArray<double> LatenciesMs;
+
+		/** Sequence numbers skipped so far (lost or shed), and events received more than once */
+		int64 MissingEvents = 0;
+		int64 DuplicateEvents = 0;
+
+		/** Requests whose Idempotency-Key was already accepted - acknowledged without counting again */
+		int64 DuplicateBatches = 0;
+	};
+
+	/** What the collector keeps of each decoded event */
+	struct FDecodedEvent
+	{
+		float GameTime = 0.0f;
+		uint32 Sequence = 0;
+	};
+
+	explicit FTelemetryLocalCollector(uint32 InPort, const FString& InPath = TEXT("/telemetry"));
+	~FTelemetryLocalCollector();
+
+	/** Bind the route and start listening, false if the port is unavailable */
+	bool Start();
+	void Stop();
+
+	/** Endpoint to pass to UTelemetrySubsystem::Configure */
+	FString GetURL() const;
+
+	void SetFaults(const FFaultSettings& InFaults);
+
+	/**
+	 * Treat game_time as seconds since this FPlatformTime::Seconds() value, so latency can be
+	 * measured from events whose game_time was taken from the same clock
+	 */
+	void SetClockOrigin(double InClockOrigin) { ClockOrigin = InClockOrigin; }
+
+	const FStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FStats(); ReceivedSequences.Reset(); AcceptedKeys.Reset(); }
+
+	/** Drop the per-request and per-event samples but keep totals and sequence tracking - bounds memory on long runs */
+	void ResetSamples() { Stats.RequestMs.Reset(); Stats.LatenciesMs.Reset(); }
+
+	/** Value at Fraction (0-1) of an ascending array, 0 if empty */
+	static double GetPercentile(TConstArrayView<double> SortedValues, double Fraction);
+
+	/** Responses held back by injected latency */
+	int32 GetNumDelayedResponses() const { return DelayedResponses.Num(); }
+
+private:
+	bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/** Send delayed responses that are due */
+	bool TickDelayedResponses(float DeltaTime);
+
+	/** 200, or the injected 500 with Retry-After if configured */
+	TUniquePtr<FHttpServerResponse> MakeResponse(bool bError) const;
+
+	/**
+	 * Decode a body, validate every event and collect its game_time and sequence
+	 * @param OutSessionID - Session of the batch (a batch never spans sessions)
+	 * @return false with OutError set if the body or any event is malformed
+	 */
+	static bool DecodeEvents(const FString& ContentType, TConstArrayView<uint8> Body, TArray<FDecodedEvent>& OutEvents,
+		FString& OutSessionID, FString& OutError);
+
+	/** Track sequence numbers per session to count gaps and duplicates */
+	void AddSequences(const FString& SessionID, TConstArrayView<FDecodedEvent> Events);
+
+	const uint32 Port;
+	const FString Path;
+
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	FFaultSettings Faults;
+	FRandomStream FaultStream;
+
+	struct FDelayedResponse
+	{
+		double DueTime = 0.0;
+		bool bError = false;
+		FHttpResultCallback OnComplete;
+	};
+	TArray<FDelayedResponse> DelayedResponses;
+
+	double ClockOrigin = -1.0;
+	FStats Stats;
+
+	/** Sequences seen per session, one bit each, and the highest seen */
+	struct FSessionSequences
+	{
+		TBitArray<> Received;
+		uint32 Highest = 0;
+	};
+	TMap<FString, FSessionSequences> ReceivedSequences;
+
+	/** Idempotency keys of accepted batches */
+	TSet<FString> AcceptedKeys;
+};
+
+#endif // !UE_BUILD_SHIPPING
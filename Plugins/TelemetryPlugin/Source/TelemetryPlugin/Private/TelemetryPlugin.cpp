@@ -1,4 +1,5 @@
 #include "TelemetryPlugin.h"
+#include "TelemetryDispatcher.h"
 
 #define LOCTEXT_NAMESPACE "FTelemetryPluginModule"
 
@@ -9,9 +10,26 @@ void FTelemetryPluginModule::StartupModule()
 
 void FTelemetryPluginModule::ShutdownModule()
 {
+	if (Dispatcher)
+	{
+		Dispatcher->Shutdown();
+		Dispatcher.Reset();
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("[TelemetryPlugin] Module unloaded"));
 }
 
+TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe> FTelemetryPluginModule::GetDispatcher()
+{
+	check(IsInGameThread());
+
+	if (!Dispatcher)
+	{
+		Dispatcher = MakeShared<FTelemetryDispatcher, ESPMode::ThreadSafe>();
+	}
+	return Dispatcher.ToSharedRef();
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FTelemetryPluginModule, TelemetryPlugin)
@@ -27,11 +27,12 @@ UTelemetrySubsystem* UTelemetryBlueprintLibrary::GetTelemetrySubsystem(const UOb
 	return GameInstance->GetSubsystem<UTelemetrySubsystem>();
 }
 
-void UTelemetryBlueprintLibrary::ConfigureTelemetry(const UObject* WorldContextObject, const FString& ServerURL)
+void UTelemetryBlueprintLibrary::ConfigureTelemetry(const UObject* WorldContextObject, const FString& ServerURL,
+	ETelemetryWireFormat WireFormat)
 {
 	if (UTelemetrySubsystem* Telemetry = GetTelemetrySubsystem(WorldContextObject))
 	{
-		Telemetry->Configure(ServerURL);
+		Telemetry->Configure(ServerURL, WireFormat);
 	}
 }
 
@@ -67,11 +68,19 @@ void UTelemetryBlueprintLibrary::EndRun(const UObject* WorldContextObject, const
 	}
 }
 
-void UTelemetryBlueprintLibrary::LogPosition(const UObject* WorldContextObject, FVector Position, float GameTime)
+void UTelemetryBlueprintLibrary::IncrementRoomsCleared(const UObject* WorldContextObject)
 {
 	if (UTelemetrySubsystem* Telemetry = GetTelemetrySubsystem(WorldContextObject))
 	{
-		Telemetry->SendPositionUpdate(Position, GameTime);
+		Telemetry->IncrementRoomsCleared();
+	}
+}
+
+void UTelemetryBlueprintLibrary::LogPosition(const UObject* WorldContextObject, FVector Position, float GameTime, bool bIsAirborne)
+{
+	if (UTelemetrySubsystem* Telemetry = GetTelemetrySubsystem(WorldContextObject))
+	{
+		Telemetry->SendPositionUpdate(Position, GameTime, bIsAirborne);
 	}
 }
 
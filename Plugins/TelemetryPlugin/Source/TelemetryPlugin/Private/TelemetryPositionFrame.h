@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Positions of every tracked actor at one sample, as structure-of-arrays
+ * All arrays have one entry per actor, in the same order.
+ */
+struct FTelemetryPositionFrame
+{
+	TArray<FName> Actors;
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	int32 Num() const { return Actors.Num(); }
+
+	void Reserve(int32 Number)
+	{
+		Actors.Reserve(Number);
+		X.Reserve(Number);
+		Y.Reserve(Number);
+		Z.Reserve(Number);
+	}
+
+	void Reset()
+	{
+		Actors.Reset();
+		X.Reset();
+		Y.Reset();
+		Z.Reset();
+	}
+
+	void Add(FName Actor, const FVector& Position)
+	{
+		Actors.Add(Actor);
+		X.Add(static_cast<float>(Position.X));
+		Y.Add(static_cast<float>(Position.Y));
+		Z.Add(static_cast<float>(Position.Z));
+	}
+};
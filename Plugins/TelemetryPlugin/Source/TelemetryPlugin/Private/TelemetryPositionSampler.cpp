@@ -0,0 +1,102 @@
+#include "TelemetryPositionSampler.h"
+
+void FTelemetryPositionSampler::SetSettings(const FTelemetryAdaptiveSamplingSettings& InSettings)
+{
+	Settings = InSettings;
+	Reset();
+}
+
+void FTelemetryPositionSampler::Reset()
+{
+	NumSentSinceReset = 0;
+	SentVelocity = FVector::ZeroVector;
+}
+
+bool FTelemetryPositionSampler::ShouldSend(FVector& InOutPosition, float GameTime)
+{
+	const FVector Position = Quantize(InOutPosition);
+
+	// Velocity the player actually has right now, from the previous observed sample
+	const float ObservedDelta = GameTime - LastObservedTime;
+	const FVector ObservedVelocity = (NumSentSinceReset > 0 && ObservedDelta > UE_KINDA_SMALL_NUMBER)
+		? (Position - LastObservedPosition) / ObservedDelta
+		: FVector::ZeroVector;
+	LastObservedPosition = Position;
+	LastObservedTime = GameTime;
+
+	bool bSend = NumSentSinceReset == 0;
+
+	if (!bSend)
+	{
+		const float SinceSent = GameTime - LastSentTime;
+
+		// Keep-alive so the collector can tell idle from disconnected
+		bSend = Settings.KeepAliveInterval > 0.0f && SinceSent >= Settings.KeepAliveInterval;
+
+		// Prediction error
+		if (!bSend)
+		{
+			const FVector Predicted = LastSentPosition + SentVelocity * SinceSent;
+			bSend = FVector::DistSquared(Predicted, Position) > FMath::Square(Settings.ErrorTolerance);
+		}
+
+		// Direction changes and jumps, caught even before the error builds up
+		const float MinSpeedSq = FMath::Square(Settings.MinSpeed);
+		const bool bMoving = ObservedVelocity.SizeSquared() > MinSpeedSq;
+		const bool bWasMoving = SentVelocity.SizeSquared() > MinSpeedSq;
+
+		if (!bSend && bMoving != bWasMoving)
+		{
+			// Started or stopped
+			bSend = true;
+		}
+
+		if (!bSend && bMoving && bWasMoving)
+		{
+			const float CosAngle = FVector::DotProduct(ObservedVelocity.GetSafeNormal(), SentVelocity.GetSafeNormal());
+			bSend = CosAngle < FMath::Cos(FMath::DegreesToRadians(Settings.DirectionChangeDegrees));
+		}
+
+		if (!bSend)
+		{
+			// Jump start or apex: vertical motion flips sign
+			const bool bRising = ObservedVelocity.Z > Settings.MinSpeed;
+			const bool bFalling = ObservedVelocity.Z < -Settings.MinSpeed;
+			const bool bWasRising = SentVelocity.Z > Settings.MinSpeed;
+			const bool bWasFalling = SentVelocity.Z < -Settings.MinSpeed;
+			bSend = (bRising && !bWasRising) || (bFalling && !bWasFalling);
+		}
+	}
+
+	if (!bSend)
+	{
+		++NumSuppressed;
+		return false;
+	}
+
+	// Update the predictor exactly as the collector will see it
+	if (NumSentSinceReset > 0 && GameTime - LastSentTime > UE_KINDA_SMALL_NUMBER)
+	{
+		SentVelocity = (Position - LastSentPosition) / (GameTime - LastSentTime);
+	}
+	LastSentPosition = Position;
+	LastSentTime = GameTime;
+	++NumSentSinceReset;
+	++NumSent;
+
+	InOutPosition = Position;
+	return true;
+}
+
+FVector FTelemetryPositionSampler::Quantize(const FVector& Position) const
+{
+	if (Settings.QuantizationStep <= 0.0f)
+	{
+		return Position;
+	}
+
+	return FVector(
+		FMath::GridSnap(Position.X, static_cast<double>(Settings.QuantizationStep)),
+		FMath::GridSnap(Position.Y, static_cast<double>(Settings.QuantizationStep)),
+		FMath::GridSnap(Position.Z, static_cast<double>(Settings.QuantizationStep)));
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryTypes.h"
+
+/**
+ * Dead-reckoning filter for position samples
+ * Mirrors the predictor a collector can rebuild from the samples it receives
+ * (linear extrapolation from the last two sent samples) and only lets a sample through
+ * when that prediction would be wrong. Not thread-safe - callers serialize access.
+ */
+class FTelemetryPositionSampler
+{
+public:
+	void SetSettings(const FTelemetryAdaptiveSamplingSettings& InSettings);
+	const FTelemetryAdaptiveSamplingSettings& GetSettings() const { return Settings; }
+
+	/** Forget history so the next sample is always sent (new session or run) */
+	void Reset();
+
+	/**
+	 * Decide whether a sample should be sent
+	 * @param InOutPosition - Sample position, quantized in place when accepted
+	 * @param GameTime - Sample time in seconds
+	 * @return true if the sample must be sent
+	 */
+	bool ShouldSend(FVector& InOutPosition, float GameTime);
+
+	int32 GetNumSent() const { return NumSent; }
+	int32 GetNumSuppressed() const { return NumSuppressed; }
+
+private:
+	FVector Quantize(const FVector& Position) const;
+
+	FTelemetryAdaptiveSamplingSettings Settings;
+
+	/** Last two sent samples - the collector's view of the track */
+	FVector LastSentPosition = FVector::ZeroVector;
+	float LastSentTime = 0.0f;
+	FVector SentVelocity = FVector::ZeroVector;
+	int32 NumSentSinceReset = 0;
+
+	/** Previous observed sample, sent or not - used for the actual current velocity */
+	FVector LastObservedPosition = FVector::ZeroVector;
+	float LastObservedTime = 0.0f;
+
+	int32 NumSent = 0;
+	int32 NumSuppressed = 0;
+};
@@ -0,0 +1,281 @@
+#include "TelemetrySink.h"
+#include "TelemetryBinaryFormat.h"
+#include "TelemetryStringTable.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Serialization/Archive.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+#include "Common/UdpSocketBuilder.h"
+
+FTelemetryFileSink::FTelemetryFileSink(const FString& InDirectory, const FString& InBaseName, ETelemetryWireFormat InWireFormat,
+	int64 InMaxFileBytes, int32 InMaxFiles)
+	: Directory(InDirectory)
+	, BaseName(FPaths::MakeValidFileName(InBaseName, TEXT('_')))
+	, WireFormat(InWireFormat)
+	, MaxFileBytes(FMath::Max<int64>(InMaxFileBytes, WriteThreshold))
+	, MaxFiles(FMath::Max(1, InMaxFiles))
+{
+	IFileManager::Get().MakeDirectory(*Directory, true);
+}
+
+FTelemetryFileSink::~FTelemetryFileSink()
+{
+	Flush();
+}
+
+void FTelemetryFileSink::BeginSession(const FString& InMachineName, const FString& InSessionID,
+	const TSharedPtr<const FTelemetryStringTable, ESPMode::ThreadSafe>& InSessionStrings)
+{
+	MachineName = InMachineName;
+	SessionID = InSessionID;
+	SessionStrings = InSessionStrings;
+}
+
+void FTelemetryFileSink::Write(const FTelemetryEventRecord& Record, TConstArrayView<uint8> JsonEvent)
+{
+	if (WireFormat == ETelemetryWireFormat::Json)
+	{
+		Buffer.Append(JsonEvent);
+		Buffer.Add('\n');
+		if (Buffer.Num() >= WriteThreshold)
+		{
+			WriteBuffer();
+		}
+		return;
+	}
+
+	if (TelemetryBinaryFormat::GetRecordSize(Record.Type) != INDEX_NONE)
+	{
+		Records.Add(Record);
+	}
+}
+
+void FTelemetryFileSink::Flush()
+{
+	if (!Records.IsEmpty())
+	{
+		// Length-prefixed so readers can walk the file batch by batch
+		const int32 LengthOffset = Buffer.AddZeroed(sizeof(uint32));
+		TelemetryBinaryFormat::EncodeBatch(MachineName, SessionID, SessionStrings.Get(), Records, Buffer);
+		const uint32 BatchLength = static_cast<uint32>(Buffer.Num() - LengthOffset - sizeof(uint32));
+		FMemory::Memcpy(Buffer.GetData() + LengthOffset, &BatchLength, sizeof(BatchLength));
+		Records.Reset();
+	}
+
+	WriteBuffer();
+	if (File)
+	{
+		File->Flush();
+	}
+}
+
+void FTelemetryFileSink::WriteBuffer()
+{
+	if (Buffer.IsEmpty())
+	{
+		return;
+	}
+
+	if (!File || FileBytes >= MaxFileBytes)
+	{
+		OpenNextFile();
+		if (!File)
+		{
+			Buffer.Reset();
+			return;
+		}
+	}
+
+	File->Serialize(Buffer.GetData(), Buffer.Num());
+	FileBytes += Buffer.Num();
+	Buffer.Reset();
+}
+
+void FTelemetryFileSink::OpenNextFile()
+{
+	File.Reset();
+	FileBytes = 0;
+
+	const TCHAR* Extension = WireFormat == ETelemetryWireFormat::Json ? TEXT(".ndjson") : TEXT(".tlbin");
+	const FString Path = FPaths::Combine(Directory, FString::Printf(TEXT("%s_%s_%03d%s"),
+		*BaseName, *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), FileIndex++, Extension));
+
+	File.Reset(IFileManager::Get().CreateFileWriter(*Path));
+	if (!File)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Could not open sink file %s"), *Path);
+		return;
+	}
+
+	DeleteOldFiles();
+}
+
+void FTelemetryFileSink::DeleteOldFiles()
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, BaseName + TEXT("_*")), true, false);
+	if (Files.Num() <= MaxFiles)
+	{
+		return;
+	}
+
+	// Names embed the creation time, so they sort oldest first
+	Files.Sort();
+	for (int32 Index = 0; Index < Files.Num() - MaxFiles; ++Index)
+	{
+		IFileManager::Get().Delete(*FPaths::Combine(Directory, Files[Index]));
+	}
+}
+
+FTelemetryMemorySink::FTelemetryMemorySink(int32 InCapacity)
+	: Capacity(FMath::Max(1, InCapacity))
+{
+}
+
+void FTelemetryMemorySink::Write(const FTelemetryEventRecord& Record, TConstArrayView<uint8> JsonEvent)
+{
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const UTF8CHAR*>(JsonEvent.GetData()), JsonEvent.Num());
+
+	FScopeLock Lock(&EventsLock);
+	if (Events.Num() >= Capacity)
+	{
+		// Drop the older half at once so trimming stays cheap per event
+		Events.RemoveAt(0, FMath::Max(1, Capacity / 2), EAllowShrinking::No);
+	}
+	Events.Emplace(Converted.Length(), Converted.Get());
+}
+
+TArray<FString> FTelemetryMemorySink::GetEvents() const
+{
+	FScopeLock Lock(&EventsLock);
+	return Events;
+}
+
+void FTelemetryMemorySink::Reset()
+{
+	FScopeLock Lock(&EventsLock);
+	Events.Reset();
+}
+
+FTelemetryUdpSink::FTelemetryUdpSink(FSocket* InSocket, const TSharedRef<FInternetAddr>& InAddress, ETelemetryWireFormat InWireFormat)
+	: Socket(InSocket)
+	, Address(InAddress)
+	, WireFormat(InWireFormat)
+{
+	Datagram.Reserve(MaxDatagramBytes);
+}
+
+FTelemetryUdpSink::~FTelemetryUdpSink()
+{
+	Flush();
+
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+
+	if (DroppedCount > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] UDP sink dropped %lld events larger than a datagram"), DroppedCount);
+	}
+}
+
+TUniquePtr<FTelemetryUdpSink> FTelemetryUdpSink::Create(const FString& Address, ETelemetryWireFormat WireFormat)
+{
+	FString Host;
+	FString Port;
+	if (!Address.Split(TEXT(":"), &Host, &Port, ESearchCase::IgnoreCase, ESearchDir::FromEnd) || !Port.IsNumeric())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] UDP sink address '%s' is not host:port"), *Address);
+		return nullptr;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	const FAddressInfoResult Resolved = SocketSubsystem->GetAddressInfo(*Host, *Port,
+		EAddressInfoFlags::Default, NAME_None, ESocketType::SOCKTYPE_Datagram);
+	if (Resolved.ReturnCode != SE_NO_ERROR || Resolved.Results.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Could not resolve UDP sink address %s"), *Address);
+		return nullptr;
+	}
+
+	const TSharedRef<FInternetAddr> Target = Resolved.Results[0].Address;
+	FSocket* Socket = FUdpSocketBuilder(TEXT("TelemetryUdpSink"))
+		.AsNonBlocking()
+		.WithSendBufferSize(64 * 1024)
+		.Build();
+	if (!Socket)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Could not create UDP sink socket"));
+		return nullptr;
+	}
+
+	return MakeUnique<FTelemetryUdpSink>(Socket, Target, WireFormat);
+}
+
+void FTelemetryUdpSink::BeginSession(const FString& InMachineName, const FString& InSessionID,
+	const TSharedPtr<const FTelemetryStringTable, ESPMode::ThreadSafe>& InSessionStrings)
+{
+	MachineName = InMachineName;
+	SessionID = InSessionID;
+	SessionStrings = InSessionStrings;
+}
+
+void FTelemetryUdpSink::Write(const FTelemetryEventRecord& Record, TConstArrayView<uint8> JsonEvent)
+{
+	if (WireFormat != ETelemetryWireFormat::Json)
+	{
+		if (TelemetryBinaryFormat::GetRecordSize(Record.Type) != INDEX_NONE)
+		{
+			Records.Add(Record);
+			if (Records.Num() >= RecordsPerDatagram)
+			{
+				Flush();
+			}
+		}
+		return;
+	}
+
+	if (JsonEvent.Num() + 1 > MaxUdpPayload)
+	{
+		++DroppedCount;
+		return;
+	}
+
+	if (!Datagram.IsEmpty() && Datagram.Num() + JsonEvent.Num() + 1 > MaxDatagramBytes)
+	{
+		SendDatagram(Datagram);
+		Datagram.Reset();
+	}
+
+	Datagram.Append(JsonEvent);
+	Datagram.Add('\n');
+}
+
+void FTelemetryUdpSink::Flush()
+{
+	if (!Records.IsEmpty())
+	{
+		Datagram.Reset();
+		TelemetryBinaryFormat::EncodeBatch(MachineName, SessionID, SessionStrings.Get(), Records, Datagram);
+		Records.Reset();
+	}
+
+	if (!Datagram.IsEmpty())
+	{
+		SendDatagram(Datagram);
+		Datagram.Reset();
+	}
+}
+
+void FTelemetryUdpSink::SendDatagram(TConstArrayView<uint8> Data)
+{
+	// A full send buffer just loses the datagram - that is the contract of this sink
+	int32 BytesSent = 0;
+	Socket->SendTo(Data.GetData(), Data.Num(), BytesSent, *Address);
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryTypes.h"
+#include "TelemetryEventRecord.h"
+
+class FArchive;
+class FSocket;
+class FInternetAddr;
+class FTelemetryStringTable;
+
+/**
+ * Destination for events next to (or instead of) the HTTP upload path
+ * The worker hands every event that passes the sink's filter to Write as soon as it is
+ * batched - before HTTP backpressure can hold it back or shed it. All calls come from the
+ * worker thread, so sinks need no locking of their own unless they are read from elsewhere.
+ */
+class ITelemetrySink
+{
+public:
+	virtual ~ITelemetrySink() = default;
+
+	/** JSON sinks get each event pre-serialized, binary sinks only the record */
+	virtual ETelemetryWireFormat GetWireFormat() const = 0;
+
+	/**
+	 * A new session starts - called after the previous one was flushed
+	 * @param InSessionStrings - Table the session's records' StringIndex refers to, null before the first session
+	 */
+	virtual void BeginSession(const FString& InMachineName, const FString& InSessionID,
+		const TSharedPtr<const FTelemetryStringTable, ESPMode::ThreadSafe>& InSessionStrings) {}
+
+	/**
+	 * Take one event
+	 * @param JsonEvent - The event as one JSON object (no trailing newline), empty for binary sinks
+	 */
+	virtual void Write(const FTelemetryEventRecord& Record, TConstArrayView<uint8> JsonEvent) = 0;
+
+	/** Push out anything buffered (timed flush, Flush(), session change, shutdown) */
+	virtual void Flush() = 0;
+};
+
+/** A sink and the event types it receives */
+struct FTelemetrySinkEntry
+{
+	TSharedPtr<ITelemetrySink, ESPMode::ThreadSafe> Sink;
+
+	/** Bit per ETelemetryEventType - 0 turns the destination off entirely */
+	uint32 TypeMask = MAX_uint32;
+
+	/** Lifecycle events pass any mask except 0 */
+	static bool Accepts(uint32 Mask, ETelemetryEventType Type)
+	{
+		return Mask != 0 && (IsLifecycleEvent(Type) || (Mask & (1u << static_cast<uint8>(Type))) != 0);
+	}
+
+	bool Accepts(ETelemetryEventType Type) const { return Accepts(TypeMask, Type); }
+};
+
+/**
+ * Rotating local file sink
+ * JSON: one event per line (NDJSON). Binary: consecutive TelemetryBinaryFormat batches, each
+ * preceded by its uint32 byte length. Held-payload events (position frames, summaries, heatmaps,
+ * spans) only reach JSON files. A new file is started once MaxFileBytes is exceeded and the
+ * oldest of this sink's files are deleted beyond MaxFiles.
+ */
+class FTelemetryFileSink : public ITelemetrySink
+{
+public:
+	FTelemetryFileSink(const FString& InDirectory, const FString& InBaseName, ETelemetryWireFormat InWireFormat,
+		int64 InMaxFileBytes, int32 InMaxFiles);
+	virtual ~FTelemetryFileSink() override;
+
+	virtual ETelemetryWireFormat GetWireFormat() const override { return WireFormat; }
+	virtual void BeginSession(const FString& InMachineName, const FString& InSessionID,
+		const TSharedPtr<const FTelemetryStringTable, ESPMode::ThreadSafe>& InSessionStrings) override;
+	virtual void Write(const FTelemetryEventRecord& Record, TConstArrayView<uint8> JsonEvent) override;
+	virtual void Flush() override;
+
+private:
+	/** Move the buffer into the current file, starting a new one when it is full */
+	void WriteBuffer();
+	void OpenNextFile();
+	void DeleteOldFiles();
+
+	const FString Directory;
+	const FString BaseName;
+	const ETelemetryWireFormat WireFormat;
+	const int64 MaxFileBytes;
+	const int32 MaxFiles;
+
+	FString MachineName;
+	FString SessionID;
+	TSharedPtr<const FTelemetryStringTable, ESPMode::ThreadSafe> SessionStrings;
+
+	TUniquePtr<FArchive> File;
+	int64 FileBytes = 0;
+	int32 FileIndex = 0;
+
+	/** Encoded bytes not yet in the file */
+	TArray<uint8> Buffer;
+
+	/** Binary events of the batch being built */
+	TArray<FTelemetryEventRecord> Records;
+
+	/** Buffer is written once it grows past this */
+	static constexpr int32 WriteThreshold = 64 * 1024;
+};
+
+/**
+ * Keeps the most recent events as JSON strings in memory - for automated tests
+ * Read from any thread with GetEvents.
+ */
+class FTelemetryMemorySink : public ITelemetrySink
+{
+public:
+	explicit FTelemetryMemorySink(int32 InCapacity);
+
+	virtual ETelemetryWireFormat GetWireFormat() const override { return ETelemetryWireFormat::Json; }
+	virtual void Write(const FTelemetryEventRecord& Record, TConstArrayView<uint8> JsonEvent) override;
+	virtual void Flush() override {}
+
+	/** Copy of the captured events, oldest first - safe to call from any thread */
+	TArray<FString> GetEvents() const;
+
+	/** Forget everything captured so far - safe to call from any thread */
+	void Reset();
+
+private:
+	const int32 Capacity;
+	TArray<FString> Events;
+	mutable FCriticalSection EventsLock;
+};
+
+/**
+ * Fire-and-forget UDP sink - no acknowledgement, no retry, no spool
+ * JSON: NDJSON lines packed into datagrams of up to MaxDatagramBytes (a larger event goes alone).
+ * Binary: one TelemetryBinaryFormat batch of up to RecordsPerDatagram events per datagram.
+ */
+class FTelemetryUdpSink : public ITelemetrySink
+{
+public:
+	FTelemetryUdpSink(FSocket* InSocket, const TSharedRef<FInternetAddr>& InAddress, ETelemetryWireFormat InWireFormat);
+	virtual ~FTelemetryUdpSink() override;
+
+	virtual ETelemetryWireFormat GetWireFormat() const override { return WireFormat; }
+	virtual void BeginSession(const FString& InMachineName, const FString& InSessionID,
+		const TSharedPtr<const FTelemetryStringTable, ESPMode::ThreadSafe>& InSessionStrings) override;
+	virtual void Write(const FTelemetryEventRecord& Record, TConstArrayView<uint8> JsonEvent) override;
+	virtual void Flush() override;
+
+	/**
+	 * Resolve "host:port" and open a socket
+	 * @return nullptr if the address cannot be resolved or the socket cannot be created
+	 */
+	static TUniquePtr<FTelemetryUdpSink> Create(const FString& Address, ETelemetryWireFormat WireFormat);
+
+private:
+	void SendDatagram(TConstArrayView<uint8> Data);
+
+	FSocket* Socket = nullptr;
+	TSharedRef<FInternetAddr> Address;
+	const ETelemetryWireFormat WireFormat;
+
+	FString MachineName;
+	FString SessionID;
+	TSharedPtr<const FTelemetryStringTable, ESPMode::ThreadSafe> SessionStrings;
+
+	TArray<uint8> Datagram;
+	TArray<FTelemetryEventRecord> Records;
+	int64 DroppedCount = 0;
+
+	/** Stays below a typical path MTU so datagrams are not fragmented */
+	static constexpr int32 MaxDatagramBytes = 1200;
+	static constexpr int32 RecordsPerDatagram = 20;
+
+	/** Largest UDP payload over IPv4 */
+	static constexpr int32 MaxUdpPayload = 65507;
+};
@@ -0,0 +1,567 @@
+#include "TelemetrySoakSubsystem.h"
+
+// Soak runs are development tooling built around the local collector, which shipping builds leave out
+#if UE_BUILD_SHIPPING
+
+bool UTelemetrySoakSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return false;
+}
+
+void UTelemetrySoakSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+}
+
+void UTelemetrySoakSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+}
+
+#else
+
+#include "TelemetrySubsystem.h"
+#include "TelemetryLocalCollector.h"
+#include "TelemetryDispatcher.h"
+#include "Engine/GameInstance.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerStart.h"
+#include "Kismet/GameplayStatics.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** Give up waiting for the last uploads after this long */
+	constexpr double DrainTimeoutSeconds = 15.0;
+
+	/** Least-squares slope of used memory over time, in MB per hour (0 with fewer than 3 samples) */
+	template <typename SampleType>
+	double GetMemorySlope(TConstArrayView<SampleType> Samples)
+	{
+		if (Samples.Num() < 3)
+		{
+			return 0.0;
+		}
+
+		double MeanHours = 0.0;
+		double MeanMB = 0.0;
+		for (const SampleType& Sample : Samples)
+		{
+			MeanHours += Sample.Hours;
+			MeanMB += Sample.UsedPhysicalMB;
+		}
+		MeanHours /= Samples.Num();
+		MeanMB /= Samples.Num();
+
+		double Covariance = 0.0;
+		double Variance = 0.0;
+		for (const SampleType& Sample : Samples)
+		{
+			Covariance += (Sample.Hours - MeanHours) * (Sample.UsedPhysicalMB - MeanMB);
+			Variance += FMath::Square(Sample.Hours - MeanHours);
+		}
+		return Variance > 0.0 ? Covariance / Variance : 0.0;
+	}
+}
+
+bool UTelemetrySoakSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("TelemetrySoak")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UTelemetrySoakSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<UTelemetrySubsystem>();
+
+	const TCHAR* Cmd = FCommandLine::Get();
+	FParse::Value(Cmd, TEXT("SoakAgents="), NumAgents);
+	FParse::Value(Cmd, TEXT("SoakHours="), DurationHours);
+	FParse::Value(Cmd, TEXT("SoakRunSeconds="), RunSeconds);
+	FParse::Value(Cmd, TEXT("SoakWarmupRuns="), WarmupRuns);
+	FParse::Value(Cmd, TEXT("SoakPort="), CollectorPort);
+	FParse::Value(Cmd, TEXT("SoakOutput="), OutputPath);
+	NumAgents = FMath::Max(0, NumAgents);
+	RunSeconds = FMath::Max(1.0f, RunSeconds);
+	WarmupRuns = FMath::Max(0, WarmupRuns);
+
+	LoadedAgentClass = AgentClass.LoadSynchronous();
+	if (!LoadedAgentClass && NumAgents > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Soak agent class not found: %s"), *AgentClass.ToString());
+	}
+
+	// -TelemetryURL already redirects every Configure call, so the local collector would see nothing
+	FString OverrideURL;
+	if (!FParse::Value(Cmd, TEXT("TelemetryURL="), OverrideURL) || OverrideURL.IsEmpty())
+	{
+		Collector = MakeShared<FTelemetryLocalCollector>(static_cast<uint32>(CollectorPort));
+		if (!Collector->Start())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Telemetry] Soak could not start the local collector on port %d"), CollectorPort);
+			Collector.Reset();
+		}
+	}
+
+	FramePerformanceCollector = MakeShared<FTelemetryFramePerformanceCollector>();
+
+	WorldInitializedActorsHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &UTelemetrySoakSubsystem::OnWorldInitializedActors);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UTelemetrySoakSubsystem::Tick));
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Soak: %d agents, %d warmup runs then %.2f hours of %.0fs runs"),
+		NumAgents, WarmupRuns, DurationHours, RunSeconds);
+}
+
+void UTelemetrySoakSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldInitializedActors.Remove(WorldInitializedActorsHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	if (Phase != EPhase::Done)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Soak interrupted after %d runs - no report written"), Runs);
+	}
+
+	FramePerformanceCollector.Reset();
+	if (Collector)
+	{
+		Collector->Stop();
+		Collector.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+UTelemetrySubsystem* UTelemetrySoakSubsystem::GetTelemetry() const
+{
+	return GetGameInstance()->GetSubsystem<UTelemetrySubsystem>();
+}
+
+void UTelemetrySoakSubsystem::OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params)
+{
+	UWorld* World = Params.World;
+	if (!World || !World->IsGameWorld() || World->GetGameInstance() != GetGameInstance()
+		|| Phase == EPhase::Draining || Phase == EPhase::Done)
+	{
+		return;
+	}
+
+	if (!Map.IsNull() && World->GetOutermost()->GetName() != Map.GetLongPackageName())
+	{
+		UE_LOG(LogTemp, Display, TEXT("[Telemetry] Soak opening %s"), *Map.GetLongPackageName());
+		UGameplayStatics::OpenLevelBySoftObjectPtr(World, Map);
+		return;
+	}
+
+	SoakWorld = World;
+	if (Phase == EPhase::WaitingForMap)
+	{
+		BeginSoak();
+	}
+	else
+	{
+		// The game reloaded the level mid-run (e.g. after the player died) and took the agents with it
+		SpawnAgents();
+	}
+}
+
+bool UTelemetrySoakSubsystem::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (Phase == EPhase::Running && Now >= RunEndTime)
+	{
+		EndSoakRun();
+		if (bMeasuring && Now >= EndTime)
+		{
+			BeginDrain();
+		}
+		else
+		{
+			StartSoakRun();
+		}
+	}
+	else if (Phase == EPhase::Draining)
+	{
+		const UTelemetrySubsystem* Telemetry = GetTelemetry();
+		const bool bDrained = Telemetry->GetPendingEventCount() == 0 && FTelemetryDispatcher::Get()->GetInFlightRequests() == 0;
+		if (bDrained || Now >= DrainEndTime)
+		{
+			Finish();
+		}
+	}
+	return true;
+}
+
+void UTelemetrySoakSubsystem::BeginSoak()
+{
+	UTelemetrySubsystem* Telemetry = GetTelemetry();
+	if (Collector)
+	{
+		// Before StartNewSession, so the game's own spooled batches are not replayed to the local collector
+		Telemetry->ConfigureSpool(false, 1);
+		Telemetry->Configure(Collector->GetURL());
+	}
+	else
+	{
+		// Redirected to -TelemetryURL
+		Telemetry->Configure(FString());
+	}
+	if (!Telemetry->IsSessionActive())
+	{
+		Telemetry->StartNewSession();
+	}
+
+	Phase = EPhase::Running;
+	if (WarmupRuns == 0)
+	{
+		BeginMeasuring();
+	}
+	StartSoakRun();
+}
+
+void UTelemetrySoakSubsystem::StartSoakRun()
+{
+	SpawnAgents();
+	GetTelemetry()->StartRun();
+
+	const double Now = FPlatformTime::Seconds();
+	RunEndTime = bMeasuring ? FMath::Min(Now + RunSeconds, EndTime) : Now + RunSeconds;
+}
+
+void UTelemetrySoakSubsystem::EndSoakRun()
+{
+	UTelemetrySubsystem* Telemetry = GetTelemetry();
+	Telemetry->EndRun(TEXT("soak"));
+
+	// Whatever the run left referenced survives this collection - one hitch per run, counted like any other frame
+	TArray<TWeakObjectPtr<APawn>> RunAgents = MoveTemp(Agents);
+	DestroyAgents(RunAgents);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	int32 NumLeaked = 0;
+	for (const TWeakObjectPtr<APawn>& Agent : RunAgents)
+	{
+		// Even garbage-flagged, an agent still here after a full purge is referenced from somewhere
+		if (Agent.IsValid(true))
+		{
+			++NumLeaked;
+		}
+	}
+	LeakedAgents += NumLeaked;
+	++Runs;
+
+	TakeCollectorSamples();
+	if (bMeasuring)
+	{
+		Samples.Add(TakeSample());
+	}
+	else if (Runs >= WarmupRuns)
+	{
+		BeginMeasuring();
+	}
+
+	const FSample Last = Samples.IsEmpty() ? TakeSample() : Samples.Last();
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Soak run %d: %.1f MB used, %d objects, %d trackers, %d pending events, %d agents leaked"),
+		Runs, Last.UsedPhysicalMB, Last.Objects, Last.Trackers, Last.PendingEvents, NumLeaked);
+}
+
+void UTelemetrySoakSubsystem::BeginMeasuring()
+{
+	bMeasuring = true;
+	MeasureStartTime = FPlatformTime::Seconds();
+	EndTime = MeasureStartTime + DurationHours * 3600.0;
+
+	Samples.Add(TakeSample());
+	LatencyMs = FTelemetryFrameHistogram();
+	if (Collector)
+	{
+		const FTelemetryLocalCollector::FStats& Stats = Collector->GetStats();
+		EventsAtMeasureStart = Stats.Events;
+		WireBytesAtMeasureStart = Stats.WireBytes;
+		RequestsAtMeasureStart = Stats.Requests;
+	}
+	FramePerformanceCollector->Start(FramePerformance);
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Soak measuring from run %d, baseline %.1f MB used, %d objects"),
+		Runs + 1, Samples[0].UsedPhysicalMB, Samples[0].Objects);
+}
+
+void UTelemetrySoakSubsystem::BeginDrain()
+{
+	Phase = EPhase::Draining;
+	DrainEndTime = FPlatformTime::Seconds() + DrainTimeoutSeconds;
+	GetTelemetry()->EndSession();
+}
+
+void UTelemetrySoakSubsystem::SpawnAgents()
+{
+	UWorld* World = SoakWorld.Get();
+	if (!World || !LoadedAgentClass)
+	{
+		return;
+	}
+
+	FVector Origin = FVector::ZeroVector;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origin = It->GetActorLocation();
+		break;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (int32 Index = 0; Index < NumAgents; ++Index)
+	{
+		const FVector Location = Origin + FVector((Index - NumAgents / 2) * AgentSpacing, 0.0, 0.0);
+		APawn* Agent = World->SpawnActor<APawn>(LoadedAgentClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Agent)
+		{
+			continue;
+		}
+
+		// The NPC's StateTree runs once its AI controller possesses it
+		if (!Agent->GetController())
+		{
+			Agent->SpawnDefaultController();
+		}
+		Agents.Add(Agent);
+	}
+}
+
+void UTelemetrySoakSubsystem::DestroyAgents(TConstArrayView<TWeakObjectPtr<APawn>> RunAgents)
+{
+	for (const TWeakObjectPtr<APawn>& Agent : RunAgents)
+	{
+		if (APawn* Pawn = Agent.Get())
+		{
+			if (AController* Controller = Pawn->GetController())
+			{
+				Controller->Destroy();
+			}
+			Pawn->Destroy();
+		}
+	}
+}
+
+UTelemetrySoakSubsystem::FSample UTelemetrySoakSubsystem::TakeSample() const
+{
+	const UTelemetrySubsystem* Telemetry = GetTelemetry();
+
+	FSample Sample;
+	Sample.Hours = bMeasuring ? (FPlatformTime::Seconds() - MeasureStartTime) / 3600.0 : 0.0;
+	Sample.UsedPhysicalMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+	Sample.Objects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Sample.PendingEvents = Telemetry->GetPendingEventCount();
+	Sample.Trackers = Telemetry->GetNumTrackers();
+	return Sample;
+}
+
+void UTelemetrySoakSubsystem::TakeCollectorSamples()
+{
+	if (!Collector)
+	{
+		return;
+	}
+
+	if (bMeasuring)
+	{
+		for (const double Latency : Collector->GetStats().LatenciesMs)
+		{
+			LatencyMs.Add(Latency);
+		}
+	}
+	Collector->ResetSamples();
+}
+
+void UTelemetrySoakSubsystem::Finish()
+{
+	Phase = EPhase::Done;
+	TakeCollectorSamples();
+
+	const UTelemetrySubsystem* Telemetry = GetTelemetry();
+	const FTelemetryFramePerformance Frames = FramePerformanceCollector->Stop();
+	const FTelemetryBackpressureStats Backpressure = Telemetry->GetBackpressureStats();
+	const FSample& Baseline = Samples[0];
+	const FSample& Last = Samples.Last();
+
+	const double MeasuredSeconds = FMath::Max(1.0, FPlatformTime::Seconds() - MeasureStartTime);
+	const double MemorySlope = GetMemorySlope<FSample>(Samples);
+	const int32 ObjectGrowth = Last.Objects - Baseline.Objects;
+	const int32 LeakedTrackers = FMath::Max(0, Last.Trackers - Baseline.Trackers);
+
+	// Shed and dropped events leave sequence gaps too - only the rest is unexplained
+	int64 EventsDelivered = 0;
+	int64 EventsLost = 0;
+	int64 SequenceGaps = 0;
+	if (Collector)
+	{
+		const FTelemetryLocalCollector::FStats& Stats = Collector->GetStats();
+		EventsDelivered = Stats.Events;
+		SequenceGaps = Stats.MissingEvents;
+		EventsLost = FMath::Max<int64>(0, SequenceGaps - Backpressure.ShedEvents - Backpressure.DroppedEvents);
+	}
+	const double LostRatio = EventsDelivered > 0 ? static_cast<double>(EventsLost) / (EventsDelivered + EventsLost) : 0.0;
+
+	TArray<FString> Failures;
+	const double FrameP99 = Frames.FrameTime.GetPercentile(99.0);
+	if (MaxFrameTimeP99Ms > 0.0f && FrameP99 > MaxFrameTimeP99Ms)
+	{
+		Failures.Add(FString::Printf(TEXT("frame time p99 %.1f ms > %.1f ms"), FrameP99, MaxFrameTimeP99Ms));
+	}
+	if (MaxMemoryGrowthMBPerHour > 0.0f && MemorySlope > MaxMemoryGrowthMBPerHour)
+	{
+		Failures.Add(FString::Printf(TEXT("memory growth %.1f MB/h > %.1f MB/h"), MemorySlope, MaxMemoryGrowthMBPerHour));
+	}
+	if (MaxObjectGrowth > 0 && ObjectGrowth > MaxObjectGrowth)
+	{
+		Failures.Add(FString::Printf(TEXT("%d more UObjects than after warmup > %d"), ObjectGrowth, MaxObjectGrowth));
+	}
+	if (LeakedAgents > 0)
+	{
+		Failures.Add(FString::Printf(TEXT("%d agents survived garbage collection"), LeakedAgents));
+	}
+	if (LeakedTrackers > 0)
+	{
+		Failures.Add(FString::Printf(TEXT("%d trackers left registered"), LeakedTrackers));
+	}
+	if (Collector && EventsDelivered == 0)
+	{
+		Failures.Add(TEXT("no events reached the local collector"));
+	}
+	if (LostRatio > MaxLostEventRatio)
+	{
+		Failures.Add(FString::Printf(TEXT("%.4f of events lost > %.4f"), LostRatio, MaxLostEventRatio));
+	}
+
+	// Report
+	TSharedRef<FJsonObject> Scenario = MakeShared<FJsonObject>();
+	Scenario->SetStringField(TEXT("map"), Map.GetLongPackageName());
+	Scenario->SetStringField(TEXT("agent_class"), AgentClass.ToString());
+	Scenario->SetNumberField(TEXT("agents"), NumAgents);
+	Scenario->SetNumberField(TEXT("duration_h"), DurationHours);
+	Scenario->SetNumberField(TEXT("run_s"), RunSeconds);
+	Scenario->SetNumberField(TEXT("warmup_runs"), WarmupRuns);
+
+	TSharedRef<FJsonObject> FrameTime = MakeShared<FJsonObject>();
+	FrameTime->SetNumberField(TEXT("frames"), Frames.FrameTime.Count);
+	FrameTime->SetNumberField(TEXT("mean"), Frames.FrameTime.Count > 0 ? Frames.FrameTime.SumMs / Frames.FrameTime.Count : 0.0);
+	FrameTime->SetNumberField(TEXT("p50"), Frames.FrameTime.GetPercentile(50.0));
+	FrameTime->SetNumberField(TEXT("p95"), Frames.FrameTime.GetPercentile(95.0));
+	FrameTime->SetNumberField(TEXT("p99"), FrameP99);
+	FrameTime->SetNumberField(TEXT("max"), Frames.FrameTime.MaxMs);
+	TArray<TSharedPtr<FJsonValue>> Hitches;
+	for (int32 Index = 0; Index < Frames.HitchThresholdsMs.Num(); ++Index)
+	{
+		TSharedRef<FJsonObject> Hitch = MakeShared<FJsonObject>();
+		Hitch->SetNumberField(TEXT("threshold_ms"), Frames.HitchThresholdsMs[Index]);
+		Hitch->SetNumberField(TEXT("count"), Frames.HitchCounts[Index]);
+		Hitches.Add(MakeShared<FJsonValueObject>(Hitch));
+	}
+	FrameTime->SetArrayField(TEXT("hitches"), Hitches);
+
+	TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+	Memory->SetNumberField(TEXT("baseline_used_mb"), Baseline.UsedPhysicalMB);
+	Memory->SetNumberField(TEXT("final_used_mb"), Last.UsedPhysicalMB);
+	Memory->SetNumberField(TEXT("peak_used_mb"), Frames.PeakUsedPhysical / (1024.0 * 1024.0));
+	Memory->SetNumberField(TEXT("growth_mb_per_hour"), MemorySlope);
+	Memory->SetNumberField(TEXT("baseline_objects"), Baseline.Objects);
+	Memory->SetNumberField(TEXT("final_objects"), Last.Objects);
+
+	TSharedRef<FJsonObject> Throughput = MakeShared<FJsonObject>();
+	if (Collector)
+	{
+		const FTelemetryLocalCollector::FStats& Stats = Collector->GetStats();
+		Throughput->SetNumberField(TEXT("events_per_s"), (Stats.Events - EventsAtMeasureStart) / MeasuredSeconds);
+		Throughput->SetNumberField(TEXT("wire_bytes_per_s"), (Stats.WireBytes - WireBytesAtMeasureStart) / MeasuredSeconds);
+		Throughput->SetNumberField(TEXT("requests_per_s"), (Stats.Requests - RequestsAtMeasureStart) / MeasuredSeconds);
+		Throughput->SetNumberField(TEXT("rejected_requests"), Stats.RejectedRequests);
+		Throughput->SetNumberField(TEXT("duplicate_events"), Stats.DuplicateEvents);
+		Throughput->SetNumberField(TEXT("latency_ms_p50"), LatencyMs.GetPercentile(50.0));
+		Throughput->SetNumberField(TEXT("latency_ms_p99"), LatencyMs.GetPercentile(99.0));
+	}
+	Throughput->SetNumberField(TEXT("events_delivered"), EventsDelivered);
+	Throughput->SetNumberField(TEXT("events_shed"), Backpressure.ShedEvents);
+	Throughput->SetNumberField(TEXT("events_dropped"), Backpressure.DroppedEvents);
+	Throughput->SetNumberField(TEXT("sequence_gaps"), SequenceGaps);
+	Throughput->SetNumberField(TEXT("events_lost"), EventsLost);
+	Throughput->SetNumberField(TEXT("uploads_retried"), Backpressure.RetriedUploads);
+	Throughput->SetNumberField(TEXT("uploads_failed"), Backpressure.FailedUploads);
+
+	TSharedRef<FJsonObject> Leaks = MakeShared<FJsonObject>();
+	Leaks->SetNumberField(TEXT("agents"), LeakedAgents);
+	Leaks->SetNumberField(TEXT("trackers"), LeakedTrackers);
+	Leaks->SetNumberField(TEXT("object_growth"), ObjectGrowth);
+	Leaks->SetNumberField(TEXT("pending_events"), Last.PendingEvents);
+
+	TArray<TSharedPtr<FJsonValue>> RunSamples;
+	for (const FSample& Sample : Samples)
+	{
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("hours"), Sample.Hours);
+		Entry->SetNumberField(TEXT("used_mb"), Sample.UsedPhysicalMB);
+		Entry->SetNumberField(TEXT("objects"), Sample.Objects);
+		Entry->SetNumberField(TEXT("trackers"), Sample.Trackers);
+		Entry->SetNumberField(TEXT("pending_events"), Sample.PendingEvents);
+		RunSamples.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> FailureValues;
+	for (const FString& Failure : Failures)
+	{
+		FailureValues.Add(MakeShared<FJsonValueString>(Failure));
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("soak"), TEXT("telemetry"));
+	Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Report->SetStringField(TEXT("machine_id"), FPlatformProcess::ComputerName());
+	Report->SetObjectField(TEXT("scenario"), Scenario);
+	Report->SetNumberField(TEXT("runs"), Runs);
+	Report->SetNumberField(TEXT("measured_h"), MeasuredSeconds / 3600.0);
+	Report->SetObjectField(TEXT("frame_time_ms"), FrameTime);
+	Report->SetObjectField(TEXT("memory"), Memory);
+	Report->SetObjectField(TEXT("telemetry"), Throughput);
+	Report->SetObjectField(TEXT("leaks"), Leaks);
+	Report->SetArrayField(TEXT("samples"), RunSamples);
+	Report->SetArrayField(TEXT("failures"), FailureValues);
+	Report->SetBoolField(TEXT("passed"), Failures.IsEmpty());
+
+	FString ReportString;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportString));
+
+	if (OutputPath.IsEmpty())
+	{
+		OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("Soak"),
+			FString::Printf(TEXT("TelemetrySoak_%s.json"), *FDateTime::Now().ToString()));
+	}
+	if (!FFileHelper::SaveStringToFile(ReportString, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Could not write soak report to %s"), *OutputPath);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Soak: %d runs, frame p50 %.1f ms p99 %.1f ms, memory %+.1f MB/h, %+d objects, %lld events delivered, %lld lost"),
+		Runs, Frames.FrameTime.GetPercentile(50.0), FrameP99, MemorySlope, ObjectGrowth, EventsDelivered, EventsLost);
+	for (const FString& Failure : Failures)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Soak failed: %s"), *Failure);
+	}
+	UE_LOG(LogTemp, Display, TEXT("[Telemetry] Soak report written to %s"), *OutputPath);
+
+	FPlatformMisc::RequestExitWithStatus(false, Failures.IsEmpty() ? 0 : 1);
+}
+
+#endif // UE_BUILD_SHIPPING
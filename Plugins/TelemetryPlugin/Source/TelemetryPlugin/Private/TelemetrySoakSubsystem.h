@@ -0,0 +1,175 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "TelemetryFramePerformance.h"
+#include "TelemetrySoakSubsystem.generated.h"
+
+class FTelemetryLocalCollector;
+class FTelemetryFramePerformanceCollector;
+class UTelemetrySubsystem;
+class APawn;
+
+/**
+ * Unattended soak test of the game and the telemetry pipeline
+ * Only created with -TelemetrySoak, and never in shipping builds. Once Map is loaded it spawns
+ * NumAgents of AgentClass (the side-scroller NPC, driven by its own StateTree) and cycles
+ * StartRun/EndRun through UTelemetrySubsystem every RunSeconds for DurationHours. Agents are destroyed and respawned
+ * between runs, followed by a full garbage collection, so anything a run leaves behind
+ * accumulates. Events go to an in-process local collector unless -TelemetryURL is given.
+ * At the end a JSON report is written (frame time percentiles and hitches, memory and UObject
+ * growth, telemetry throughput and loss, leaked agents and trackers) and the game exits with
+ * code 1 if any threshold was exceeded, 0 otherwise.
+ *
+ * USAGE:
+ * UnrealEditor-Cmd <Project> /Game/Variant_SideScroller/Lvl_SideScrolling -game -nullrhi -unattended
+ *     -TelemetrySoak [-SoakAgents=32] [-SoakHours=4] [-SoakRunSeconds=120] [-SoakWarmupRuns=1]
+ *     [-SoakPort=18081] [-SoakOutput=<path>] [-TelemetryURL=<collector>]
+ * Without the map on the command line, the default map is loaded first and Map opened from it.
+ * Defaults and thresholds are set in DefaultGame.ini under [/Script/TelemetryPlugin.TelemetrySoakSubsystem]
+ */
+UCLASS(Config=Game)
+class UTelemetrySoakSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Level the soak runs in - opened if another map is loaded */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak")
+	TSoftObjectPtr<UWorld> Map;
+
+	/** Agent spawned NumAgents times per run, possessed by its default AI controller */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak")
+	TSoftClassPtr<APawn> AgentClass;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak", meta=(ClampMin="0"))
+	int32 NumAgents = 32;
+
+	/** Distance between agents, spread along X around the first player start */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak", meta=(ClampMin="0.0"))
+	float AgentSpacing = 150.0f;
+
+	/** Measured time, after the warmup runs */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak", meta=(ClampMin="0.0"))
+	float DurationHours = 4.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak", meta=(ClampMin="1.0"))
+	float RunSeconds = 120.0f;
+
+	/** Runs before measuring starts - the end of the last one is the memory and object baseline */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak", meta=(ClampMin="0"))
+	int32 WarmupRuns = 1;
+
+	/** Port of the in-process collector */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak")
+	int32 CollectorPort = 18081;
+
+	/** Fail if the 99th percentile frame time is above this (ms, 0 disables) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak|Thresholds", meta=(ClampMin="0.0"))
+	float MaxFrameTimeP99Ms = 50.0f;
+
+	/** Fail if used physical memory after each run grows faster than this (MB per hour, 0 disables) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak|Thresholds", meta=(ClampMin="0.0"))
+	float MaxMemoryGrowthMBPerHour = 64.0f;
+
+	/** Fail if more UObjects than this are alive after the last run than after warmup (0 disables) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak|Thresholds", meta=(ClampMin="0"))
+	int32 MaxObjectGrowth = 5000;
+
+	/** Fail if more than this fraction of events went missing without being shed or dropped */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak|Thresholds", meta=(ClampMin="0.0", ClampMax="1.0"))
+	float MaxLostEventRatio = 0.001f;
+
+	/** Frame time hitch counting for the report */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Soak")
+	FTelemetryFramePerformanceSettings FramePerformance;
+
+private:
+	enum class EPhase : uint8
+	{
+		WaitingForMap,
+		Running,
+		Draining,
+		Done
+	};
+
+	/** State after each run's garbage collection */
+	struct FSample
+	{
+		/** Since measuring started */
+		double Hours = 0.0;
+		double UsedPhysicalMB = 0.0;
+		int32 Objects = 0;
+		int32 PendingEvents = 0;
+		int32 Trackers = 0;
+	};
+
+	/** Start the soak in Map, or respawn agents after the game reloaded it */
+	void OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params);
+
+	/** Advance runs, drain and finish (ticker callback) */
+	bool Tick(float DeltaTime);
+
+	void BeginSoak();
+	void StartSoakRun();
+	void EndSoakRun();
+
+	/** Take the baseline sample and start collecting frame times and throughput */
+	void BeginMeasuring();
+
+	void BeginDrain();
+
+	/** Write the report and exit with the result */
+	void Finish();
+
+	void SpawnAgents();
+	void DestroyAgents(TConstArrayView<TWeakObjectPtr<APawn>> RunAgents);
+
+	FSample TakeSample() const;
+
+	/** Move the collector's latency samples into LatencyMs so its arrays do not grow for hours */
+	void TakeCollectorSamples();
+
+	UTelemetrySubsystem* GetTelemetry() const;
+
+	EPhase Phase = EPhase::WaitingForMap;
+	bool bMeasuring = false;
+	FString OutputPath;
+
+	TWeakObjectPtr<UWorld> SoakWorld;
+
+	UPROPERTY(Transient)
+	TSubclassOf<APawn> LoadedAgentClass;
+
+	TArray<TWeakObjectPtr<APawn>> Agents;
+
+	/** Agents still alive after the garbage collection that followed their run */
+	int32 LeakedAgents = 0;
+
+	TSharedPtr<FTelemetryLocalCollector> Collector;
+	TSharedPtr<FTelemetryFramePerformanceCollector> FramePerformanceCollector;
+	FTelemetryFrameHistogram LatencyMs;
+
+	/** Baseline first, then one per measured run */
+	TArray<FSample> Samples;
+	int32 Runs = 0;
+
+	/** Collector and client totals when measuring started */
+	int64 EventsAtMeasureStart = 0;
+	int64 WireBytesAtMeasureStart = 0;
+	int64 RequestsAtMeasureStart = 0;
+
+	double MeasureStartTime = 0.0;
+	double EndTime = 0.0;
+	double RunEndTime = 0.0;
+	double DrainEndTime = 0.0;
+
+	FDelegateHandle WorldInitializedActorsHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,280 @@
+#include "TelemetrySpool.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Crc.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	constexpr uint32 SegmentMagic = 0x50534C54; // "TLSP"
+	constexpr uint16 SegmentVersion = 1;
+	const TCHAR* SegmentExtension = TEXT(".tlseg");
+
+	/** Session IDs contain the machine name - keep them file system safe */
+	FString MakeSegmentPrefix(const FString& SessionID)
+	{
+		return FPaths::MakeValidFileName(SessionID, TEXT('_')) + TEXT("__");
+	}
+
+	void WriteString(FArchive& Ar, const FString& Value)
+	{
+		const FTCHARToUTF8 Utf8(*Value, Value.Len());
+		uint16 Length = static_cast<uint16>(FMath::Min(Utf8.Length(), static_cast<int32>(MAX_uint16)));
+		Ar << Length;
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Length);
+	}
+
+	bool ReadString(TConstArrayView<uint8> Data, int32& Offset, FString& OutValue)
+	{
+		uint16 Length = 0;
+		if (Offset + static_cast<int32>(sizeof(Length)) > Data.Num())
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Length, Data.GetData() + Offset, sizeof(Length));
+		Offset += sizeof(Length);
+
+		if (Offset + Length > Data.Num())
+		{
+			return false;
+		}
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const UTF8CHAR*>(Data.GetData() + Offset), Length);
+		OutValue = FString(Converted.Length(), Converted.Get());
+		Offset += Length;
+		return true;
+	}
+}
+
+FTelemetrySpool::FTelemetrySpool(const FString& InDirectory, int64 InMaxBytes)
+	: Directory(InDirectory)
+	, MaxBytes(InMaxBytes)
+{
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	ScanExisting();
+}
+
+FString FTelemetrySpool::Write(const FString& SessionID, const FString& ContentType, const TCHAR* ContentEncoding, TConstArrayView<uint8> Body)
+{
+	uint32 SegmentIndex;
+	{
+		FScopeLock Lock(&SpoolLock);
+		SegmentIndex = NextSegmentIndex++;
+	}
+
+	const FString FileName = FString::Printf(TEXT("%s%lld_%06u%s"),
+		*MakeSegmentPrefix(SessionID), FDateTime::UtcNow().GetTicks(), SegmentIndex, SegmentExtension);
+	const FString FinalPath = FPaths::Combine(Directory, FileName);
+	const FString TempPath = FinalPath + TEXT(".tmp");
+
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Could not open spool segment %s"), *TempPath);
+			return FString();
+		}
+
+		uint32 Magic = SegmentMagic;
+		uint16 Version = SegmentVersion;
+		uint16 Flags = 0;
+		uint32 BodySize = Body.Num();
+		uint32 BodyCrc = FCrc::MemCrc32(Body.GetData(), Body.Num());
+
+		*Writer << Magic << Version << Flags << BodySize << BodyCrc;
+		WriteString(*Writer, SessionID);
+		WriteString(*Writer, ContentType);
+		WriteString(*Writer, ContentEncoding ? FString(ContentEncoding) : FString());
+		Writer->Serialize(const_cast<uint8*>(Body.GetData()), Body.Num());
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Failed writing spool segment %s"), *TempPath);
+			IFileManager::Get().Delete(*TempPath, false, true, true);
+			return FString();
+		}
+	}
+
+	// Rename is atomic - readers only ever see complete segments
+	if (!IFileManager::Get().Move(*FinalPath, *TempPath, true, true, false, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Failed to commit spool segment %s"), *FinalPath);
+		IFileManager::Get().Delete(*TempPath, false, true, true);
+		return FString();
+	}
+
+	const int64 SegmentSize = IFileManager::Get().FileSize(*FinalPath);
+
+	FScopeLock Lock(&SpoolLock);
+	Segments.Add({FinalPath, SegmentSize, true});
+	TotalBytes += SegmentSize;
+	EnforceBudget();
+
+	return FinalPath;
+}
+
+void FTelemetrySpool::Complete(const FString& SegmentPath, bool bAccepted)
+{
+	if (SegmentPath.IsEmpty())
+	{
+		return;
+	}
+
+	{
+		FScopeLock Lock(&SpoolLock);
+		const int32 Index = Segments.IndexOfByPredicate([&SegmentPath](const FSegmentEntry& Segment)
+		{
+			return Segment.Path == SegmentPath;
+		});
+
+		// Not found if the budget already evicted it
+		if (Index == INDEX_NONE)
+		{
+			return;
+		}
+
+		if (!bAccepted)
+		{
+			// Keep it on disk for the next replay
+			Segments[Index].bInFlight = false;
+			return;
+		}
+
+		TotalBytes -= Segments[Index].Size;
+		Segments.RemoveAt(Index);
+	}
+
+	IFileManager::Get().Delete(*SegmentPath, false, true, true);
+}
+
+TArray<FString> FTelemetrySpool::ClaimLeftoverSegments()
+{
+	TArray<FString> Leftovers;
+
+	FScopeLock Lock(&SpoolLock);
+	for (FSegmentEntry& Segment : Segments)
+	{
+		if (!Segment.bInFlight)
+		{
+			Segment.bInFlight = true;
+			Leftovers.Add(Segment.Path);
+		}
+	}
+	return Leftovers;
+}
+
+bool FTelemetrySpool::Read(const FString& SegmentPath, FTelemetrySpoolSegment& OutSegment)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *SegmentPath, FILEREAD_Silent))
+	{
+		// Evicted or acknowledged in the meantime
+		return false;
+	}
+
+	constexpr int32 FixedHeaderSize = sizeof(uint32) + sizeof(uint16) + sizeof(uint16) + sizeof(uint32) + sizeof(uint32);
+
+	bool bValid = Data.Num() >= FixedHeaderSize;
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint32 BodySize = 0;
+	uint32 BodyCrc = 0;
+	int32 Offset = 0;
+
+	if (bValid)
+	{
+		FMemory::Memcpy(&Magic, Data.GetData(), sizeof(Magic));
+		FMemory::Memcpy(&Version, Data.GetData() + 4, sizeof(Version));
+		FMemory::Memcpy(&BodySize, Data.GetData() + 8, sizeof(BodySize));
+		FMemory::Memcpy(&BodyCrc, Data.GetData() + 12, sizeof(BodyCrc));
+		Offset = FixedHeaderSize;
+
+		FString SessionID;
+		bValid = Magic == SegmentMagic
+			&& Version == SegmentVersion
+			&& ReadString(Data, Offset, SessionID)
+			&& ReadString(Data, Offset, OutSegment.ContentType)
+			&& ReadString(Data, Offset, OutSegment.ContentEncoding)
+			&& Offset + static_cast<int64>(BodySize) == Data.Num()
+			&& FCrc::MemCrc32(Data.GetData() + Offset, BodySize) == BodyCrc;
+	}
+
+	if (!bValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Discarding corrupt spool segment %s"), *SegmentPath);
+		Complete(SegmentPath, true);
+		return false;
+	}
+
+	OutSegment.Path = SegmentPath;
+	OutSegment.Body = TArray<uint8>(Data.GetData() + Offset, BodySize);
+	return true;
+}
+
+void FTelemetrySpool::SetMaxBytes(int64 InMaxBytes)
+{
+	FScopeLock Lock(&SpoolLock);
+	MaxBytes = InMaxBytes;
+	EnforceBudget();
+}
+
+int64 FTelemetrySpool::GetSpooledBytes() const
+{
+	FScopeLock Lock(&SpoolLock);
+	return TotalBytes;
+}
+
+void FTelemetrySpool::EnforceBudget()
+{
+	int32 NumEvicted = 0;
+	while (TotalBytes > MaxBytes && NumEvicted < Segments.Num())
+	{
+		IFileManager::Get().Delete(*Segments[NumEvicted].Path, false, true, true);
+		TotalBytes -= Segments[NumEvicted].Size;
+		++NumEvicted;
+	}
+
+	if (NumEvicted > 0)
+	{
+		Segments.RemoveAt(0, NumEvicted);
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Spool over budget - evicted %d oldest segments"), NumEvicted);
+	}
+}
+
+void FTelemetrySpool::ScanExisting()
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	// Temp files are writes that never completed
+	TArray<FString> TempFiles;
+	FileManager.FindFiles(TempFiles, *FPaths::Combine(Directory, TEXT("*.tmp")), true, false);
+	for (const FString& TempFile : TempFiles)
+	{
+		FileManager.Delete(*FPaths::Combine(Directory, TempFile), false, true, true);
+	}
+
+	TArray<FString> Files;
+	FileManager.FindFiles(Files, *FPaths::Combine(Directory, FString(TEXT("*")) + SegmentExtension), true, false);
+
+	// Names are session ID (machine_timestamp) then UTC write time, so name order is age order
+	Files.Sort();
+
+	FScopeLock Lock(&SpoolLock);
+	for (const FString& File : Files)
+	{
+		const FString Path = FPaths::Combine(Directory, File);
+		const int64 Size = FileManager.FileSize(*Path);
+		if (Size > 0)
+		{
+			Segments.Add({Path, Size, false});
+			TotalBytes += Size;
+		}
+	}
+
+	EnforceBudget();
+
+	if (Segments.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[Telemetry] Found %d spooled segments (%lld bytes) from earlier sessions"), Segments.Num(), TotalBytes);
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A batch body read back from the spool
+ */
+struct FTelemetrySpoolSegment
+{
+	/** Segment file on disk, used to acknowledge it */
+	FString Path;
+
+	FString ContentType;
+
+	/** Content-Encoding header value, empty if uncompressed */
+	FString ContentEncoding;
+
+	TArray<uint8> Body;
+};
+
+/**
+ * On-disk spool of upload bodies
+ * Every batch is written to its own segment file before upload and deleted once the
+ * collector acknowledges it, so nothing is lost when the server is down or the game crashes.
+ * Segments are written to a temp file and renamed, so a crash never leaves a half-written segment.
+ * Total size is bounded - the oldest segments are evicted when the budget is exceeded.
+ *
+ * Write/Claim/Read run on the telemetry worker, Complete on the HTTP thread.
+ */
+class FTelemetrySpool
+{
+public:
+	FTelemetrySpool(const FString& InDirectory, int64 InMaxBytes);
+
+	/**
+	 * Persist a batch body before it is uploaded
+	 * @return Segment path to pass to Complete, empty if the write failed
+	 */
+	FString Write(const FString& SessionID, const FString& ContentType, const TCHAR* ContentEncoding, TConstArrayView<uint8> Body);
+
+	/**
+	 * Finish an upload attempt
+	 * @param bAccepted - true deletes the segment, false keeps it for the next replay
+	 */
+	void Complete(const FString& SegmentPath, bool bAccepted);
+
+	/** Find segments not currently being uploaded (failed uploads, earlier runs) and mark them in flight */
+	TArray<FString> ClaimLeftoverSegments();
+
+	/** Read a segment back, deleting it if it is corrupt */
+	bool Read(const FString& SegmentPath, FTelemetrySpoolSegment& OutSegment);
+
+	void SetMaxBytes(int64 InMaxBytes);
+
+	/** Bytes currently held on disk */
+	int64 GetSpooledBytes() const;
+
+private:
+	/** Drop the oldest segments until the spool fits its budget (SpoolLock held) */
+	void EnforceBudget();
+
+	/** Register existing segment files on startup */
+	void ScanExisting();
+
+	const FString Directory;
+
+	struct FSegmentEntry
+	{
+		FString Path;
+		int64 Size = 0;
+
+		/** Upload in progress - not eligible for replay */
+		bool bInFlight = false;
+	};
+
+	/** Segments on disk, oldest first - guarded by SpoolLock */
+	TArray<FSegmentEntry> Segments;
+	int64 TotalBytes = 0;
+	int64 MaxBytes = 0;
+	uint32 NextSegmentIndex = 0;
+
+	mutable FCriticalSection SpoolLock;
+};
@@ -0,0 +1,27 @@
+#include "TelemetryStats.h"
+
+DEFINE_STAT(STAT_TelemetryBuildEvent);
+DEFINE_STAT(STAT_TelemetryEnqueue);
+DEFINE_STAT(STAT_TelemetryProcessQueue);
+DEFINE_STAT(STAT_TelemetrySerialize);
+DEFINE_STAT(STAT_TelemetryCompress);
+DEFINE_STAT(STAT_TelemetryDispatch);
+DEFINE_STAT(STAT_TelemetryWriteSinks);
+
+DEFINE_STAT(STAT_TelemetryEventsEnqueued);
+DEFINE_STAT(STAT_TelemetryEventsSent);
+DEFINE_STAT(STAT_TelemetryEventsDropped);
+DEFINE_STAT(STAT_TelemetryUploadsRetried);
+DEFINE_STAT(STAT_TelemetryUploadsFailed);
+DEFINE_STAT(STAT_TelemetryBytesSent);
+DEFINE_STAT(STAT_TelemetryFramesStreamed);
+
+DEFINE_STAT(STAT_TelemetryQueueDepth);
+DEFINE_STAT(STAT_TelemetryUploadsInFlight);
+DEFINE_STAT(STAT_TelemetryBatchSize);
+DEFINE_STAT(STAT_TelemetryRequestLatency);
+DEFINE_STAT(STAT_TelemetryDeliveryLatencyP50);
+DEFINE_STAT(STAT_TelemetryDeliveryLatencyP95);
+DEFINE_STAT(STAT_TelemetryDeliveryLatencyP99);
+
+UE_TRACE_CHANNEL_DEFINE(TelemetryChannel);
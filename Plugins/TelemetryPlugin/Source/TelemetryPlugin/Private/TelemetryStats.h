@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Self-instrumentation of the telemetry pipeline
+ * "stat Telemetry" shows the cost per frame in a playtest; in Unreal Insights the same scopes
+ * appear on the Telemetry trace channel (-trace=cpu,telemetry, or "Trace.Enable Telemetry").
+ * Counters are per frame, accumulators hold the latest value.
+ */
+DECLARE_STATS_GROUP(TEXT("Telemetry"), STATGROUP_Telemetry, STATCAT_Advanced);
+
+// Game thread
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Event"), STAT_TelemetryBuildEvent, STATGROUP_Telemetry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enqueue"), STAT_TelemetryEnqueue, STATGROUP_Telemetry, );
+
+// Worker thread
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process Queue"), STAT_TelemetryProcessQueue, STATGROUP_Telemetry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_TelemetrySerialize, STATGROUP_Telemetry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compress"), STAT_TelemetryCompress, STATGROUP_Telemetry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dispatch"), STAT_TelemetryDispatch, STATGROUP_Telemetry, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Write Sinks"), STAT_TelemetryWriteSinks, STATGROUP_Telemetry, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Enqueued"), STAT_TelemetryEventsEnqueued, STATGROUP_Telemetry, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Sent"), STAT_TelemetryEventsSent, STATGROUP_Telemetry, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Dropped"), STAT_TelemetryEventsDropped, STATGROUP_Telemetry, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Uploads Retried"), STAT_TelemetryUploadsRetried, STATGROUP_Telemetry, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Uploads Failed"), STAT_TelemetryUploadsFailed, STATGROUP_Telemetry, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Sent"), STAT_TelemetryBytesSent, STATGROUP_Telemetry, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Frames Streamed"), STAT_TelemetryFramesStreamed, STATGROUP_Telemetry, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Queue Depth"), STAT_TelemetryQueueDepth, STATGROUP_Telemetry, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Uploads In Flight"), STAT_TelemetryUploadsInFlight, STATGROUP_Telemetry, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Batch Size"), STAT_TelemetryBatchSize, STATGROUP_Telemetry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Request Latency (ms)"), STAT_TelemetryRequestLatency, STATGROUP_Telemetry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Delivery Latency p50 (ms)"), STAT_TelemetryDeliveryLatencyP50, STATGROUP_Telemetry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Delivery Latency p95 (ms)"), STAT_TelemetryDeliveryLatencyP95, STATGROUP_Telemetry, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Delivery Latency p99 (ms)"), STAT_TelemetryDeliveryLatencyP99, STATGROUP_Telemetry, );
+
+UE_TRACE_CHANNEL_EXTERN(TelemetryChannel);
+
+/** Cycle counter for "stat Telemetry" plus a CPU scope on the Telemetry trace channel */
+#define TELEMETRY_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, TelemetryChannel)
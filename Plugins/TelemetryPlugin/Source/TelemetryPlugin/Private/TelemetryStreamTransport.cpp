@@ -0,0 +1,303 @@
+#include "TelemetryStreamTransport.h"
+#include "TelemetrySpool.h"
+#include "TelemetryCompression.h"
+#include "TelemetryBinaryFormat.h"
+#include "TelemetryStats.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/Guid.h"
+
+namespace
+{
+	/** Content kind byte in the frame header */
+	uint8 GetContentKind(const TCHAR* ContentType)
+	{
+		if (FCString::Strcmp(ContentType, TelemetryBinaryFormat::ContentType) == 0)
+		{
+			return 2;
+		}
+		return FCString::Strcmp(ContentType, TEXT("application/x-ndjson")) == 0 ? 1 : 0;
+	}
+}
+
+TArray<uint8> FTelemetryStreamFrame::TakeBody()
+{
+	TArray<uint8> Body = MoveTemp(Data);
+	Body.RemoveAt(0, FTelemetryStreamTransport::HeaderSize, EAllowShrinking::No);
+	return Body;
+}
+
+FTelemetryStreamTransport::FTelemetryStreamTransport(const FString& InMachineName)
+	: MachineName(InMachineName)
+	, StreamID(FGuid::NewGuid().ToString(EGuidFormats::DigitsLower))
+{
+}
+
+FTelemetryStreamTransport::~FTelemetryStreamTransport()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+}
+
+void FTelemetryStreamTransport::SetSettings(const FTelemetryStreamingSettings& InSettings)
+{
+	Settings = InSettings;
+	MaxPendingBytes.store(static_cast<int64>(Settings.MaxUnackedKilobytes) * 1024);
+}
+
+void FTelemetryStreamTransport::Open(const FString& URL)
+{
+	{
+		FScopeLock Lock(&SendLock);
+		bClosed = false;
+	}
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateSP(this, &FTelemetryStreamTransport::Tick));
+	}
+
+	if (URL == SocketURL && (bConnected.load() || bConnecting))
+	{
+		return;
+	}
+
+	SocketURL = URL;
+	NextConnectTime = 0.0;
+	ReconnectDelay = Settings.ReconnectDelay;
+	Connect();
+}
+
+void FTelemetryStreamTransport::Close()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	if (Socket)
+	{
+		Socket->OnConnected().Clear();
+		Socket->OnConnectionError().Clear();
+		Socket->OnClosed().Clear();
+		Socket->OnMessage().Clear();
+		Socket->Close();
+		Socket.Reset();
+	}
+	bConnecting = false;
+	SocketURL.Reset();
+
+	// Anything the collector has not acknowledged goes out over POST with the worker's last flush
+	FScopeLock Lock(&SendLock);
+	bClosed = true;
+	bConnected.store(false);
+	FallBack();
+}
+
+bool FTelemetryStreamTransport::Send(const TCHAR* ContentType, const TCHAR* ContentEncoding, TConstArrayView<uint8> Body,
+	const TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe>& Spool, const FString& SegmentPath, const FString& IdempotencyKey,
+	FTelemetryBatchTiming& Timing, const TSharedPtr<FTelemetryLatencyTracker, ESPMode::ThreadSafe>& Latency)
+{
+	FScopeLock Lock(&SendLock);
+
+	if (bClosed || !bConnected.load(std::memory_order_relaxed)
+		|| PendingBytes.load(std::memory_order_relaxed) + Body.Num() > MaxPendingBytes.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	FTelemetryStreamFrame Frame;
+	Frame.Sequence = NextSequence.fetch_add(1, std::memory_order_relaxed);
+	Frame.ContentType = ContentType;
+	Frame.ContentEncoding = ContentEncoding;
+	Frame.Spool = Spool;
+	Frame.SegmentPath = SegmentPath;
+	Frame.IdempotencyKey = IdempotencyKey;
+	Frame.Timing = MoveTemp(Timing);
+	Frame.Latency = Latency;
+
+	Frame.Data.SetNumUninitialized(HeaderSize + Body.Num());
+	FMemory::Memcpy(Frame.Data.GetData(), &Frame.Sequence, sizeof(uint64));
+	Frame.Data[8] = GetContentKind(ContentType);
+	Frame.Data[9] = static_cast<uint8>(TelemetryCompression::FromContentEncoding(ContentEncoding ? ContentEncoding : TEXT("")));
+	FMemory::Memcpy(Frame.Data.GetData() + HeaderSize, Body.GetData(), Body.Num());
+
+	PendingBytes.fetch_add(Body.Num(), std::memory_order_relaxed);
+	INC_DWORD_STAT(STAT_TelemetryFramesStreamed);
+	INC_DWORD_STAT_BY(STAT_TelemetryBytesSent, static_cast<uint32>(Frame.Data.Num()));
+
+	Outgoing.Enqueue(MoveTemp(Frame));
+	return true;
+}
+
+bool FTelemetryStreamTransport::TakeFallback(FTelemetryStreamFrame& OutFrame)
+{
+	return Fallback.Dequeue(OutFrame);
+}
+
+bool FTelemetryStreamTransport::Tick(float DeltaTime)
+{
+	if (bConnected.load())
+	{
+		FTelemetryStreamFrame Frame;
+		while (Outgoing.Dequeue(Frame))
+		{
+			SendFrame(Frame);
+			Unacked.Add(MoveTemp(Frame));
+		}
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (!bConnecting && !SocketURL.IsEmpty() && Now >= NextConnectTime)
+	{
+		Connect();
+	}
+
+	// Batches must not sit behind a dead stream for long - the worker POSTs them instead
+	if (DisconnectedSince > 0.0 && Now - DisconnectedSince >= Settings.FallbackDelay)
+	{
+		FScopeLock Lock(&SendLock);
+		FallBack();
+	}
+	return true;
+}
+
+void FTelemetryStreamTransport::Connect()
+{
+	// Replaced here rather than in its own callbacks, where releasing it is not safe
+	if (Socket)
+	{
+		Socket->OnConnected().Clear();
+		Socket->OnConnectionError().Clear();
+		Socket->OnClosed().Clear();
+		Socket->OnMessage().Clear();
+		Socket.Reset();
+	}
+
+	Socket = FWebSocketsModule::Get().CreateWebSocket(SocketURL, TEXT("telemetry"));
+	Socket->OnConnected().AddSP(this, &FTelemetryStreamTransport::OnConnected);
+	Socket->OnConnectionError().AddSP(this, &FTelemetryStreamTransport::OnDisconnected);
+	Socket->OnClosed().AddSPLambda(this, [this](int32 StatusCode, const FString& Reason, bool bWasClean)
+	{
+		OnDisconnected(FString::Printf(TEXT("closed (%d) %s"), StatusCode, *Reason));
+	});
+	Socket->OnMessage().AddSP(this, &FTelemetryStreamTransport::OnMessage);
+
+	bConnecting = true;
+	Socket->Connect();
+}
+
+void FTelemetryStreamTransport::SendFrame(FTelemetryStreamFrame& Frame)
+{
+	// Resends after a reconnect keep the first send time, so round trips include the outage
+	if (Frame.Timing.SendTime == 0.0)
+	{
+		Frame.Timing.SendTime = FPlatformTime::Seconds();
+	}
+	Socket->Send(Frame.Data.GetData(), Frame.Data.Num(), true);
+}
+
+void FTelemetryStreamTransport::OnConnected()
+{
+	bConnecting = false;
+	DisconnectedSince = 0.0;
+	ReconnectDelay = Settings.ReconnectDelay;
+
+	// Everything before resume_from was acknowledged or went out over POST
+	const uint64 ResumeFrom = Unacked.IsEmpty() ? NextSequence.load() : Unacked[0].Sequence;
+	Socket->Send(FString::Printf(TEXT("{\"hello\":\"telemetry\",\"stream_id\":\"%s\",\"machine_id\":\"%s\",\"resume_from\":%llu}"),
+		*StreamID, *MachineName.ReplaceCharWithEscapedChar(), ResumeFrom));
+
+	for (FTelemetryStreamFrame& Frame : Unacked)
+	{
+		SendFrame(Frame);
+	}
+	bConnected.store(true);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Stream connected: %s (resuming from %llu, %d frames resent)"),
+		*SocketURL, ResumeFrom, Unacked.Num());
+}
+
+void FTelemetryStreamTransport::OnDisconnected(const FString& Reason)
+{
+	const bool bWasConnected = bConnected.exchange(false);
+	bConnecting = false;
+
+	const double Now = FPlatformTime::Seconds();
+	if (DisconnectedSince == 0.0)
+	{
+		DisconnectedSince = Now;
+	}
+	NextConnectTime = Now + ReconnectDelay;
+
+	if (bWasConnected)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Stream lost (%s) - reconnecting in %.1fs"), *Reason, ReconnectDelay);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[Telemetry] Stream connect failed (%s) - retrying in %.1fs"), *Reason, ReconnectDelay);
+	}
+	ReconnectDelay = FMath::Min(ReconnectDelay * 2.0f, Settings.MaxReconnectDelay);
+}
+
+void FTelemetryStreamTransport::OnMessage(const FString& Message)
+{
+	TSharedPtr<FJsonObject> Json;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+	int64 Ack = 0;
+	if (FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid() && Json->TryGetNumberField(TEXT("ack"), Ack))
+	{
+		Acknowledge(static_cast<uint64>(Ack));
+	}
+}
+
+void FTelemetryStreamTransport::Acknowledge(uint64 Sequence)
+{
+	const double Now = FPlatformTime::Seconds();
+	int32 NumAcked = 0;
+	int64 AckedBytes = 0;
+	while (NumAcked < Unacked.Num() && Unacked[NumAcked].Sequence <= Sequence)
+	{
+		FTelemetryStreamFrame& Frame = Unacked[NumAcked++];
+		if (Frame.Spool && !Frame.SegmentPath.IsEmpty())
+		{
+			Frame.Spool->Complete(Frame.SegmentPath, true);
+		}
+		if (Frame.Latency)
+		{
+			Frame.Latency->AddBatch(Frame.Timing, Now, true);
+		}
+		AckedBytes += Frame.Data.Num() - HeaderSize;
+	}
+
+	Unacked.RemoveAt(0, NumAcked, EAllowShrinking::No);
+	PendingBytes.fetch_sub(AckedBytes, std::memory_order_relaxed);
+}
+
+void FTelemetryStreamTransport::FallBack()
+{
+	// Outgoing is drained after Unacked so the fallback keeps sequence order
+	int64 FallbackBytes = 0;
+	for (FTelemetryStreamFrame& Frame : Unacked)
+	{
+		FallbackBytes += Frame.Data.Num() - HeaderSize;
+		Fallback.Enqueue(MoveTemp(Frame));
+	}
+	Unacked.Reset();
+
+	FTelemetryStreamFrame Frame;
+	while (Outgoing.Dequeue(Frame))
+	{
+		FallbackBytes += Frame.Data.Num() - HeaderSize;
+		Fallback.Enqueue(MoveTemp(Frame));
+	}
+
+	if (FallbackBytes > 0)
+	{
+		PendingBytes.fetch_sub(FallbackBytes, std::memory_order_relaxed);
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Stream unavailable - %lld KB handed back to HTTP upload"), FallbackBytes / 1024);
+	}
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "TelemetryTypes.h"
+#include "TelemetryLatency.h"
+#include <atomic>
+
+class IWebSocket;
+class FTelemetrySpool;
+
+/**
+ * An upload body framed for the stream
+ * Data is the frame header (sequence, content type, encoding) followed by the body, so it goes
+ * onto the socket as is and a resend after a reconnect costs nothing to rebuild.
+ */
+struct FTelemetryStreamFrame
+{
+	uint64 Sequence = 0;
+
+	/** Static strings from the worker, kept for a POST fallback */
+	const TCHAR* ContentType = nullptr;
+	const TCHAR* ContentEncoding = nullptr;
+
+	TArray<uint8> Data;
+
+	/** Spool segment acknowledged once the collector has the frame */
+	TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe> Spool;
+	FString SegmentPath;
+
+	/** Sent as Idempotency-Key if the frame falls back to POST */
+	FString IdempotencyKey;
+
+	/** Delivery timing, reported to Latency when the collector acknowledges the frame */
+	FTelemetryBatchTiming Timing;
+	TSharedPtr<FTelemetryLatencyTracker, ESPMode::ThreadSafe> Latency;
+
+	/** The body without the frame header, for the POST fallback */
+	TArray<uint8> TakeBody();
+};
+
+/**
+ * Long-lived WebSocket to the collector that batch bodies are framed onto
+ * Saves the request object, headers and connection setup every POST pays. Each frame carries a
+ * sequence number; the collector acknowledges with {"ack":N} and frames up to N are dropped and
+ * their spool segments completed. After a reconnect the hello message carries resume_from, the
+ * first unacknowledged sequence, and everything from there is resent.
+ * Send runs on the telemetry thread - one stream may carry several game instances' workers, all
+ * ticked by the dispatcher there. The socket, reconnects and acks live on the game thread
+ * (core ticker and WebSocket callbacks). When the stream is down or the unacknowledged window is
+ * full, Send refuses and the worker POSTs as before; frames stuck on a dead stream longer than
+ * FallbackDelay are handed back to the worker (TakeFallback) to POST.
+ */
+class FTelemetryStreamTransport : public TSharedFromThis<FTelemetryStreamTransport, ESPMode::ThreadSafe>
+{
+public:
+	/** Frame header: uint64 sequence, uint8 content kind, uint8 content encoding */
+	static constexpr int32 HeaderSize = 10;
+
+	explicit FTelemetryStreamTransport(const FString& InMachineName);
+	~FTelemetryStreamTransport();
+
+	/** Reconnect timing and the unacknowledged budget, used from the next Open (game thread) */
+	void SetSettings(const FTelemetryStreamingSettings& InSettings);
+
+	/** Connect to URL unless already connected there (game thread) */
+	void Open(const FString& URL);
+
+	/** Close the socket - unacknowledged frames stay in the spool for the next session (game thread) */
+	void Close();
+
+	/**
+	 * Frame a body onto the stream (worker thread)
+	 * Timing is taken only when the frame is accepted.
+	 * @return false if the stream is down or behind - the caller POSTs the body instead
+	 */
+	bool Send(const TCHAR* ContentType, const TCHAR* ContentEncoding, TConstArrayView<uint8> Body,
+		const TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe>& Spool, const FString& SegmentPath, const FString& IdempotencyKey,
+		FTelemetryBatchTiming& Timing, const TSharedPtr<FTelemetryLatencyTracker, ESPMode::ThreadSafe>& Latency);
+
+	/** Next frame given up on by a dead stream, to be POSTed (worker thread) */
+	bool TakeFallback(FTelemetryStreamFrame& OutFrame);
+
+	bool IsConnected() const { return bConnected.load(std::memory_order_relaxed); }
+
+private:
+	bool Tick(float DeltaTime);
+	void Connect();
+	void SendFrame(FTelemetryStreamFrame& Frame);
+	void OnConnected();
+	void OnDisconnected(const FString& Reason);
+	void OnMessage(const FString& Message);
+	void Acknowledge(uint64 Sequence);
+	void FallBack();
+
+	/** Game thread only, the worker reads MaxPendingBytes */
+	FTelemetryStreamingSettings Settings;
+	std::atomic<int64> MaxPendingBytes{1024 * 1024};
+
+	const FString MachineName;
+
+	/** Identifies this stream across reconnects so the collector can resume it */
+	const FString StreamID;
+
+	/** Game thread only */
+	TSharedPtr<IWebSocket> Socket;
+	FString SocketURL;
+	bool bConnecting = false;
+	double NextConnectTime = 0.0;
+	double DisconnectedSince = 0.0;
+	float ReconnectDelay = 0.0f;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Sent but not acknowledged, oldest first (game thread only) */
+	TArray<FTelemetryStreamFrame> Unacked;
+
+	/** Framed by the worker, waiting for the game thread to put them on the socket */
+	TQueue<FTelemetryStreamFrame, EQueueMode::Spsc> Outgoing;
+
+	/** Given up on by a dead stream, waiting for the worker to POST them */
+	TQueue<FTelemetryStreamFrame, EQueueMode::Spsc> Fallback;
+
+	/** Lets Close take the last frames without racing a Send in progress */
+	FCriticalSection SendLock;
+	bool bClosed = false;
+
+	std::atomic<bool> bConnected{false};
+	std::atomic<uint64> NextSequence{1};
+
+	/** Bytes framed and not yet acknowledged or given up on */
+	std::atomic<int64> PendingBytes{0};
+};
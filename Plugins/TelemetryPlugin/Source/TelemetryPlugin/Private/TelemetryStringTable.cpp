@@ -0,0 +1,55 @@
+#include "TelemetryStringTable.h"
+
+FTelemetryStringTable::FTelemetryStringTable()
+{
+	Chunks[0] = MakeUnique<FString[]>(ChunkSize);
+	NumStrings.store(1, std::memory_order_release);
+}
+
+uint32 FTelemetryStringTable::FindOrAdd(const FString& Value)
+{
+	if (Value.IsEmpty())
+	{
+		return 0;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (const uint32* Existing = Indices.Find(Value))
+	{
+		return *Existing;
+	}
+
+	const uint32 Index = NumStrings.load(std::memory_order_relaxed);
+	if (Index >= ChunkSize * MaxChunks)
+	{
+		// Only warn once - the session keeps sending these as empty strings
+		if (!bWarnedFull)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Session string table full (%u strings) - sending new strings empty"), Index);
+			bWarnedFull = true;
+		}
+		return 0;
+	}
+
+	TUniquePtr<FString[]>& Chunk = Chunks[Index / ChunkSize];
+	if (!Chunk)
+	{
+		Chunk = MakeUnique<FString[]>(ChunkSize);
+	}
+	Chunk[Index % ChunkSize] = Value;
+	Indices.Add(Value, Index);
+
+	// Readers see the string only once it is complete
+	NumStrings.store(Index + 1, std::memory_order_release);
+	return Index;
+}
+
+const FString& FTelemetryStringTable::Get(uint32 Index) const
+{
+	static const FString Empty;
+	if (Index >= Num())
+	{
+		return Empty;
+	}
+	return Chunks[Index / ChunkSize][Index % ChunkSize];
+}
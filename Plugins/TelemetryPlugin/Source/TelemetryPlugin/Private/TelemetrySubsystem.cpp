@@ -1,21 +1,86 @@
 #include "TelemetrySubsystem.h"
-#include "HttpModule.h"
+#include "TelemetryWorker.h"
+#include "TelemetryEventRecord.h"
+#include "TelemetryPositionSampler.h"
+#include "TelemetryEventPolicy.h"
+#include "TelemetryFramePerformance.h"
+#include "TelemetryHeatmap.h"
+#include "TelemetryStats.h"
+#include "TelemetryPositionFrame.h"
+#include "TelemetryTrackerComponent.h"
+#include "TelemetryInputCapture.h"
+#include "TelemetryInputSpan.h"
+#include "TelemetryGhostRecorder.h"
+#include "TelemetryGhostFile.h"
+#include "TelemetrySink.h"
+#include "TelemetryStreamTransport.h"
+#include "TelemetryDispatcher.h"
+#include "Misc/Paths.h"
+#include "InputMappingContext.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/GameInstance.h"
+#include "EngineUtils.h"
 #include "InputAction.h"
-#include "Interfaces/IHttpRequest.h"
-#include "Interfaces/IHttpResponse.h"
-#include "JsonObjectConverter.h"
 #include "HAL/PlatformProcess.h"
 #include "Misc/DateTime.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 
 void UTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	MachineName = FPlatformProcess::ComputerName();
+	const TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe> Dispatcher = FTelemetryDispatcher::Get();
+	MachineName = Dispatcher->GetMachineName();
 	UserName = FPlatformProcess::UserName();
 	FrameCounter = 0;
 
-	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Initialized on: %s under username: %s"), *MachineName, *UserName);
+	EventPolicies = MakeShared<FTelemetryEventPolicies, ESPMode::ThreadSafe>();
+	EventPolicies->SetPolicy(ETelemetryEventType::Position, PositionPolicy);
+	EventPolicies->SetPolicy(ETelemetryEventType::InputReceived, InputPolicy);
+	EventPolicies->SetPolicy(ETelemetryEventType::Damage, DamagePolicy);
+	EventPolicies->SetPolicy(ETelemetryEventType::Death, DeathPolicy);
+
+	Worker = MakeShared<FTelemetryWorker>(MachineName, EventPolicies, Dispatcher);
+	Worker->SetBatching(MaxBatchSize, FlushInterval, BatchFormat);
+	Worker->SetCompression(Compression, MinCompressBytes);
+	Worker->SetSpool(bEnableSpool, static_cast<int64>(MaxSpoolMegabytes) * 1024 * 1024, SpoolDirectory);
+	Worker->SetStringDictionary(bUseStringDictionary);
+	Worker->SetBackpressure(MaxInFlightRequests, static_cast<int64>(MaxBacklogKilobytes) * 1024);
+	Worker->SetDeliveryReportInterval(DeliveryReportInterval);
+	Worker->SetRetry(Retry);
+	ApplySinks();
+
+	PositionSampler = MakeShared<FTelemetryPositionSampler>();
+	PositionSampler->SetSettings(AdaptivePositionSampling);
+
+	FramePerformanceCollector = MakeShared<FTelemetryFramePerformanceCollector>();
+	GhostRecorder = MakeShared<FTelemetryGhostRecorder>();
+	ActiveHeatmap = MakeShared<FTelemetryHeatmap>(Heatmap.CellSize, Heatmap.Plane);
+
+	for (const TSoftClassPtr<AActor>& AutoTrackClass : AutoTrackClasses)
+	{
+		if (UClass* Loaded = AutoTrackClass.LoadSynchronous())
+		{
+			LoadedAutoTrackClasses.Add(Loaded);
+		}
+		else if (!AutoTrackClass.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Auto-track class not found: %s"), *AutoTrackClass.ToString());
+		}
+	}
+	if (!LoadedAutoTrackClasses.IsEmpty())
+	{
+		WorldInitializedActorsHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &UTelemetrySubsystem::OnWorldInitializedActors);
+	}
+	UpdateTrackerTicker();
+
+	PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &UTelemetrySubsystem::OnPostLogin);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Initialized on: %s under username: %s (%d instances in this process)"),
+		*MachineName, *UserName, Dispatcher->GetNumWorkers());
 }
 
 void UTelemetrySubsystem::Deinitialize()
@@ -33,18 +98,389 @@ void UTelemetrySubsystem::Deinitialize()
 		EndSession();
 	}
 
+	FramePerformanceCollector.Reset();
+	GhostRecorder.Reset();
+
+	FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginHandle);
+	if (ActiveInputCapture)
+	{
+		ActiveInputCapture->Stop();
+		ActiveInputCapture = nullptr;
+	}
+
+	FWorldDelegates::OnWorldInitializedActors.Remove(WorldInitializedActorsHandle);
+	if (UWorld* World = AutoTrackWorld.Get())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FTSTicker::GetCoreTicker().RemoveTicker(TrackerTickerHandle);
+	TrackerTickerHandle.Reset();
+	Trackers.Reset();
+
+	// Frames the collector has not acknowledged go back to the worker's final POSTs,
+	// unless another instance keeps the stream open
+	if (StreamTransport)
+	{
+		FTelemetryDispatcher::Get()->ReleaseStream(StreamTransport);
+		StreamTransport.Reset();
+	}
+
+	// Worker drains and uploads anything still queued before its thread exits
+	if (Worker)
+	{
+		Worker->Shutdown();
+		Worker.Reset();
+	}
+
 	Super::Deinitialize();
 }
 
-void UTelemetrySubsystem::Configure(const FString& InServerURL)
+void UTelemetrySubsystem::Configure(const FString& InServerURL, ETelemetryWireFormat WireFormat)
 {
 	ServerURL = InServerURL.IsEmpty() ? TEXT("http://10.20.5.27:8080/telemetry") : InServerURL;
-	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Configured server: %s"), *ServerURL);
+
+	// Redirect a build to a local collector without touching Blueprints
+	FString OverrideURL;
+	if (FParse::Value(FCommandLine::Get(), TEXT("TelemetryURL="), OverrideURL) && !OverrideURL.IsEmpty())
+	{
+		ServerURL = OverrideURL;
+	}
+
+	Worker->SetServerURL(ServerURL);
+	Worker->SetWireFormat(WireFormat);
+	bServerConfigured = true;
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Configured server: %s (%s)"), *ServerURL, *UEnum::GetValueAsString(WireFormat));
 }
 
-void UTelemetrySubsystem::StartNewSession()
+void UTelemetrySubsystem::ConfigureBatching(int32 InMaxBatchSize, float InFlushInterval, ETelemetryBatchFormat InBatchFormat)
+{
+	MaxBatchSize = FMath::Max(1, InMaxBatchSize);
+	FlushInterval = FMath::Max(0.0f, InFlushInterval);
+	BatchFormat = InBatchFormat;
+
+	Worker->SetBatching(MaxBatchSize, FlushInterval, BatchFormat);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Batching configured: max %d events, interval %.2fs, format %s"),
+		MaxBatchSize, FlushInterval, *UEnum::GetValueAsString(BatchFormat));
+}
+
+void UTelemetrySubsystem::ConfigureCompression(ETelemetryCompression InCompression, int32 InMinCompressBytes)
+{
+	Compression = InCompression;
+	MinCompressBytes = FMath::Max(0, InMinCompressBytes);
+
+	Worker->SetCompression(Compression, MinCompressBytes);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Compression configured: %s, min %d bytes"),
+		*UEnum::GetValueAsString(Compression), MinCompressBytes);
+}
+
+void UTelemetrySubsystem::ConfigureSpool(bool bInEnabled, int32 InMaxSpoolMegabytes, const FString& InSpoolDirectory)
+{
+	bEnableSpool = bInEnabled;
+	MaxSpoolMegabytes = FMath::Max(1, InMaxSpoolMegabytes);
+	SpoolDirectory = InSpoolDirectory;
+
+	Worker->SetSpool(bEnableSpool, static_cast<int64>(MaxSpoolMegabytes) * 1024 * 1024, SpoolDirectory);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Spool %s (budget %d MB%s%s)"),
+		bEnableSpool ? TEXT("enabled") : TEXT("disabled"), MaxSpoolMegabytes,
+		SpoolDirectory.IsEmpty() ? TEXT("") : TEXT(", in "), *SpoolDirectory);
+}
+
+void UTelemetrySubsystem::ConfigureBackpressure(int32 InMaxInFlightRequests, int32 InMaxBacklogKilobytes)
 {
+	MaxInFlightRequests = FMath::Max(1, InMaxInFlightRequests);
+	MaxBacklogKilobytes = FMath::Max(0, InMaxBacklogKilobytes);
+
+	Worker->SetBackpressure(MaxInFlightRequests, static_cast<int64>(MaxBacklogKilobytes) * 1024);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Backpressure configured: %d uploads in flight, %d KB backlog"),
+		MaxInFlightRequests, MaxBacklogKilobytes);
+}
+
+void UTelemetrySubsystem::ConfigureRetry(const FTelemetryRetrySettings& InRetry)
+{
+	Retry = InRetry;
+	Worker->SetRetry(Retry);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Retry configured: %d retries, %.1f-%.1fs backoff, batches of %d-%d events"),
+		Retry.MaxRetries, Retry.BaseDelay, Retry.MaxDelay, Retry.MinBatchSize, MaxBatchSize);
+}
+
+void UTelemetrySubsystem::ConfigureSinks(const TArray<FTelemetrySinkSettings>& InSinks)
+{
+	Sinks = InSinks;
+	ApplySinks();
+}
+
+void UTelemetrySubsystem::ConfigureStreaming(const FTelemetryStreamingSettings& InStreaming)
+{
+	Streaming = InStreaming;
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Streaming %s (%s)"),
+		Streaming.bEnabled ? TEXT("enabled") : TEXT("disabled"), *GetStreamURL());
+}
+
+FString UTelemetrySubsystem::GetStreamURL() const
+{
+	if (!Streaming.URL.IsEmpty())
+	{
+		return Streaming.URL;
+	}
+
+	// Local-only setups have no collector to stream to
 	if (ServerURL.IsEmpty())
+	{
+		return FString();
+	}
+
+	FString URL = ServerURL;
+	if (URL.RemoveFromStart(TEXT("https://")))
+	{
+		URL = TEXT("wss://") + URL;
+	}
+	else if (URL.RemoveFromStart(TEXT("http://")))
+	{
+		URL = TEXT("ws://") + URL;
+	}
+	URL.RemoveFromEnd(TEXT("/"));
+	return URL + TEXT("/stream");
+}
+
+TArray<FString> UTelemetrySubsystem::GetCapturedEvents(FName SinkName) const
+{
+	const TSharedPtr<FTelemetryMemorySink, ESPMode::ThreadSafe>* MemorySink = MemorySinks.Find(SinkName);
+	return MemorySink ? (*MemorySink)->GetEvents() : TArray<FString>();
+}
+
+void UTelemetrySubsystem::ClearCapturedEvents(FName SinkName)
+{
+	if (const TSharedPtr<FTelemetryMemorySink, ESPMode::ThreadSafe>* MemorySink = MemorySinks.Find(SinkName))
+	{
+		(*MemorySink)->Reset();
+	}
+}
+
+void UTelemetrySubsystem::ApplySinks()
+{
+	MemorySinks.Reset();
+
+	// No sinks configured keeps the original behaviour: everything is uploaded
+	if (Sinks.IsEmpty())
+	{
+		Worker->SetSinks({}, MAX_uint32);
+		return;
+	}
+
+	TArray<FTelemetrySinkEntry> Entries;
+	uint32 HttpTypeMask = 0;
+	for (const FTelemetrySinkSettings& Settings : Sinks)
+	{
+		uint32 TypeMask = Settings.EventTypes.IsEmpty() ? MAX_uint32 : 0;
+		for (const FString& EventType : Settings.EventTypes)
+		{
+			ETelemetryEventType Type;
+			if (LexFromString(Type, *EventType))
+			{
+				TypeMask |= 1u << static_cast<uint8>(Type);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Sink %s: unknown event type '%s'"), *Settings.Name.ToString(), *EventType);
+			}
+		}
+
+		TSharedPtr<ITelemetrySink, ESPMode::ThreadSafe> Sink;
+		switch (Settings.Type)
+		{
+		case ETelemetrySinkType::Http:
+			HttpTypeMask |= TypeMask;
+			break;
+		case ETelemetrySinkType::File:
+			Sink = MakeShared<FTelemetryFileSink, ESPMode::ThreadSafe>(
+				FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("Sinks")),
+				Settings.Name.IsNone() ? TEXT("telemetry") : Settings.Name.ToString(), Settings.WireFormat,
+				static_cast<int64>(Settings.MaxFileKilobytes) * 1024, Settings.MaxFiles);
+			break;
+		case ETelemetrySinkType::Memory:
+		{
+			TSharedPtr<FTelemetryMemorySink, ESPMode::ThreadSafe> MemorySink = MakeShared<FTelemetryMemorySink, ESPMode::ThreadSafe>(Settings.MemoryCapacity);
+			MemorySinks.Add(Settings.Name, MemorySink);
+			Sink = MemorySink;
+			break;
+		}
+		case ETelemetrySinkType::Udp:
+			Sink = TSharedPtr<ITelemetrySink, ESPMode::ThreadSafe>(FTelemetryUdpSink::Create(Settings.Address, Settings.WireFormat).Release());
+			break;
+		}
+
+		if (Sink)
+		{
+			Entries.Add({Sink, TypeMask});
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("[Telemetry] Sink %s: %s, %s%s"), *Settings.Name.ToString(),
+			*UEnum::GetDisplayValueAsText(Settings.Type).ToString(),
+			Settings.EventTypes.IsEmpty() ? TEXT("all events") : *FString::Join(Settings.EventTypes, TEXT(",")),
+			Settings.Type != ETelemetrySinkType::Http && !Sink ? TEXT(" - could not be created") : TEXT(""));
+	}
+
+	// Nothing to configure without an HTTP sink - local-only sessions can start right away
+	if (HttpTypeMask == 0)
+	{
+		bServerConfigured = true;
+	}
+
+	Worker->SetSinks(MoveTemp(Entries), HttpTypeMask);
+}
+
+FTelemetryBackpressureStats UTelemetrySubsystem::GetBackpressureStats() const
+{
+	return Worker ? Worker->GetBackpressureStats() : FTelemetryBackpressureStats();
+}
+
+FTelemetryCompressionStats UTelemetrySubsystem::GetCompressionStats() const
+{
+	return Worker ? Worker->GetCompressionStats() : FTelemetryCompressionStats();
+}
+
+void UTelemetrySubsystem::ConfigureAdaptivePositionSampling(const FTelemetryAdaptiveSamplingSettings& Settings)
+{
+	AdaptivePositionSampling = Settings;
+
+	{
+		FScopeLock Lock(&PositionSamplerLock);
+		PositionSampler->SetSettings(AdaptivePositionSampling);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Adaptive position sampling %s (tolerance %.1f, keep-alive %.1fs, step %.2f)"),
+		Settings.bEnabled ? TEXT("enabled") : TEXT("disabled"),
+		Settings.ErrorTolerance, Settings.KeepAliveInterval, Settings.QuantizationStep);
+}
+
+void UTelemetrySubsystem::ConfigureFramePerformance(const FTelemetryFramePerformanceSettings& Settings)
+{
+	FramePerformance = Settings;
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Frame performance collection %s (%d hitch thresholds)"),
+		Settings.bEnabled ? TEXT("enabled") : TEXT("disabled"), Settings.HitchThresholdsMs.Num());
+}
+
+void UTelemetrySubsystem::ConfigureHeatmap(const FTelemetryHeatmapSettings& Settings)
+{
+	Heatmap = Settings;
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Heatmap %s (cell %.0f, plane %s, per %s)"),
+		Settings.bEnabled ? TEXT("enabled") : TEXT("disabled"), Settings.CellSize,
+		*UEnum::GetDisplayValueAsText(Settings.Plane).ToString(), *UEnum::GetDisplayValueAsText(Settings.Scope).ToString());
+}
+
+void UTelemetrySubsystem::ConfigureTracking(float InSampleRate)
+{
+	TrackerSampleRate = FMath::Max(0.0f, InSampleRate);
+	UpdateTrackerTicker();
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Tracker pass %s (%.1f Hz)"),
+		TrackerSampleRate > 0.0f ? TEXT("enabled") : TEXT("disabled"), TrackerSampleRate);
+}
+
+void UTelemetrySubsystem::ConfigureGhostRecording(const FTelemetryGhostSettings& Settings)
+{
+	Ghost = Settings;
+	Ghost.SampleRate = FMath::Max(1.0f, Ghost.SampleRate);
+	Ghost.BufferCapacity = FMath::Max(64, Ghost.BufferCapacity);
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Ghost recording %s (%.0f Hz, %d records buffered)"),
+		Ghost.bEnabled ? TEXT("enabled") : TEXT("disabled"), Ghost.SampleRate, Ghost.BufferCapacity);
+}
+
+void UTelemetrySubsystem::ConfigureInputCapture(const FTelemetryInputCaptureSettings& Settings)
+{
+	InputCapture = Settings;
+
+	if (!InputCapture.bEnabled)
+	{
+		if (ActiveInputCapture)
+		{
+			ActiveInputCapture->Stop();
+		}
+		UE_LOG(LogTemp, Log, TEXT("[Telemetry] Input capture disabled"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Input capture enabled (%s)"), *InputCapture.MappingContext.ToString());
+	if (APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController())
+	{
+		StartInputCapture(PlayerController);
+	}
+}
+
+bool UTelemetrySubsystem::StartInputCapture(APlayerController* PlayerController)
+{
+	const UInputMappingContext* MappingContext = InputCapture.MappingContext.LoadSynchronous();
+	if (!MappingContext)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Cannot capture input - mapping context '%s' not found"),
+			*InputCapture.MappingContext.ToString());
+		return false;
+	}
+
+	if (!ActiveInputCapture)
+	{
+		ActiveInputCapture = NewObject<UTelemetryInputCapture>(this);
+	}
+
+	if (!ActiveInputCapture->Start(this, PlayerController, MappingContext))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Cannot capture input - %s has no Enhanced Input component or %s maps no actions"),
+			*GetNameSafe(PlayerController), *MappingContext->GetName());
+		return false;
+	}
+	return true;
+}
+
+void UTelemetrySubsystem::OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	if (InputCapture.bEnabled && NewPlayer && NewPlayer->IsLocalController() && NewPlayer->GetGameInstance() == GetGameInstance())
+	{
+		StartInputCapture(NewPlayer);
+	}
+}
+
+void UTelemetrySubsystem::RegisterTracker(UTelemetryTrackerComponent* Tracker)
+{
+	check(IsInGameThread());
+	Trackers.AddUnique(Tracker);
+}
+
+void UTelemetrySubsystem::UnregisterTracker(UTelemetryTrackerComponent* Tracker)
+{
+	check(IsInGameThread());
+	Trackers.RemoveSingleSwap(Tracker, EAllowShrinking::No);
+}
+
+void UTelemetrySubsystem::Flush()
+{
+	if (Worker)
+	{
+		Worker->RequestFlush();
+	}
+}
+
+int32 UTelemetrySubsystem::GetPendingEventCount() const
+{
+	return Worker ? Worker->GetPendingEventCount() : 0;
+}
+
+int64 UTelemetrySubsystem::GetDroppedEventCount() const
+{
+	return Worker ? Worker->GetDroppedEventCount() : 0;
+}
+
+void UTelemetrySubsystem::StartNewSession()
+{
+	// Set by Configure, or by ApplySinks when no sink uploads over HTTP
+	if (!bServerConfigured)
 	{
 		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Cannot start session - Configure() not called yet!"));
 		return;
@@ -59,14 +495,53 @@ void UTelemetrySubsystem::StartNewSession()
 
 	// Generate unique session ID
 	FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
-	CurrentSessionID = FString::Printf(TEXT("%s_%s"), *MachineName, *Timestamp);
+	CurrentSessionID = FTelemetryDispatcher::Get()->MakeUniqueSessionID(FString::Printf(TEXT("%s_%s"), *MachineName, *Timestamp));
 	FrameCounter = 0;
 
+	{
+		FScopeLock Lock(&PositionSamplerLock);
+		PositionSampler->Reset();
+	}
+
+	if (Heatmap.bEnabled && Heatmap.Scope == ETelemetryHeatmapScope::Session)
+	{
+		BeginHeatmap(ETelemetryHeatmapScope::Session);
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Session started: %s"), *CurrentSessionID);
 
-	// Send session_start event
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("session_start"), 0.0f);
-	SendTelemetryEvent(EventData);
+	// The stream outlives sessions - a new session only opens one if it is not already up
+	const FString NewStreamURL = Streaming.bEnabled ? GetStreamURL() : FString();
+	if (StreamTransport && StreamURL != NewStreamURL)
+	{
+		FTelemetryDispatcher::Get()->ReleaseStream(StreamTransport);
+		StreamTransport.Reset();
+	}
+	StreamURL = NewStreamURL;
+	if (StreamTransport)
+	{
+		StreamTransport->SetSettings(Streaming);
+	}
+	else if (!StreamURL.IsEmpty())
+	{
+		StreamTransport = FTelemetryDispatcher::Get()->AcquireStream(StreamURL, Streaming);
+	}
+	Worker->SetStreamTransport(StreamTransport);
+
+	// Send session_start event - the worker picks the session ID and string table up from it.
+	// Events still adding to the old table are queued before it, later ones use the new table.
+	{
+		FWriteScopeLock Lock(SessionStringsLock);
+		SessionStrings = MakeShared<FTelemetryStringTable, ESPMode::ThreadSafe>();
+
+		FTelemetryEventRecord Record;
+		Record.Type = ETelemetryEventType::SessionStart;
+		Record.Name = FName(TEXT("session_start"), ++HeldKeySerial);
+		Record.Frame = FrameCounter.fetch_add(1, std::memory_order_relaxed);
+		Worker->EnqueueSessionStart(Record, CurrentSessionID, SessionStrings.ToSharedRef());
+	}
+
+	bSessionActive = true;
 }
 
 void UTelemetrySubsystem::EndSession()
@@ -86,9 +561,27 @@ void UTelemetrySubsystem::EndSession()
 
 	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Session ended: %s"), *CurrentSessionID);
 
+	if (AdaptivePositionSampling.bEnabled)
+	{
+		FScopeLock Lock(&PositionSamplerLock);
+		UE_LOG(LogTemp, Log, TEXT("[Telemetry] Adaptive position sampling sent %d, suppressed %d samples"),
+			PositionSampler->GetNumSent(), PositionSampler->GetNumSuppressed());
+	}
+
+	if (EventPolicies->GetNumSuppressed() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[Telemetry] Event policies suppressed %lld events"), EventPolicies->GetNumSuppressed());
+	}
+
+	bSessionActive = false;
+
+	SendHeatmap(ETelemetryHeatmapScope::Session, GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f);
+
 	// Send session_end event
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("session_end"), 0.0f);
-	SendTelemetryEvent(EventData);
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::SessionEnd;
+	SendTelemetryEvent(MoveTemp(Record));
+	Flush();
 
 	CurrentSessionID.Empty();
 }
@@ -113,17 +606,47 @@ void UTelemetrySubsystem::StartRun()
 
 	// Generate unique run ID
 	FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_%f"));
-	CurrentRunData.RunID = FString::Printf(TEXT("%s_run_%s"), *CurrentSessionID, *Timestamp);
-	CurrentRunData.RunStartTime = CurrentTime;
-	CurrentRunData.RunEndTime = 0.0f;  // 0 indicates active run
-	CurrentRunData.RunTotalTime = 0.0f;
-	CurrentRunData.EndReason.Empty();
+	{
+		FScopeLock Lock(&RunDataLock);
+		CurrentRunData = FTelemetryRunData();
+		CurrentRunData.RunID = FString::Printf(TEXT("%s_run_%s"), *CurrentSessionID, *Timestamp);
+		CurrentRunData.RunStartTime = CurrentTime;
+		CurrentRunData.RunEndTime = 0.0f;  // 0 indicates active run
+	}
+
+	// Respawn teleports the player - never extrapolate across it
+	{
+		FScopeLock Lock(&PositionSamplerLock);
+		PositionSampler->Reset();
+	}
+
+	if (FramePerformance.bEnabled)
+	{
+		FramePerformanceCollector->Start(FramePerformance);
+	}
+
+	if (Heatmap.bEnabled && Heatmap.Scope == ETelemetryHeatmapScope::Run)
+	{
+		BeginHeatmap(ETelemetryHeatmapScope::Run);
+	}
+
+	if (Ghost.bEnabled)
+	{
+		const FString GhostPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"), TEXT("Ghosts"),
+			FPaths::MakeValidFileName(CurrentRunData.RunID, TEXT('_')) + TelemetryGhostFile::Extension);
+		if (GhostRecorder->Start(GhostPath, CurrentRunData.RunID, Ghost, GetGameInstance()->GetFirstLocalPlayerController()))
+		{
+			LastGhostPath = GhostPath;
+		}
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Run started: %s at time %.2f"), *CurrentRunData.RunID, CurrentTime);
 
-	// Send run_start event
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("run_start"), CurrentTime);
-	SendTelemetryEvent(EventData);
+	// Send run_start event - the run ID rides in the session string table like end reasons
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::RunStart;
+	Record.GameTime = CurrentTime;
+	SendStringEvent(MoveTemp(Record), CurrentRunData.RunID);
 }
 
 void UTelemetrySubsystem::EndRun(const FString& Reason)
@@ -137,37 +660,119 @@ void UTelemetrySubsystem::EndRun(const FString& Reason)
 	// Get current game time
 	float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
 
-	// Finalize run data
-	CurrentRunData.RunEndTime = CurrentTime;
-	CurrentRunData.RunTotalTime = CurrentRunData.RunEndTime - CurrentRunData.RunStartTime;
-	CurrentRunData.EndReason = Reason;
+	// Finalize run data - producers on other threads stop adding to it from here
+	FTelemetryRunData FinishedRun;
+	{
+		FScopeLock Lock(&RunDataLock);
+		CurrentRunData.RunEndTime = CurrentTime;
+		CurrentRunData.RunTotalTime = CurrentRunData.RunEndTime - CurrentRunData.RunStartTime;
+		CurrentRunData.EndReason = Reason;
+		FinishedRun = CurrentRunData;
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("[Telemetry] Run ended: %s | Reason: %s | Duration: %.2fs | Rooms: %d"), 
-		*CurrentRunData.RunID, *Reason, CurrentRunData.RunTotalTime, CurrentRunData.RoomsCleared);
+		*FinishedRun.RunID, *Reason, FinishedRun.RunTotalTime, FinishedRun.RoomsCleared);
+
+	// Histograms go out before run_end so they carry the run's run_id
+	if (FramePerformanceCollector->IsRunning())
+	{
+		FTelemetryFramePerformance Performance = FramePerformanceCollector->Stop();
+		UE_LOG(LogTemp, Log, TEXT("[Telemetry] Run frame time p50 %.1fms p99 %.1fms over %u frames"),
+			Performance.FrameTime.GetPercentile(50.0), Performance.FrameTime.GetPercentile(99.0), Performance.FrameTime.Count);
+
+		FTelemetryEventRecord PerformanceRecord;
+		PerformanceRecord.Type = ETelemetryEventType::FramePerformance;
+		PerformanceRecord.GameTime = CurrentTime;
+		PerformanceRecord.Name = FName(TEXT("frame_performance"), ++HeldKeySerial);
+		PerformanceRecord.Frame = FrameCounter.fetch_add(1, std::memory_order_relaxed);
+		Worker->EnqueueFramePerformance(PerformanceRecord, MoveTemp(Performance));
+	}
+
+	SendHeatmap(ETelemetryHeatmapScope::Run, CurrentTime);
+	GhostRecorder->Stop();
+
+	// One event with every aggregate, so summary-only clients still get per-run totals
+	if (bSendRunSummary)
+	{
+		FTelemetryEventRecord SummaryRecord;
+		SummaryRecord.Type = ETelemetryEventType::RunSummary;
+		SummaryRecord.GameTime = CurrentTime;
+		SummaryRecord.Name = FName(TEXT("run_summary"), ++HeldKeySerial);
+		SummaryRecord.Frame = FrameCounter.fetch_add(1, std::memory_order_relaxed);
+		Worker->EnqueueRunSummary(SummaryRecord, MoveTemp(FinishedRun));
+	}
 
 	// Send run_end event (includes final run data)
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("run_end"), CurrentTime);
-	SendTelemetryEvent(EventData);
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::RunEnd;
+	Record.GameTime = CurrentTime;
+	SendStringEvent(MoveTemp(Record), Reason);
+	Flush();
 
 	// Clear run data
+	FScopeLock Lock(&RunDataLock);
 	CurrentRunData = FTelemetryRunData();
 }
 
-void UTelemetrySubsystem::SendPositionUpdate(FVector Position, float GameTime)
+void UTelemetrySubsystem::IncrementRoomsCleared()
 {
+	FScopeLock Lock(&RunDataLock);
+	if (!CurrentRunData.IsActive())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Cannot count cleared room - no active run"));
+		return;
+	}
+
+	++CurrentRunData.RoomsCleared;
+}
+
+void UTelemetrySubsystem::SendPositionUpdate(FVector Position, float GameTime, bool bIsAirborne)
+{
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryBuildEvent);
+
 	if (!IsTelemetryReady())
 	{
 		return;
 	}
 
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("position"), GameTime);
-	EventData->SetObjectField(TEXT("player_pos"), CreatePositionObject(Position));
+	// Aggregates see every update, even ones the policies or summary-only mode drop,
+	// unless the tracker pass already feeds them from the player's tracker
+	if (!bPlayerTracked.load(std::memory_order_relaxed))
+	{
+		FScopeLock Lock(&RunDataLock);
+		if (CurrentRunData.IsActive())
+		{
+			CurrentRunData.AddPosition(Position, GameTime, bIsAirborne);
+		}
+		AddToHeatmap(ETelemetryHeatmapLayer::Position, Position);
+	}
+
+	if (bSummaryOnly || !EventPolicies->ShouldCapture(ETelemetryEventType::Position))
+	{
+		return;
+	}
+
+	if (AdaptivePositionSampling.bEnabled)
+	{
+		FScopeLock Lock(&PositionSamplerLock);
+		if (!PositionSampler->ShouldSend(Position, GameTime))
+		{
+			return;
+		}
+	}
+
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::Position;
+	Record.GameTime = GameTime;
+	Record.Position = FVector3f(Position);
 
-	SendTelemetryEvent(EventData);
+	SendTelemetryEvent(MoveTemp(Record));
 }
 
 void UTelemetrySubsystem::SendPlayerInputAction(UInputAction* InputAction, float GameTime)
 {
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryBuildEvent);
+
 	if (!IsTelemetryReady())
 	{
 		return;
@@ -178,14 +783,61 @@ void UTelemetrySubsystem::SendPlayerInputAction(UInputAction* InputAction, float
 		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] SendPlayerInputAction called with null InputAction"));
 		return;
 	}
+
+	const FName ActionName = InputAction->GetFName();
+	{
+		FScopeLock Lock(&RunDataLock);
+		if (CurrentRunData.IsActive())
+		{
+			CurrentRunData.AddInput(ActionName);
+		}
+	}
+	GhostRecorder->RecordInput(ActionName, GameTime, 0.0f);
+
+	if (bSummaryOnly || !EventPolicies->ShouldCapture(ETelemetryEventType::InputReceived))
+	{
+		return;
+	}
 	
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("input_received"), GameTime);
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::InputReceived;
+	Record.GameTime = GameTime;
+	Record.Name = ActionName;
+
+	SendTelemetryEvent(MoveTemp(Record));
+}
+
+void UTelemetrySubsystem::SendInputSpan(FTelemetryInputSpan&& Span)
+{
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryBuildEvent);
+
+	// Checked directly - captured input before a session starts is expected, not an error
+	if (!bServerConfigured || !bSessionActive)
+	{
+		return;
+	}
 
-	TSharedPtr<FJsonObject> IAObject = MakeShareable(new FJsonObject);
-	IAObject->SetStringField(TEXT("action_name"), InputAction->GetName());
-	EventData->SetObjectField(TEXT("input_action"), IAObject);
+	// A span is one press, however many frames it was held for
+	{
+		FScopeLock Lock(&RunDataLock);
+		if (CurrentRunData.IsActive())
+		{
+			CurrentRunData.AddInput(Span.Action);
+		}
+	}
+	GhostRecorder->RecordInput(Span.Action, Span.StartTime, Span.Duration);
+
+	if (bSummaryOnly || !EventPolicies->ShouldCapture(ETelemetryEventType::InputReceived))
+	{
+		return;
+	}
 
-	SendTelemetryEvent(EventData);
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::InputSpan;
+	Record.GameTime = Span.StartTime + Span.Duration;
+	Record.Name = FName(TEXT("input_span"), ++InputSpanSerial);
+	Record.Frame = FrameCounter.fetch_add(1, std::memory_order_relaxed);
+	Worker->EnqueueInputSpan(Record, MoveTemp(Span));
 }
 
 void UTelemetrySubsystem::SendDamageEvent(
@@ -196,67 +848,235 @@ void UTelemetrySubsystem::SendDamageEvent(
 	FVector Position,
 	float GameTime)
 {
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryBuildEvent);
+
 	if (!IsTelemetryReady())
 	{
 		return;
 	}
 
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("damage"), GameTime);
+	{
+		FScopeLock Lock(&RunDataLock);
+		if (CurrentRunData.IsActive())
+		{
+			CurrentRunData.AddDamage(DamageSource, DamageAmount);
+		}
+	}
+	AddToHeatmap(ETelemetryHeatmapLayer::Damage, Position);
+
+	if (!EventPolicies->ShouldCapture(ETelemetryEventType::Damage))
+	{
+		return;
+	}
 
-	EventData->SetNumberField(TEXT("damage"), DamageAmount);
-	EventData->SetNumberField(TEXT("health_before"), HealthBefore);
-	EventData->SetNumberField(TEXT("health_after"), HealthAfter);
-	EventData->SetStringField(TEXT("damage_source"), DamageSource);
-	EventData->SetObjectField(TEXT("player_pos"), CreatePositionObject(Position));
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::Damage;
+	Record.GameTime = GameTime;
+	Record.Position = FVector3f(Position);
+	Record.DamageAmount = DamageAmount;
+	Record.HealthBefore = HealthBefore;
+	Record.HealthAfter = HealthAfter;
 
-	SendTelemetryEvent(EventData);
+	SendStringEvent(MoveTemp(Record), DamageSource);
 }
 
 void UTelemetrySubsystem::SendDeathEvent(const FString& Cause, FVector Position, float GameTime)
 {
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryBuildEvent);
+
 	if (!IsTelemetryReady())
 	{
 		return;
 	}
 
-	TSharedPtr<FJsonObject> EventData = CreateBaseTelemetryObject(TEXT("death"), GameTime);
-	EventData->SetObjectField(TEXT("player_pos"), CreatePositionObject(Position));
+	{
+		FScopeLock Lock(&RunDataLock);
+		if (CurrentRunData.IsActive())
+		{
+			++CurrentRunData.Deaths;
+		}
+	}
+	AddToHeatmap(ETelemetryHeatmapLayer::Death, Position);
 
-	SendTelemetryEvent(EventData);
+	if (!EventPolicies->ShouldCapture(ETelemetryEventType::Death))
+	{
+		return;
+	}
+
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::Death;
+	Record.GameTime = GameTime;
+	Record.Position = FVector3f(Position);
+
+	SendStringEvent(MoveTemp(Record), Cause);
 }
 
-TSharedPtr<FJsonObject> UTelemetrySubsystem::CreateBaseTelemetryObject(const FString& EventType, float GameTime)
+void UTelemetrySubsystem::BeginHeatmap(ETelemetryHeatmapScope Scope)
 {
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	FScopeLock Lock(&HeatmapLock);
+	ActiveHeatmap->Reset(Heatmap.CellSize, Heatmap.Plane);
+	ActiveHeatmapScope = Scope;
+	bHeatmapActive = true;
+}
 
-	// Base fields
-	JsonObject->SetStringField(TEXT("machine_id"), MachineName);
-	JsonObject->SetStringField(TEXT("session_id"), CurrentSessionID);
-	JsonObject->SetStringField(TEXT("event_type"), EventType);
-	JsonObject->SetNumberField(TEXT("frame"), FrameCounter++);
-	JsonObject->SetNumberField(TEXT("game_time"), GameTime);
+void UTelemetrySubsystem::AddToHeatmap(ETelemetryHeatmapLayer Layer, const FVector& Position)
+{
+	FScopeLock Lock(&HeatmapLock);
+	if (bHeatmapActive)
+	{
+		ActiveHeatmap->Add(Layer, Position);
+	}
+}
 
-	return JsonObject;
+void UTelemetrySubsystem::SendHeatmap(ETelemetryHeatmapScope Scope, float GameTime)
+{
+	FTelemetryHeatmap Finished;
+	{
+		FScopeLock Lock(&HeatmapLock);
+		if (!bHeatmapActive || ActiveHeatmapScope != Scope)
+		{
+			return;
+		}
+		bHeatmapActive = false;
+		Finished = MoveTemp(*ActiveHeatmap);
+		ActiveHeatmap->Reset(Heatmap.CellSize, Heatmap.Plane);
+	}
+
+	if (Finished.IsEmpty())
+	{
+		return;
+	}
+
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::Heatmap;
+	Record.GameTime = GameTime;
+	Record.Name = FName(TEXT("heatmap"), ++HeldKeySerial);
+	Record.Frame = FrameCounter.fetch_add(1, std::memory_order_relaxed);
+	Worker->EnqueueHeatmap(Record, MoveTemp(Finished), Scope);
 }
 
-TSharedPtr<FJsonObject> UTelemetrySubsystem::CreatePositionObject(FVector Position)
+void UTelemetrySubsystem::UpdateTrackerTicker()
 {
-	TSharedPtr<FJsonObject> PosObject = MakeShareable(new FJsonObject);
-	PosObject->SetNumberField(TEXT("x"), Position.X);
-	PosObject->SetNumberField(TEXT("y"), Position.Y);
-	PosObject->SetNumberField(TEXT("z"), Position.Z);
-	return PosObject;
+	FTSTicker::GetCoreTicker().RemoveTicker(TrackerTickerHandle);
+	TrackerTickerHandle.Reset();
+
+	if (TrackerSampleRate > 0.0f)
+	{
+		TrackerTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UTelemetrySubsystem::SampleTrackers), 1.0f / TrackerSampleRate);
+	}
+}
+
+bool UTelemetrySubsystem::SampleTrackers(float DeltaTime)
+{
+	// Checked directly - IsTelemetryReady would log on every pass before a session starts
+	if (Trackers.IsEmpty() || !bServerConfigured || !bSessionActive)
+	{
+		return true;
+	}
+
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryBuildEvent);
+
+	Trackers.RemoveAllSwap([](const TWeakObjectPtr<UTelemetryTrackerComponent>& Tracker) { return !Tracker.IsValid(); },
+		EAllowShrinking::No);
+
+	FTelemetryPositionFrame Frame;
+	Frame.Reserve(Trackers.Num());
+	float GameTime = 0.0f;
+	bool bFoundPlayer = false;
+
+	for (const TWeakObjectPtr<UTelemetryTrackerComponent>& WeakTracker : Trackers)
+	{
+		const UTelemetryTrackerComponent* Tracker = WeakTracker.Get();
+		const AActor* Owner = Tracker->GetOwner();
+		if (!Owner)
+		{
+			continue;
+		}
+
+		const FVector Position = Owner->GetActorLocation();
+		GameTime = Owner->GetWorld()->GetTimeSeconds();
+
+		// The player's samples stand in for a SendPositionUpdate timer
+		if (Tracker->IsPlayerTracker())
+		{
+			bFoundPlayer = true;
+			{
+				FScopeLock Lock(&RunDataLock);
+				if (CurrentRunData.IsActive())
+				{
+					CurrentRunData.AddPosition(Position, GameTime, Tracker->IsAirborne());
+				}
+			}
+			AddToHeatmap(ETelemetryHeatmapLayer::Position, Position);
+		}
+
+		Frame.Add(Tracker->GetTrackingLabel(), Position);
+	}
+	bPlayerTracked.store(bFoundPlayer, std::memory_order_relaxed);
+
+	if (bSummaryOnly || Frame.Num() == 0)
+	{
+		return true;
+	}
+
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::PositionFrame;
+	Record.GameTime = GameTime;
+	Record.Name = FName(TEXT("position_frame"), ++TrackerFrameSerial);
+	Record.Frame = FrameCounter.fetch_add(1, std::memory_order_relaxed);
+	Worker->EnqueuePositionFrame(Record, MoveTemp(Frame));
+	return true;
+}
+
+void UTelemetrySubsystem::OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params)
+{
+	UWorld* World = Params.World;
+	if (!World || !World->IsGameWorld() || World->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	if (UWorld* OldWorld = AutoTrackWorld.Get())
+	{
+		OldWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	AutoTrackWorld = World;
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UTelemetrySubsystem::AutoTrackActor));
+
+	for (FActorIterator It(World); It; ++It)
+	{
+		AutoTrackActor(*It);
+	}
+}
+
+void UTelemetrySubsystem::AutoTrackActor(AActor* Actor)
+{
+	if (!Actor || Actor->FindComponentByClass<UTelemetryTrackerComponent>())
+	{
+		return;
+	}
+
+	for (const TSubclassOf<AActor>& AutoTrackClass : LoadedAutoTrackClasses)
+	{
+		if (Actor->IsA(AutoTrackClass))
+		{
+			UTelemetryTrackerComponent* Tracker = NewObject<UTelemetryTrackerComponent>(Actor, TEXT("TelemetryTracker"));
+			Tracker->RegisterComponent();
+			return;
+		}
+	}
 }
 
 bool UTelemetrySubsystem::IsTelemetryReady() const
 {
-	if (ServerURL.IsEmpty())
+	if (!bServerConfigured)
 	{
 		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Cannot send events - server URL not configured"));
 		return false;
 	}
 
-	if (CurrentSessionID.IsEmpty())
+	if (!bSessionActive)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Cannot send events - no active session"));
 		return false;
@@ -265,21 +1085,21 @@ bool UTelemetrySubsystem::IsTelemetryReady() const
 	return true;
 }
 
-void UTelemetrySubsystem::SendTelemetryEvent(const TSharedPtr<FJsonObject>& JsonData) const
+void UTelemetrySubsystem::SendTelemetryEvent(FTelemetryEventRecord&& Record)
+{
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryEnqueue);
+
+	Record.Frame = FrameCounter.fetch_add(1, std::memory_order_relaxed);
+	Worker->Enqueue(Record);
+}
+
+void UTelemetrySubsystem::SendStringEvent(FTelemetryEventRecord&& Record, const FString& Value)
 {
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	if (!FJsonSerializer::Serialize(JsonData.ToSharedRef(), Writer))
+	// Added and queued under the read lock, so the index never outlives its table - see StartNewSession
+	FReadScopeLock Lock(SessionStringsLock);
+	if (SessionStrings)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Failed to serialize JSON"));
-		return;
+		Record.StringIndex = SessionStrings->FindOrAdd(Value);
 	}
-
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(ServerURL);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Request->SetContentAsString(OutputString);
-	Request->SetTimeout(RequestTimeout);
-	Request->ProcessRequest();
+	SendTelemetryEvent(MoveTemp(Record));
 }
@@ -0,0 +1,59 @@
+#include "TelemetryTrackerComponent.h"
+#include "TelemetrySubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+UTelemetryTrackerComponent::UTelemetryTrackerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+FName UTelemetryTrackerComponent::GetTrackingLabel() const
+{
+	if (!TrackingLabel.IsNone())
+	{
+		return TrackingLabel;
+	}
+	const AActor* Owner = GetOwner();
+	return Owner ? Owner->GetFName() : NAME_None;
+}
+
+bool UTelemetryTrackerComponent::IsPlayerTracker() const
+{
+	if (bIsPlayer)
+	{
+		return true;
+	}
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	return Pawn && Pawn->IsPlayerControlled();
+}
+
+bool UTelemetryTrackerComponent::IsAirborne() const
+{
+	const ACharacter* Character = Cast<ACharacter>(GetOwner());
+	return Character && Character->GetCharacterMovement() && Character->GetCharacterMovement()->IsFalling();
+}
+
+void UTelemetryTrackerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const UWorld* World = GetWorld();
+	if (UTelemetrySubsystem* Telemetry = World && World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UTelemetrySubsystem>() : nullptr)
+	{
+		Telemetry->RegisterTracker(this);
+	}
+}
+
+void UTelemetryTrackerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	const UWorld* World = GetWorld();
+	if (UTelemetrySubsystem* Telemetry = World && World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UTelemetrySubsystem>() : nullptr)
+	{
+		Telemetry->UnregisterTracker(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
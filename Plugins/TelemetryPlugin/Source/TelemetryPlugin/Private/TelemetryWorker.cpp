@@ -0,0 +1,1800 @@
+#include "TelemetryWorker.h"
+#include "TelemetryDispatcher.h"
+#include "TelemetryBinaryFormat.h"
+#include "TelemetryCompression.h"
+#include "TelemetrySpool.h"
+#include "TelemetryStreamTransport.h"
+#include "TelemetryJsonWriter.h"
+#include "TelemetryEventPolicy.h"
+#include "TelemetryStats.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Paths.h"
+#include "Misc/Base64.h"
+
+namespace
+{
+	/** event_type values as UTF-8, indexed by ETelemetryEventType */
+	const ANSICHAR* const EventTypeNames[] =
+	{
+		"session_start",
+		"session_end",
+		"run_start",
+		"run_end",
+		"position",
+		"input_received",
+		"damage",
+		"death",
+		"frame_performance",
+		"run_summary",
+		"heatmap",
+		"position_frame",
+		"input_span",
+		"delivery_report"
+	};
+
+	/** Connection failures and timeouts (0), 408, 429 and 5xx may succeed later - other errors will not */
+	bool IsRetryableResponse(int32 ResponseCode)
+	{
+		return ResponseCode == 0
+			|| ResponseCode == EHttpResponseCodes::RequestTimeout
+			|| ResponseCode == EHttpResponseCodes::TooManyRequests
+			|| ResponseCode >= EHttpResponseCodes::ServerError;
+	}
+}
+
+FTelemetryWorker::FTelemetryWorker(const FString& InMachineName, const TSharedPtr<FTelemetryEventPolicies, ESPMode::ThreadSafe>& InPolicies,
+	const TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe>& InDispatcher)
+	: Queue(QueueCapacity)
+	, MachineName(InMachineName)
+	, Policies(InPolicies)
+	, JitterStream(static_cast<int32>(FPlatformTime::Cycles()))
+	, LatencyTracker(MakeShared<FTelemetryLatencyTracker, ESPMode::ThreadSafe>())
+	, Dispatcher(InDispatcher)
+{
+	// Make sure HTTP is loaded here on the game thread, the worker only uses it
+	FHttpModule::Get();
+
+	RebuildEventPrefix();
+	WriteEventPrefix(SinkEventPrefix, FString());
+	LastFlushTime = FPlatformTime::Seconds();
+
+	bRegistered = true;
+	Dispatcher->Register(this);
+}
+
+FTelemetryWorker::~FTelemetryWorker()
+{
+	Shutdown();
+}
+
+bool FTelemetryWorker::Enqueue(const FTelemetryEventRecord& InRecord)
+{
+	// Stamped here rather than by every producer - this is as close to capture as they all share
+	FTelemetryEventRecord Record = InRecord;
+	Record.EngineFrame = static_cast<uint32>(GFrameCounter);
+	Record.CaptureTime = FPlatformTime::Seconds();
+
+	if (!Queue.TryEnqueue(Record))
+	{
+		if (!Record.IsSheddable())
+		{
+			// Lifecycle and outcome events are never dropped - take the allocating path instead
+			OverflowQueue.Enqueue(Record);
+			PendingEventCount.fetch_add(1, std::memory_order_relaxed);
+			INC_DWORD_STAT(STAT_TelemetryEventsEnqueued);
+			Dispatcher->Wake();
+			return true;
+		}
+
+		INC_DWORD_STAT(STAT_TelemetryEventsDropped);
+		ReleaseHeldPayloads(MakeArrayView(&Record, 1));
+
+		// Only warn on the first drop of a burst, the counter has the rest
+		if (DroppedEventCount.fetch_add(1, std::memory_order_relaxed) == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Event queue full (%u slots) - dropping events"), Queue.GetCapacity());
+		}
+		Dispatcher->Wake();
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_TelemetryEventsEnqueued);
+
+	// Only wake the worker once per batch - timed flushes use the wait timeout,
+	// and a backlog waiting on the collector is woken by upload completion
+	const int32 BatchSize = MaxBatchSize.load(std::memory_order_relaxed);
+	const int32 Pending = PendingEventCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	if (Pending >= BatchSize && Pending % BatchSize == 0)
+	{
+		Dispatcher->Wake();
+	}
+	return true;
+}
+
+void FTelemetryWorker::EnqueueSessionStart(const FTelemetryEventRecord& Record, const FString& InSessionID,
+	const TSharedRef<FTelemetryStringTable, ESPMode::ThreadSafe>& InSessionStrings)
+{
+	check(Record.Type == ETelemetryEventType::SessionStart);
+
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		Sessions.Add(Record.Name, FHeldSession{InSessionID, InSessionStrings});
+	}
+	Enqueue(Record);
+}
+
+void FTelemetryWorker::EnqueueFramePerformance(const FTelemetryEventRecord& Record, FTelemetryFramePerformance&& Performance)
+{
+	check(Record.Type == ETelemetryEventType::FramePerformance);
+
+	// Stored before the record is queued, so the worker always finds it
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		FramePerformances.Add(Record.Name, MoveTemp(Performance));
+	}
+	Enqueue(Record);
+}
+
+void FTelemetryWorker::EnqueueRunSummary(const FTelemetryEventRecord& Record, FTelemetryRunData&& Summary)
+{
+	check(Record.Type == ETelemetryEventType::RunSummary);
+
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		RunSummaries.Add(Record.Name, MoveTemp(Summary));
+	}
+	Enqueue(Record);
+}
+
+void FTelemetryWorker::EnqueueHeatmap(const FTelemetryEventRecord& Record, FTelemetryHeatmap&& Heatmap, ETelemetryHeatmapScope Scope)
+{
+	check(Record.Type == ETelemetryEventType::Heatmap);
+
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		Heatmaps.Add(Record.Name, FHeldHeatmap{MoveTemp(Heatmap), Scope});
+	}
+	Enqueue(Record);
+}
+
+bool FTelemetryWorker::EnqueuePositionFrame(const FTelemetryEventRecord& Record, FTelemetryPositionFrame&& Frame)
+{
+	check(Record.Type == ETelemetryEventType::PositionFrame);
+
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		PositionFrames.Add(Record.Name, MoveTemp(Frame));
+	}
+	return Enqueue(Record);
+}
+
+bool FTelemetryWorker::EnqueueInputSpan(const FTelemetryEventRecord& Record, FTelemetryInputSpan&& Span)
+{
+	check(Record.Type == ETelemetryEventType::InputSpan);
+
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		InputSpans.Add(Record.Name, MoveTemp(Span));
+	}
+	return Enqueue(Record);
+}
+
+void FTelemetryWorker::SetSinks(TArray<FTelemetrySinkEntry>&& InSinks, uint32 InHttpTypeMask)
+{
+	{
+		FScopeLock Lock(&SettingsLock);
+		PendingSinks = MoveTemp(InSinks);
+		PendingHttpTypeMask = InHttpTypeMask;
+	}
+	bSinksPending.store(true);
+	Dispatcher->Wake();
+}
+
+void FTelemetryWorker::SetStreamTransport(const TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe>& InStreamTransport)
+{
+	FScopeLock Lock(&SettingsLock);
+	if (StreamTransport && StreamTransport != InStreamTransport)
+	{
+		RetiredStreamTransports.Add(StreamTransport);
+	}
+	StreamTransport = InStreamTransport;
+}
+
+void FTelemetryWorker::RequestFlush()
+{
+	// Checked after the queue is drained, so everything enqueued before this call is included
+	bFlushRequested.store(true);
+	Dispatcher->Wake();
+}
+
+void FTelemetryWorker::Shutdown()
+{
+	if (!bRegistered)
+	{
+		return;
+	}
+
+	// Once unregistered the dispatcher thread no longer touches this worker
+	bRegistered = false;
+	Dispatcher->Unregister(this);
+
+	// Everything goes out on exit - it is spooled anyway, so the in-flight cap no longer matters
+	ProcessQueue();
+	EmitCoalesced(true);
+	FlushSinks();
+	FlushBatch(true);
+	SendDueRetries(true);
+	SendWaitingUploads(true);
+}
+
+void FTelemetryWorker::SetServerURL(const FString& InServerURL)
+{
+	FScopeLock Lock(&SettingsLock);
+	ServerURL = InServerURL;
+}
+
+void FTelemetryWorker::SetBatching(int32 InMaxBatchSize, float InFlushInterval, ETelemetryBatchFormat InBatchFormat)
+{
+	MaxBatchSize.store(FMath::Max(1, InMaxBatchSize));
+	FlushInterval.store(FMath::Max(0.0f, InFlushInterval));
+
+	// Records are serialized at flush time, so a format change applies to the whole next body
+	BatchFormat.store(InBatchFormat);
+
+	Dispatcher->Wake();
+}
+
+void FTelemetryWorker::SetCompression(ETelemetryCompression InCompression, int32 InMinCompressBytes)
+{
+	Compression.store(InCompression);
+	MinCompressBytes.store(FMath::Max(0, InMinCompressBytes));
+}
+
+FTelemetryCompressionStats FTelemetryWorker::GetCompressionStats() const
+{
+	FScopeLock Lock(&StatsLock);
+	return CompressionStats;
+}
+
+void FTelemetryWorker::SetSpool(bool bInEnabled, int64 InMaxBytes, const FString& InDirectory)
+{
+	{
+		FScopeLock Lock(&SettingsLock);
+		SpoolDirectory = InDirectory;
+	}
+	SpoolMaxBytes.store(FMath::Max<int64>(0, InMaxBytes));
+	bSpoolEnabled.store(bInEnabled);
+}
+
+void FTelemetryWorker::SetBackpressure(int32 InMaxInFlightRequests, int64 InMaxBacklogBytes)
+{
+	MaxInFlightRequests.store(FMath::Max(1, InMaxInFlightRequests));
+	MaxBacklogBytes.store(FMath::Max<int64>(0, InMaxBacklogBytes));
+	Dispatcher->Wake();
+}
+
+FTelemetryBackpressureStats FTelemetryWorker::GetBackpressureStats() const
+{
+	FTelemetryBackpressureStats Stats;
+	Stats.InFlightRequests = InFlightRequests.load(std::memory_order_relaxed);
+	Stats.InFlightBytes = InFlightBytes.load(std::memory_order_relaxed);
+	Stats.WaitingBatches = WaitingBatchCount.load(std::memory_order_relaxed);
+	Stats.BacklogEvents = PendingEventCount.load(std::memory_order_relaxed);
+	Stats.UploadedEvents = UploadedEventCount.load(std::memory_order_relaxed);
+	Stats.BacklogBytes = BacklogBytes.load(std::memory_order_relaxed);
+	Stats.ShedEvents = ShedEventCount.load(std::memory_order_relaxed);
+	Stats.DroppedEvents = DroppedEventCount.load(std::memory_order_relaxed);
+	Stats.RetriedUploads = RetriedUploadCount.load(std::memory_order_relaxed);
+	Stats.FailedUploads = FailedUploadCount.load(std::memory_order_relaxed);
+	Stats.BatchSize = CurrentBatchSize.load(std::memory_order_relaxed);
+	return Stats;
+}
+
+void FTelemetryWorker::SetDeliveryReportInterval(float InInterval)
+{
+	DeliveryReportInterval.store(FMath::Max(0.0f, InInterval));
+}
+
+void FTelemetryWorker::SetRetry(const FTelemetryRetrySettings& InRetry)
+{
+	FScopeLock Lock(&SettingsLock);
+	RetrySettings = InRetry;
+}
+
+void FTelemetryWorker::SetStringDictionary(bool bInEnabled)
+{
+	bStringDictionary.store(bInEnabled);
+}
+
+void FTelemetryWorker::SetWireFormat(ETelemetryWireFormat InWireFormat)
+{
+	WireFormat.store(InWireFormat);
+}
+
+double FTelemetryWorker::GetSecondsUntilNextTick() const
+{
+	double Remaining = GetSecondsUntilTimedFlush();
+	if (!PendingReplay.IsEmpty())
+	{
+		Remaining = Remaining < 0.0 ? ReplayInterval : FMath::Min(Remaining, ReplayInterval);
+	}
+	const double CoalesceRemaining = GetSecondsUntilCoalesceExpiry();
+	if (CoalesceRemaining >= 0.0)
+	{
+		Remaining = Remaining < 0.0 ? CoalesceRemaining : FMath::Min(Remaining, CoalesceRemaining);
+	}
+	const double RetryRemaining = GetSecondsUntilNextRetry();
+	if (RetryRemaining >= 0.0)
+	{
+		Remaining = Remaining < 0.0 ? RetryRemaining : FMath::Min(Remaining, RetryRemaining);
+	}
+	return Remaining;
+}
+
+void FTelemetryWorker::Tick()
+{
+	ProcessQueue();
+}
+
+void FTelemetryWorker::ProcessQueue()
+{
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryProcessQueue);
+
+	ApplyPendingSinks();
+
+	FTelemetryEventRecord Record;
+	while (Queue.Dequeue(Record))
+	{
+		AddRecord(Record);
+	}
+	while (OverflowQueue.Dequeue(Record))
+	{
+		AddRecord(Record);
+	}
+
+	const bool bFlush = bFlushRequested.exchange(false);
+	EmitCoalesced(bFlush);
+	EmitDeliveryReport(false);
+
+	// Retries and parked batches go first so uploads stay roughly in order
+	ProcessUploadResults();
+	SendDueRetries();
+	TakeStreamFallback();
+	SendWaitingUploads();
+
+	if (bFlush
+		|| GetSecondsUntilTimedFlush() == 0.0
+		|| PendingRecords.Num() >= MaxBatchSize.load(std::memory_order_relaxed))
+	{
+		FlushSinks();
+		FlushBatch();
+	}
+
+	ShedBacklog();
+	ReplaySpooledSegments();
+
+	BacklogBytes.store(GetBacklogBytes(), std::memory_order_relaxed);
+
+	SET_DWORD_STAT(STAT_TelemetryQueueDepth, PendingEventCount.load(std::memory_order_relaxed));
+	SET_DWORD_STAT(STAT_TelemetryUploadsInFlight, Dispatcher->GetInFlightRequests());
+}
+
+void FTelemetryWorker::AddRecord(const FTelemetryEventRecord& Record)
+{
+	if (TryCoalesce(Record))
+	{
+		return;
+	}
+
+	// Bursts stay inside their run, and damage lands before the death it caused
+	if (!Record.IsSheddable() && Record.Type != ETelemetryEventType::Damage)
+	{
+		EmitCoalesced(true);
+	}
+
+	// A batch never spans sessions - binary batches carry the session ID once in the header
+	if (Record.Type == ETelemetryEventType::SessionStart)
+	{
+		FlushBatch(true);
+		FlushSinks();
+		{
+			FScopeLock Lock(&HeldPayloadLock);
+			if (const FHeldSession* Session = Sessions.Find(Record.Name))
+			{
+				SessionID = Session->SessionID;
+				SessionStrings = Session->Strings;
+			}
+		}
+		RunID.Reset();
+		RebuildEventPrefix();
+
+		SinkRunID.Reset();
+		WriteEventPrefix(SinkEventPrefix, SinkRunID);
+		for (const FTelemetrySinkEntry& Entry : Sinks)
+		{
+			Entry.Sink->BeginSession(MachineName, SessionID, SessionStrings);
+		}
+
+		// IDs are only meaningful within the session that defined them
+		StringIDs.Reset();
+		SessionStringIDs.Reset();
+
+		EventSequence = 0;
+		SessionStartTime = Record.CaptureTime;
+		LastDeliveryReportTime = Record.CaptureTime;
+		bSessionActive = true;
+
+		// Whatever earlier sessions could not deliver is sent again in the background
+		if (FTelemetrySpool* ActiveSpool = GetSpool())
+		{
+			PendingReplay.Append(ActiveSpool->ClaimLeftoverSegments());
+			if (!PendingReplay.IsEmpty())
+			{
+				UE_LOG(LogTemp, Log, TEXT("[Telemetry] Replaying %d spooled segments"), PendingReplay.Num());
+			}
+		}
+	}
+
+	// Each session closes with what was measured so far - later answers go into the next session's first report
+	if (Record.Type == ETelemetryEventType::SessionEnd)
+	{
+		EmitDeliveryReport(true);
+		bSessionActive = false;
+	}
+
+	AddToBatch(Record);
+}
+
+void FTelemetryWorker::AddToBatch(const FTelemetryEventRecord& InRecord)
+{
+	// Numbered only once it is certain to be emitted, so sampled or coalesced events leave no gap
+	FTelemetryEventRecord Record = InRecord;
+	Record.Sequence = ++EventSequence;
+	LastFrame = Record.Frame;
+	LastGameTime = Record.GameTime;
+
+	WriteToSinks(Record);
+
+	if (!FTelemetrySinkEntry::Accepts(HttpTypeMask, Record.Type))
+	{
+		// Not uploaded - the sinks were its only destination
+		ReleaseHeldPayloads(MakeArrayView(&Record, 1));
+		PendingEventCount.fetch_sub(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// Numbered already, so a refused record shows up as a sequence gap like any other shed event
+	if (RefuseSheddable(Record))
+	{
+		return;
+	}
+
+	PendingRecords.Add(Record);
+
+	if (PendingRecords.Num() >= MaxBatchSize.load(std::memory_order_relaxed))
+	{
+		FlushBatch();
+	}
+}
+
+void FTelemetryWorker::WriteToSinks(const FTelemetryEventRecord& Record)
+{
+	if (Sinks.IsEmpty())
+	{
+		return;
+	}
+
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryWriteSinks);
+
+	// Same run tracking as BuildJsonBody, but at batching time
+	if (Record.Type == ETelemetryEventType::RunStart)
+	{
+		SinkRunID = GetSessionString(Record.StringIndex);
+		WriteEventPrefix(SinkEventPrefix, SinkRunID);
+	}
+
+	bool bJsonWritten = false;
+	for (const FTelemetrySinkEntry& Entry : Sinks)
+	{
+		if (!Entry.Accepts(Record.Type))
+		{
+			continue;
+		}
+
+		if (Entry.Sink->GetWireFormat() != ETelemetryWireFormat::Json)
+		{
+			Entry.Sink->Write(Record, TConstArrayView<uint8>());
+			continue;
+		}
+
+		// Names are always inline - the string dictionary belongs to the upload stream
+		if (!bJsonWritten)
+		{
+			SinkScratch.Reset();
+			FTelemetryJsonWriter Writer(SinkScratch);
+			WriteEventJson(Writer, Record, INDEX_NONE, SinkEventPrefix);
+			bJsonWritten = true;
+		}
+		Entry.Sink->Write(Record, SinkScratch);
+	}
+
+	if (Record.Type == ETelemetryEventType::RunEnd)
+	{
+		SinkRunID.Reset();
+		WriteEventPrefix(SinkEventPrefix, SinkRunID);
+	}
+}
+
+void FTelemetryWorker::FlushSinks()
+{
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryWriteSinks);
+
+	for (const FTelemetrySinkEntry& Entry : Sinks)
+	{
+		Entry.Sink->Flush();
+	}
+}
+
+void FTelemetryWorker::ApplyPendingSinks()
+{
+	if (!bSinksPending.exchange(false))
+	{
+		return;
+	}
+
+	FlushSinks();
+
+	FScopeLock Lock(&SettingsLock);
+	Sinks = MoveTemp(PendingSinks);
+	HttpTypeMask = PendingHttpTypeMask;
+	for (const FTelemetrySinkEntry& Entry : Sinks)
+	{
+		Entry.Sink->BeginSession(MachineName, SessionID, SessionStrings);
+	}
+}
+
+bool FTelemetryWorker::TryCoalesce(const FTelemetryEventRecord& Record)
+{
+	if (!FTelemetryEventPolicies::HasPolicy(Record.Type))
+	{
+		return false;
+	}
+
+	const float Window = Policies ? Policies->GetCoalesceWindow(Record.Type) : 0.0f;
+	FCoalesceSlot& Slot = CoalesceSlots[static_cast<uint8>(Record.Type)];
+
+	if (Window <= 0.0f)
+	{
+		// Window switched off at runtime - release what was held
+		if (Slot.bActive)
+		{
+			Slot.bActive = false;
+			AddToBatch(Slot.Record);
+		}
+		return false;
+	}
+
+	// Only the same action / damage source merges; positions always do (they carry neither)
+	if (Slot.bActive && Slot.Record.Name == Record.Name && Slot.Record.StringIndex == Record.StringIndex)
+	{
+		switch (Record.Type)
+		{
+		case ETelemetryEventType::Position:
+			Slot.Record = Record;
+			break;
+		case ETelemetryEventType::Damage:
+			Slot.Record.DamageAmount += Record.DamageAmount;
+			Slot.Record.HealthAfter = Record.HealthAfter;
+			Slot.Record.Position = Record.Position;
+			break;
+		default:
+			// Repeated input keeps the first press
+			break;
+		}
+
+		PendingEventCount.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	if (Slot.bActive)
+	{
+		AddToBatch(Slot.Record);
+	}
+
+	Slot.Record = Record;
+	Slot.WindowEnd = FPlatformTime::Seconds() + Window;
+	Slot.bActive = true;
+	return true;
+}
+
+void FTelemetryWorker::EmitCoalesced(bool bAll)
+{
+	const double Now = FPlatformTime::Seconds();
+	for (FCoalesceSlot& Slot : CoalesceSlots)
+	{
+		if (Slot.bActive && (bAll || Slot.WindowEnd <= Now))
+		{
+			Slot.bActive = false;
+			AddToBatch(Slot.Record);
+		}
+	}
+}
+
+double FTelemetryWorker::GetSecondsUntilCoalesceExpiry() const
+{
+	double Earliest = -1.0;
+	const double Now = FPlatformTime::Seconds();
+	for (const FCoalesceSlot& Slot : CoalesceSlots)
+	{
+		if (Slot.bActive)
+		{
+			const double Remaining = FMath::Max(0.0, Slot.WindowEnd - Now);
+			Earliest = Earliest < 0.0 ? Remaining : FMath::Min(Earliest, Remaining);
+		}
+	}
+	return Earliest;
+}
+
+void FTelemetryWorker::EmitDeliveryReport(bool bForce)
+{
+	const float Interval = DeliveryReportInterval.load(std::memory_order_relaxed);
+	const double Now = FPlatformTime::Seconds();
+	if (Interval <= 0.0f || !bSessionActive
+		|| (!bForce && Now < LastDeliveryReportTime + Interval)
+		|| !LatencyTracker->HasSamples())
+	{
+		return;
+	}
+
+	FTelemetryDeliveryReport Report = LatencyTracker->TakeReport();
+	Report.Interval = Now - LastDeliveryReportTime;
+	Report.LastSequence = EventSequence;
+	Report.ShedEvents = ShedEventCount.load(std::memory_order_relaxed);
+	Report.DroppedEvents = DroppedEventCount.load(std::memory_order_relaxed);
+	LastDeliveryReportTime = Now;
+
+	// Made by the worker itself, so it borrows the latest event's frame and game time
+	FTelemetryEventRecord Record;
+	Record.Type = ETelemetryEventType::DeliveryReport;
+	Record.Name = FName(TEXT("delivery_report"), ++DeliveryReportSerial);
+	Record.Frame = LastFrame;
+	Record.GameTime = LastGameTime;
+	Record.EngineFrame = static_cast<uint32>(GFrameCounter);
+	Record.CaptureTime = Now;
+
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		DeliveryReports.Add(Record.Name, MoveTemp(Report));
+	}
+	PendingEventCount.fetch_add(1, std::memory_order_relaxed);
+	AddToBatch(Record);
+}
+
+void FTelemetryWorker::ShedBacklog()
+{
+	const int64 Budget = MaxBacklogBytes.load(std::memory_order_relaxed);
+	if (Budget <= 0)
+	{
+		return;
+	}
+
+	if (NumRefusedEvents > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Collector behind (%lld KB of bodies waiting) - refused %d new low-priority events (%lld shed in total)"),
+			GetEncodedBacklogBytes() / 1024, NumRefusedEvents, ShedEventCount.load(std::memory_order_relaxed));
+		NumRefusedEvents = 0;
+	}
+
+	// Parked and retrying bodies are already encoded - only held-back records can be shed to make room
+	const int64 RecordBudget = Budget - GetEncodedBacklogBytes();
+	if (RecordBudget <= 0)
+	{
+		// The batch is kept as it is - AddToBatch refuses new sheddable records until the bodies drain
+		return;
+	}
+
+	const int64 RecordBytes = PendingRecords.Num() * static_cast<int64>(sizeof(FTelemetryEventRecord));
+	if (RecordBytes <= RecordBudget)
+	{
+		return;
+	}
+
+	// Shed down to 3/4 of what the bodies leave of the budget, so this does not run again for every new event
+	const int64 Excess = RecordBytes - RecordBudget * 3 / 4;
+	const int32 NumToShed = static_cast<int32>(FMath::DivideAndRoundUp<int64>(Excess, sizeof(FTelemetryEventRecord)));
+	int32 NumShed = 0;
+
+	// Position frames first, then positions, then input, oldest first within each
+	for (const ETelemetryEventType ShedType : {ETelemetryEventType::PositionFrame, ETelemetryEventType::Position,
+		ETelemetryEventType::InputReceived, ETelemetryEventType::InputSpan})
+	{
+		int32 WriteIndex = 0;
+		for (int32 ReadIndex = 0; ReadIndex < PendingRecords.Num(); ++ReadIndex)
+		{
+			if (NumShed < NumToShed && PendingRecords[ReadIndex].Type == ShedType)
+			{
+				ReleaseHeldPayloads(MakeArrayView(&PendingRecords[ReadIndex], 1));
+				++NumShed;
+				continue;
+			}
+			if (WriteIndex != ReadIndex)
+			{
+				PendingRecords[WriteIndex] = PendingRecords[ReadIndex];
+			}
+			++WriteIndex;
+		}
+		PendingRecords.SetNum(WriteIndex, EAllowShrinking::No);
+	}
+
+	if (NumShed > 0)
+	{
+		PendingEventCount.fetch_sub(NumShed, std::memory_order_relaxed);
+		INC_DWORD_STAT_BY(STAT_TelemetryEventsDropped, NumShed);
+		const int64 TotalShed = ShedEventCount.fetch_add(NumShed, std::memory_order_relaxed) + NumShed;
+		UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Collector behind (%d uploads in flight, %lld KB backlog) - shed %d low-priority events (%lld total)"),
+			InFlightRequests.load(std::memory_order_relaxed), (RecordBytes + GetEncodedBacklogBytes()) / 1024, NumShed, TotalShed);
+	}
+}
+
+bool FTelemetryWorker::RefuseSheddable(const FTelemetryEventRecord& Record)
+{
+	const int64 Budget = MaxBacklogBytes.load(std::memory_order_relaxed);
+	if (Budget <= 0 || !Record.IsSheddable() || GetEncodedBacklogBytes() < Budget)
+	{
+		return false;
+	}
+
+	ReleaseHeldPayloads(MakeArrayView(&Record, 1));
+	PendingEventCount.fetch_sub(1, std::memory_order_relaxed);
+	INC_DWORD_STAT(STAT_TelemetryEventsDropped);
+	ShedEventCount.fetch_add(1, std::memory_order_relaxed);
+	++NumRefusedEvents;
+	return true;
+}
+
+int64 FTelemetryWorker::GetBacklogBytes() const
+{
+	return PendingRecords.Num() * static_cast<int64>(sizeof(FTelemetryEventRecord)) + GetEncodedBacklogBytes();
+}
+
+int64 FTelemetryWorker::GetEncodedBacklogBytes() const
+{
+	return WaitingUploadBytes + RetryUploadBytes;
+}
+
+void FTelemetryWorker::ReplaySpooledSegments()
+{
+	if (PendingReplay.IsEmpty())
+	{
+		return;
+	}
+
+	FTelemetrySpool* ActiveSpool = GetSpool();
+	const FString URL = GetServerURL();
+	if (!ActiveSpool || URL.IsEmpty())
+	{
+		return;
+	}
+
+	// Trickle replays out so a large backlog does not compete with live events for upload slots
+	if (!HasUploadSlot())
+	{
+		return;
+	}
+	const int32 FreeSlots = MaxInFlightRequests.load(std::memory_order_relaxed) - Dispatcher->GetInFlightRequests();
+	const int32 NumToSend = FMath::Min3(PendingReplay.Num(), ReplaySegmentsPerPass, FreeSlots);
+	for (int32 Index = 0; Index < NumToSend; ++Index)
+	{
+		FTelemetrySpoolSegment Segment;
+		if (ActiveSpool->Read(PendingReplay[Index], Segment))
+		{
+			INC_DWORD_STAT(STAT_TelemetryUploadsRetried);
+			FWaitingUpload Upload;
+			Upload.ContentType = MoveTemp(Segment.ContentType);
+			Upload.ContentEncoding = MoveTemp(Segment.ContentEncoding);
+			Upload.Body = MoveTemp(Segment.Body);
+			Upload.IdempotencyKey = MakeIdempotencyKey(Segment.Path);
+			Upload.SegmentPath = MoveTemp(Segment.Path);
+			SendBody(URL, MoveTemp(Upload));
+		}
+	}
+	PendingReplay.RemoveAt(0, NumToSend);
+}
+
+void FTelemetryWorker::FlushBatch(bool bForce)
+{
+	LastFlushTime = FPlatformTime::Seconds();
+
+	if (PendingRecords.IsEmpty() || (!bForce && !HasUploadSlot()))
+	{
+		return;
+	}
+
+	const FString URL = GetServerURL();
+	if (URL.IsEmpty())
+	{
+		const int32 NumEvents = PendingRecords.Num();
+		UE_LOG(LogTemp, Error, TEXT("[Telemetry] Dropping %d queued events - server URL not configured"), NumEvents);
+		ReleaseHeldPayloads(PendingRecords);
+		PendingRecords.Reset();
+		PendingEventCount.fetch_sub(NumEvents, std::memory_order_relaxed);
+		INC_DWORD_STAT_BY(STAT_TelemetryEventsDropped, NumEvents);
+		return;
+	}
+
+	const int32 BatchSize = GetBatchSize();
+	int32 NumFlushed = 0;
+	while (NumFlushed < PendingRecords.Num())
+	{
+		// Hold events back while the collector is behind - they can still be shed by priority
+		if (!bForce && !HasUploadSlot())
+		{
+			break;
+		}
+
+		const int32 NumEvents = FMath::Min(PendingRecords.Num() - NumFlushed, BatchSize);
+		EncodeAndUpload(URL, MakeArrayView(PendingRecords.GetData() + NumFlushed, NumEvents));
+		NumFlushed += NumEvents;
+	}
+
+	if (NumFlushed > 0)
+	{
+		// Counted before they leave the backlog, so a reader that sees it empty sees every upload
+		PendingRecords.RemoveAt(0, NumFlushed, EAllowShrinking::No);
+		UploadedEventCount.fetch_add(NumFlushed, std::memory_order_relaxed);
+		PendingEventCount.fetch_sub(NumFlushed, std::memory_order_relaxed);
+		INC_DWORD_STAT_BY(STAT_TelemetryEventsSent, NumFlushed);
+	}
+}
+
+void FTelemetryWorker::EncodeAndUpload(const FString& URL, TConstArrayView<FTelemetryEventRecord> Records)
+{
+	// Encoded into a reused buffer - the only per-batch allocation is the request's own copy
+	BodyScratch.Reset();
+	const TCHAR* ContentType;
+	const bool bBinary = WireFormat.load() == ETelemetryWireFormat::Binary;
+
+	// Held payloads of a binary batch go up in the side body, so they are timed with it
+	FTelemetryBatchTiming Timing;
+	Timing.CaptureTimes.Reserve(Records.Num());
+	for (const FTelemetryEventRecord& Record : Records)
+	{
+		if (!bBinary || !Record.HasHeldPayload())
+		{
+			Timing.CaptureTimes.Add(Record.CaptureTime);
+		}
+	}
+	Timing.SerializeStart = FPlatformTime::Seconds();
+
+	{
+		TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetrySerialize);
+
+		if (bBinary)
+		{
+			TelemetryBinaryFormat::EncodeBatch(MachineName, SessionID, SessionStrings.Get(), Records, BodyScratch);
+			ContentType = TelemetryBinaryFormat::ContentType;
+		}
+		else
+		{
+			const ETelemetryBatchFormat Format = BatchFormat.load();
+			BuildJsonBody(Format, Records, BodyScratch);
+
+			ContentType = Format == ETelemetryBatchFormat::NDJson ? TEXT("application/x-ndjson") : TEXT("application/json");
+		}
+	}
+
+	UploadBody(URL, ContentType, MoveTemp(Timing));
+
+	// Binary records are fixed-size, so held payloads go up as a JSON body of their own,
+	// one per run so position frames at the tracker rate do not turn into one request each
+	if (bBinary)
+	{
+		auto UploadSideRecords = [this, &URL]()
+		{
+			if (!SideRecords.IsEmpty())
+			{
+				FTelemetryBatchTiming SideTiming;
+				for (const FTelemetryEventRecord& SideRecord : SideRecords)
+				{
+					SideTiming.CaptureTimes.Add(SideRecord.CaptureTime);
+				}
+				SideTiming.SerializeStart = FPlatformTime::Seconds();
+				BodyScratch.Reset();
+				BuildJsonBody(ETelemetryBatchFormat::JsonArray, SideRecords, BodyScratch);
+				UploadBody(URL, TEXT("application/json"), MoveTemp(SideTiming));
+				SideRecords.Reset();
+			}
+		};
+
+		for (const FTelemetryEventRecord& Record : Records)
+		{
+			// Follow runs the way BuildJsonBody does, so the side bodies carry the right run_id
+			if (Record.Type == ETelemetryEventType::RunStart)
+			{
+				UploadSideRecords();
+				RunID = GetSessionString(Record.StringIndex);
+				RebuildEventPrefix();
+			}
+			else if (Record.Type == ETelemetryEventType::RunEnd)
+			{
+				UploadSideRecords();
+				RunID.Reset();
+				RebuildEventPrefix();
+			}
+			else if (Record.HasHeldPayload())
+			{
+				SideRecords.Add(Record);
+			}
+		}
+		UploadSideRecords();
+	}
+
+	ReleaseHeldPayloads(Records);
+}
+
+void FTelemetryWorker::UploadBody(const FString& URL, const TCHAR* ContentType, FTelemetryBatchTiming&& Timing)
+{
+	const int32 NumEvents = Timing.CaptureTimes.Num();
+	const int32 UncompressedSize = BodyScratch.Num();
+	const TCHAR* ContentEncoding = CompressBody(BodyScratch);
+	Timing.SerializeEnd = FPlatformTime::Seconds();
+
+	UE_LOG(LogTemp, Verbose, TEXT("[Telemetry] Flushing batch of %d events (%d bytes, %d on the wire)"),
+		NumEvents, UncompressedSize, BodyScratch.Num());
+
+	// Persist before upload so the batch survives a dead collector or a crash
+	FString SegmentPath;
+	if (FTelemetrySpool* ActiveSpool = GetSpool())
+	{
+		SegmentPath = ActiveSpool->Write(SessionID, ContentType, ContentEncoding, BodyScratch);
+	}
+
+	const FString IdempotencyKey = MakeIdempotencyKey(SegmentPath);
+
+	// A connected stream takes the body as a frame - no request, no upload slot
+	if (const TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> Stream = GetStreamTransport())
+	{
+		if (Stream->Send(ContentType, ContentEncoding, BodyScratch, SegmentPath.IsEmpty() ? nullptr : Spool, SegmentPath,
+			IdempotencyKey, Timing, LatencyTracker))
+		{
+			return;
+		}
+	}
+
+	FWaitingUpload Upload;
+	Upload.ContentType = ContentType;
+	Upload.ContentEncoding = ContentEncoding ? ContentEncoding : TEXT("");
+	Upload.Body = BodyScratch;
+	Upload.SegmentPath = MoveTemp(SegmentPath);
+	Upload.IdempotencyKey = IdempotencyKey;
+	Upload.Timing = MoveTemp(Timing);
+
+	if (HasUploadSlot())
+	{
+		SendBody(URL, MoveTemp(Upload));
+		return;
+	}
+
+	WaitingUploadBytes += Upload.Body.Num();
+	WaitingUploads.Add(MoveTemp(Upload));
+	WaitingBatchCount.store(WaitingUploads.Num(), std::memory_order_relaxed);
+}
+
+void FTelemetryWorker::ReleaseHeldPayloads(TConstArrayView<FTelemetryEventRecord> Records)
+{
+	for (const FTelemetryEventRecord& Record : Records)
+	{
+		if (!Record.HasHeldPayload() && !Record.HasHeldID())
+		{
+			continue;
+		}
+
+		FScopeLock Lock(&HeldPayloadLock);
+		switch (Record.Type)
+		{
+		case ETelemetryEventType::SessionStart:     Sessions.Remove(Record.Name); break;
+		case ETelemetryEventType::FramePerformance: FramePerformances.Remove(Record.Name); break;
+		case ETelemetryEventType::RunSummary:       RunSummaries.Remove(Record.Name); break;
+		case ETelemetryEventType::PositionFrame:    PositionFrames.Remove(Record.Name); break;
+		case ETelemetryEventType::InputSpan:        InputSpans.Remove(Record.Name); break;
+		case ETelemetryEventType::DeliveryReport:   DeliveryReports.Remove(Record.Name); break;
+		default:                                    Heatmaps.Remove(Record.Name); break;
+		}
+	}
+}
+
+void FTelemetryWorker::SendWaitingUploads(bool bIgnoreLimit)
+{
+	if (WaitingUploads.IsEmpty())
+	{
+		return;
+	}
+
+	const FString URL = GetServerURL();
+	const int32 MaxInFlight = MaxInFlightRequests.load(std::memory_order_relaxed);
+
+	int32 NumSent = 0;
+	while (NumSent < WaitingUploads.Num()
+		&& (bIgnoreLimit || Dispatcher->GetInFlightRequests() < MaxInFlight))
+	{
+		FWaitingUpload& Upload = WaitingUploads[NumSent++];
+		WaitingUploadBytes -= Upload.Body.Num();
+		SendBody(URL, MoveTemp(Upload));
+	}
+
+	WaitingUploads.RemoveAt(0, NumSent, EAllowShrinking::No);
+	WaitingBatchCount.store(WaitingUploads.Num(), std::memory_order_relaxed);
+}
+
+bool FTelemetryWorker::HasUploadSlot() const
+{
+	return WaitingUploads.IsEmpty()
+		&& Dispatcher->GetInFlightRequests() < MaxInFlightRequests.load(std::memory_order_relaxed);
+}
+
+void FTelemetryWorker::OnUploadComplete(int64 BodyBytes, FUploadResult&& Result)
+{
+	// Queued before the slot is released, so the worker sees the outcome when it wakes for the slot
+	UploadResults.Enqueue(MoveTemp(Result));
+
+	InFlightRequests.fetch_sub(1, std::memory_order_relaxed);
+	InFlightBytes.fetch_sub(BodyBytes, std::memory_order_relaxed);
+}
+
+void FTelemetryWorker::ProcessUploadResults()
+{
+	if (UploadResults.IsEmpty())
+	{
+		return;
+	}
+
+	const FTelemetryRetrySettings Settings = GetRetrySettings();
+	const int32 MaxSize = MaxBatchSize.load(std::memory_order_relaxed);
+	const int32 MinSize = FMath::Clamp(Settings.MinBatchSize, 1, MaxSize);
+	const double Now = FPlatformTime::Seconds();
+
+	FUploadResult Result;
+	while (UploadResults.Dequeue(Result))
+	{
+		// AIMD - creep up while the collector keeps up, halve as soon as it struggles
+		const bool bSlow = Settings.SlowResponseMs > 0.0f && Result.RoundTripMs > Settings.SlowResponseMs;
+		const int32 BatchSize = GetBatchSize();
+		if (Result.bAccepted)
+		{
+			RetryTokens = FMath::Min(MaxRetryTokens, RetryTokens + Settings.RetryBudgetRatio);
+		}
+		AdaptiveBatchSize = Result.bAccepted && !bSlow
+			? FMath::Min(MaxSize, BatchSize + FMath::Max(1, MaxSize / 10))
+			: FMath::Max(MinSize, BatchSize / 2);
+
+		if (!Result.bRetry)
+		{
+			continue;
+		}
+
+		FWaitingUpload& Upload = Result.Upload;
+		if (Upload.Attempt >= Settings.MaxRetries || RetryTokens < 1.0f)
+		{
+			// Spooled bodies stay on disk and go out again with the next session's replay
+			if (Spool && !Upload.SegmentPath.IsEmpty())
+			{
+				Spool->Complete(Upload.SegmentPath, false);
+			}
+			LatencyTracker->AddBatch(Upload.Timing, Now, false);
+			FailedUploadCount.fetch_add(1, std::memory_order_relaxed);
+			INC_DWORD_STAT(STAT_TelemetryUploadsFailed);
+			UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Upload %s failed after %d retries (%s) - %s"),
+				*Upload.IdempotencyKey, Upload.Attempt,
+				Upload.Attempt >= Settings.MaxRetries ? TEXT("retry limit") : TEXT("retry budget spent"),
+				Upload.SegmentPath.IsEmpty() ? TEXT("events lost") : TEXT("kept in the spool"));
+			continue;
+		}
+
+		// Full jitter - anywhere up to the exponential delay, so clients that failed together spread out
+		RetryTokens -= 1.0f;
+		const float Backoff = FMath::Min(Settings.MaxDelay, Settings.BaseDelay * FMath::Pow(2.0f, static_cast<float>(Upload.Attempt)));
+		const double Delay = FMath::Max<double>(JitterStream.FRandRange(0.0f, Backoff), FMath::Min<double>(Result.RetryAfter, Settings.MaxDelay));
+		Upload.RetryTime = Now + Delay;
+		++Upload.Attempt;
+
+		UE_LOG(LogTemp, Verbose, TEXT("[Telemetry] Upload %s failed - retry %d in %.2fs"), *Upload.IdempotencyKey, Upload.Attempt, Delay);
+		RetryUploadBytes += Upload.Body.Num();
+		RetryUploads.Add(MoveTemp(Upload));
+	}
+
+	CurrentBatchSize.store(GetBatchSize(), std::memory_order_relaxed);
+	SET_DWORD_STAT(STAT_TelemetryBatchSize, GetBatchSize());
+}
+
+void FTelemetryWorker::SendDueRetries(bool bIgnoreLimit)
+{
+	if (RetryUploads.IsEmpty())
+	{
+		return;
+	}
+
+	const FString URL = GetServerURL();
+	const double Now = FPlatformTime::Seconds();
+	const int32 MaxInFlight = MaxInFlightRequests.load(std::memory_order_relaxed);
+
+	for (int32 Index = 0; Index < RetryUploads.Num();)
+	{
+		if (!bIgnoreLimit && (RetryUploads[Index].RetryTime > Now || Dispatcher->GetInFlightRequests() >= MaxInFlight))
+		{
+			++Index;
+			continue;
+		}
+
+		FWaitingUpload Upload = MoveTemp(RetryUploads[Index]);
+		RetryUploads.RemoveAt(Index, EAllowShrinking::No);
+		RetryUploadBytes -= Upload.Body.Num();
+
+		INC_DWORD_STAT(STAT_TelemetryUploadsRetried);
+		RetriedUploadCount.fetch_add(1, std::memory_order_relaxed);
+		SendBody(URL, MoveTemp(Upload));
+	}
+}
+
+double FTelemetryWorker::GetSecondsUntilNextRetry() const
+{
+	if (RetryUploads.IsEmpty())
+	{
+		return -1.0;
+	}
+
+	double Earliest = RetryUploads[0].RetryTime;
+	for (const FWaitingUpload& Upload : RetryUploads)
+	{
+		Earliest = FMath::Min(Earliest, Upload.RetryTime);
+	}
+	return FMath::Max(0.0, Earliest - FPlatformTime::Seconds());
+}
+
+int32 FTelemetryWorker::GetBatchSize() const
+{
+	return FMath::Clamp(AdaptiveBatchSize, 1, MaxBatchSize.load(std::memory_order_relaxed));
+}
+
+FString FTelemetryWorker::MakeIdempotencyKey(const FString& SegmentPath)
+{
+	return SegmentPath.IsEmpty()
+		? FString::Printf(TEXT("%s-%u"), *SessionID, ++UploadSerial)
+		: FPaths::GetBaseFilename(SegmentPath);
+}
+
+void FTelemetryWorker::SendBody(const FString& URL, FWaitingUpload&& Upload)
+{
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryDispatch);
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(URL);
+	Request->SetVerb(TEXT("POST"));
+	Request->SetTimeout(RequestTimeout);
+	Request->SetHeader(TEXT("Content-Type"), Upload.ContentType);
+	if (!Upload.ContentEncoding.IsEmpty())
+	{
+		Request->SetHeader(TEXT("Content-Encoding"), Upload.ContentEncoding);
+	}
+	if (!Upload.IdempotencyKey.IsEmpty())
+	{
+		Request->SetHeader(TEXT("Idempotency-Key"), Upload.IdempotencyKey);
+	}
+	if (Upload.Attempt > 0)
+	{
+		Request->SetHeader(TEXT("X-Telemetry-Attempt"), LexToString(Upload.Attempt));
+	}
+	const int64 BodyBytes = Upload.Body.Num();
+	Request->SetContent(MoveTemp(Upload.Body));
+
+	InFlightRequests.fetch_add(1, std::memory_order_relaxed);
+	InFlightBytes.fetch_add(BodyBytes, std::memory_order_relaxed);
+	Dispatcher->OnUploadStarted();
+	INC_DWORD_STAT_BY(STAT_TelemetryBytesSent, static_cast<uint32>(BodyBytes));
+
+	// Complete straight from the HTTP thread - the spool outlives this worker if needed
+	Request->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+	Upload.Timing.SendTime = FPlatformTime::Seconds();
+	Request->OnProcessRequestComplete().BindLambda(
+		[WeakWorker = AsWeak(), DispatcherRef = Dispatcher, SpoolRef = Spool, Latency = LatencyTracker, BodyBytes, Upload = MoveTemp(Upload)](FHttpRequestPtr CompletedRequest, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+		{
+			const double ResponseTime = FPlatformTime::Seconds();
+			FUploadResult Result;
+			Result.RoundTripMs = (ResponseTime - Upload.Timing.SendTime) * 1000.0;
+			SET_FLOAT_STAT(STAT_TelemetryRequestLatency, Result.RoundTripMs);
+
+			const int32 ResponseCode = bConnectedSuccessfully && Response.IsValid() ? Response->GetResponseCode() : 0;
+			Result.bAccepted = EHttpResponseCodes::IsOk(ResponseCode);
+
+			const TSharedPtr<FTelemetryWorker, ESPMode::ThreadSafe> Worker = WeakWorker.Pin();
+			if (!Result.bAccepted && IsRetryableResponse(ResponseCode) && Worker && CompletedRequest.IsValid())
+			{
+				// The worker decides whether to retry - until then the spool segment stays in flight
+				Result.bRetry = true;
+				Result.RetryAfter = Response.IsValid() ? FCString::Atod(*Response->GetHeader(TEXT("Retry-After"))) : 0.0;
+				Result.Upload = Upload;
+				Result.Upload.Body = CompletedRequest->GetContent();
+				Worker->OnUploadComplete(BodyBytes, MoveTemp(Result));
+				DispatcherRef->OnUploadFinished();
+				return;
+			}
+
+			// A batch the collector refuses outright would be refused on every replay, so it is dropped
+			const bool bRejected = !Result.bAccepted && !IsRetryableResponse(ResponseCode);
+			if (bRejected)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[Telemetry] Collector rejected upload %s (%d) - dropped"), *Upload.IdempotencyKey, ResponseCode);
+			}
+			if (SpoolRef && !Upload.SegmentPath.IsEmpty())
+			{
+				SpoolRef->Complete(Upload.SegmentPath, Result.bAccepted || bRejected);
+			}
+			Latency->AddBatch(Upload.Timing, ResponseTime, Result.bAccepted);
+
+			if (Worker)
+			{
+				Worker->OnUploadComplete(BodyBytes, MoveTemp(Result));
+			}
+			DispatcherRef->OnUploadFinished();
+		});
+
+	Request->ProcessRequest();
+}
+
+FString FTelemetryWorker::GetServerURL() const
+{
+	FScopeLock Lock(&SettingsLock);
+	return ServerURL;
+}
+
+FTelemetryRetrySettings FTelemetryWorker::GetRetrySettings() const
+{
+	FScopeLock Lock(&SettingsLock);
+	return RetrySettings;
+}
+
+TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> FTelemetryWorker::GetStreamTransport() const
+{
+	FScopeLock Lock(&SettingsLock);
+	return StreamTransport;
+}
+
+void FTelemetryWorker::TakeStreamFallback()
+{
+	TArray<TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe>, TInlineAllocator<2>> Streams;
+	{
+		FScopeLock Lock(&SettingsLock);
+		Streams.Append(RetiredStreamTransports);
+		RetiredStreamTransports.Reset();
+		if (StreamTransport)
+		{
+			Streams.Add(StreamTransport);
+		}
+	}
+
+	// Already spooled and framed in order, so they queue behind any parked POSTs
+	FTelemetryStreamFrame Frame;
+	for (const TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe>& Stream : Streams)
+	{
+		while (Stream->TakeFallback(Frame))
+		{
+			FWaitingUpload Upload;
+			Upload.ContentType = Frame.ContentType;
+			Upload.ContentEncoding = Frame.ContentEncoding ? Frame.ContentEncoding : TEXT("");
+			Upload.Body = Frame.TakeBody();
+			Upload.SegmentPath = MoveTemp(Frame.SegmentPath);
+			Upload.IdempotencyKey = MoveTemp(Frame.IdempotencyKey);
+			Upload.Timing = MoveTemp(Frame.Timing);
+
+			WaitingUploadBytes += Upload.Body.Num();
+			WaitingUploads.Add(MoveTemp(Upload));
+		}
+	}
+	WaitingBatchCount.store(WaitingUploads.Num(), std::memory_order_relaxed);
+}
+
+FTelemetrySpool* FTelemetryWorker::GetSpool()
+{
+	if (!bSpoolEnabled.load(std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+
+	FString Directory;
+	{
+		FScopeLock Lock(&SettingsLock);
+		Directory = SpoolDirectory;
+	}
+	Spool = Dispatcher->GetSpool(Directory, SpoolMaxBytes.load(std::memory_order_relaxed));
+	return Spool.Get();
+}
+
+const TCHAR* FTelemetryWorker::CompressBody(TArray<uint8>& Body)
+{
+	const ETelemetryCompression Method = Compression.load(std::memory_order_relaxed);
+	if (Method == ETelemetryCompression::None)
+	{
+		return nullptr;
+	}
+
+	if (Body.Num() < MinCompressBytes.load(std::memory_order_relaxed))
+	{
+		FScopeLock Lock(&StatsLock);
+		++CompressionStats.BatchesSkipped;
+		return nullptr;
+	}
+
+	TELEMETRY_SCOPE_CYCLE_COUNTER(STAT_TelemetryCompress);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bCompressed = TelemetryCompression::Compress(Method, Body, CompressionScratch);
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	{
+		FScopeLock Lock(&StatsLock);
+		CompressionStats.CompressionTimeMs += static_cast<float>(ElapsedMs);
+		if (bCompressed)
+		{
+			++CompressionStats.BatchesCompressed;
+			CompressionStats.UncompressedBytes += Body.Num();
+			CompressionStats.CompressedBytes += CompressionScratch.Num();
+		}
+		else
+		{
+			++CompressionStats.BatchesSkipped;
+		}
+	}
+
+	if (!bCompressed)
+	{
+		return nullptr;
+	}
+
+	// Keep the larger allocation around as scratch for the next batch
+	Swap(Body, CompressionScratch);
+	return TelemetryCompression::GetContentEncoding(Method);
+}
+
+void FTelemetryWorker::BuildJsonBody(ETelemetryBatchFormat Format, TConstArrayView<FTelemetryEventRecord> Records, TArray<uint8>& OutBody)
+{
+	FTelemetryJsonWriter Writer(OutBody);
+	const bool bArray = Format == ETelemetryBatchFormat::JsonArray;
+	const bool bUseDictionary = bStringDictionary.load(std::memory_order_relaxed);
+
+	if (bArray)
+	{
+		Writer.WriteChar('[');
+	}
+
+	bool bFirstEntry = true;
+	auto BeginEntry = [&Writer, &bFirstEntry, bArray]()
+	{
+		if (bArray && !bFirstEntry)
+		{
+			Writer.WriteChar(',');
+		}
+		bFirstEntry = false;
+	};
+	auto EndEntry = [&Writer, bArray]()
+	{
+		if (!bArray)
+		{
+			Writer.WriteChar('\n');
+		}
+	};
+
+	// Every body defines the IDs it uses at its head, so consumers can resolve them in one pass
+	// even when an earlier body of the session was lost or arrives late
+	StringIDScratch.Reset();
+	if (bUseDictionary)
+	{
+		for (const FTelemetryEventRecord& Record : Records)
+		{
+			StringIDScratch.Add(FindOrAddStringID(Record));
+		}
+
+		const int32 NumIDs = StringIDs.Num() + SessionStringIDs.Num();
+		DefinedStringIDs.SetNumUninitialized(NumIDs);
+		DefinedStringIDs.SetRange(0, NumIDs, false);
+		for (int32 Index = 0; Index < Records.Num(); ++Index)
+		{
+			const int32 StringID = StringIDScratch[Index];
+			if (StringID != INDEX_NONE && !DefinedStringIDs[StringID])
+			{
+				DefinedStringIDs[StringID] = true;
+				BeginEntry();
+				WriteDictionaryJson(Writer, Records[Index], StringID);
+				EndEntry();
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < Records.Num(); ++Index)
+	{
+		const FTelemetryEventRecord& Record = Records[Index];
+
+		// run_start and everything up to its run_end carry the run ID
+		if (Record.Type == ETelemetryEventType::RunStart)
+		{
+			RunID = GetSessionString(Record.StringIndex);
+			RebuildEventPrefix();
+		}
+
+		BeginEntry();
+		WriteEventJson(Writer, Record, bUseDictionary ? StringIDScratch[Index] : INDEX_NONE, EventPrefix);
+		EndEntry();
+
+		if (Record.Type == ETelemetryEventType::RunEnd)
+		{
+			RunID.Reset();
+			RebuildEventPrefix();
+		}
+	}
+
+	if (bArray)
+	{
+		Writer.WriteChar(']');
+	}
+}
+
+int32 FTelemetryWorker::FindOrAddStringID(const FTelemetryEventRecord& Record)
+{
+	// Only the high-frequency payload strings are interned; run IDs and end reasons stay inline
+	const int32 NewID = StringIDs.Num() + SessionStringIDs.Num();
+	if (Record.Type == ETelemetryEventType::InputReceived)
+	{
+		if (const int32* ExistingID = StringIDs.Find(Record.Name))
+		{
+			return *ExistingID;
+		}
+		StringIDs.Add(Record.Name, NewID);
+	}
+	else if (Record.Type == ETelemetryEventType::Damage || Record.Type == ETelemetryEventType::Death)
+	{
+		if (const int32* ExistingID = SessionStringIDs.Find(Record.StringIndex))
+		{
+			return *ExistingID;
+		}
+		SessionStringIDs.Add(Record.StringIndex, NewID);
+	}
+	else
+	{
+		return INDEX_NONE;
+	}
+
+	return NewID;
+}
+
+void FTelemetryWorker::WriteDictionaryJson(FTelemetryJsonWriter& Writer, const FTelemetryEventRecord& Record, int32 StringID) const
+{
+	Writer.WriteRaw(EventPrefix);
+	Writer.WriteRaw("\"event_type\":\"dictionary\",\"frame\":");
+	Writer.WriteInt(Record.Frame);
+	Writer.WriteRaw(",\"game_time\":");
+	Writer.WriteFloat(Record.GameTime);
+	Writer.WriteRaw(",\"string_id\":");
+	Writer.WriteInt(StringID);
+	Writer.WriteRaw(",\"value\":");
+	if (Record.Type == ETelemetryEventType::InputReceived)
+	{
+		Writer.WriteName(Record.Name);
+	}
+	else
+	{
+		Writer.WriteString(GetSessionString(Record.StringIndex));
+	}
+	Writer.WriteChar('}');
+}
+
+void FTelemetryWorker::WriteEventJson(FTelemetryJsonWriter& Writer, const FTelemetryEventRecord& Record, int32 StringID, TConstArrayView<uint8> Prefix) const
+{
+	// Base fields
+	Writer.WriteRaw(Prefix);
+	Writer.WriteRaw("\"event_type\":\"");
+	const uint8 TypeIndex = static_cast<uint8>(Record.Type);
+	Writer.WriteRaw(TypeIndex < UE_ARRAY_COUNT(EventTypeNames) ? EventTypeNames[TypeIndex] : "unknown");
+	Writer.WriteRaw("\",\"frame\":");
+	Writer.WriteInt(Record.Frame);
+	Writer.WriteRaw(",\"game_time\":");
+	Writer.WriteFloat(Record.GameTime);
+	Writer.WriteRaw(",\"seq\":");
+	Writer.WriteInt(Record.Sequence);
+	Writer.WriteRaw(",\"engine_frame\":");
+	Writer.WriteInt(Record.EngineFrame);
+	Writer.WriteRaw(",\"capture_us\":");
+	Writer.WriteInt(FMath::RoundToInt64((Record.CaptureTime - SessionStartTime) * 1000000.0));
+
+	// Event-specific fields
+	switch (Record.Type)
+	{
+	case ETelemetryEventType::InputReceived:
+		if (StringID != INDEX_NONE)
+		{
+			Writer.WriteRaw(",\"input_action\":{\"action_id\":");
+			Writer.WriteInt(StringID);
+		}
+		else
+		{
+			Writer.WriteRaw(",\"input_action\":{\"action_name\":");
+			Writer.WriteName(Record.Name);
+		}
+		Writer.WriteChar('}');
+		break;
+	case ETelemetryEventType::Damage:
+		Writer.WriteRaw(",\"damage\":");
+		Writer.WriteFloat(Record.DamageAmount);
+		Writer.WriteRaw(",\"health_before\":");
+		Writer.WriteFloat(Record.HealthBefore);
+		Writer.WriteRaw(",\"health_after\":");
+		Writer.WriteFloat(Record.HealthAfter);
+		if (StringID != INDEX_NONE)
+		{
+			Writer.WriteRaw(",\"damage_source_id\":");
+			Writer.WriteInt(StringID);
+		}
+		else
+		{
+			Writer.WriteRaw(",\"damage_source\":");
+			Writer.WriteString(GetSessionString(Record.StringIndex));
+		}
+		break;
+	case ETelemetryEventType::Death:
+		if (StringID != INDEX_NONE)
+		{
+			Writer.WriteRaw(",\"cause_id\":");
+			Writer.WriteInt(StringID);
+		}
+		else
+		{
+			Writer.WriteRaw(",\"cause\":");
+			Writer.WriteString(GetSessionString(Record.StringIndex));
+		}
+		break;
+	case ETelemetryEventType::RunEnd:
+		Writer.WriteRaw(",\"end_reason\":");
+		Writer.WriteString(GetSessionString(Record.StringIndex));
+		break;
+	case ETelemetryEventType::FramePerformance:
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		if (const FTelemetryFramePerformance* Performance = FramePerformances.Find(Record.Name))
+		{
+			Performance->WriteJsonFields(Writer);
+		}
+		break;
+	}
+	case ETelemetryEventType::RunSummary:
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		if (const FTelemetryRunData* Summary = RunSummaries.Find(Record.Name))
+		{
+			WriteRunSummaryFields(Writer, *Summary);
+		}
+		break;
+	}
+	case ETelemetryEventType::Heatmap:
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		if (const FHeldHeatmap* Held = Heatmaps.Find(Record.Name))
+		{
+			WriteHeatmapFields(Writer, *Held);
+		}
+		break;
+	}
+	case ETelemetryEventType::PositionFrame:
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		if (const FTelemetryPositionFrame* Frame = PositionFrames.Find(Record.Name))
+		{
+			WritePositionFrameFields(Writer, *Frame);
+		}
+		break;
+	}
+	case ETelemetryEventType::InputSpan:
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		if (const FTelemetryInputSpan* Span = InputSpans.Find(Record.Name))
+		{
+			WriteInputSpanFields(Writer, *Span);
+		}
+		break;
+	}
+	case ETelemetryEventType::DeliveryReport:
+	{
+		FScopeLock Lock(&HeldPayloadLock);
+		if (const FTelemetryDeliveryReport* Report = DeliveryReports.Find(Record.Name))
+		{
+			Report->WriteJsonFields(Writer);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	if (Record.HasPosition())
+	{
+		Writer.WriteRaw(",\"player_pos\":{\"x\":");
+		Writer.WriteFloat(Record.Position.X);
+		Writer.WriteRaw(",\"y\":");
+		Writer.WriteFloat(Record.Position.Y);
+		Writer.WriteRaw(",\"z\":");
+		Writer.WriteFloat(Record.Position.Z);
+		Writer.WriteChar('}');
+	}
+
+	Writer.WriteChar('}');
+}
+
+void FTelemetryWorker::WriteHeatmapFields(FTelemetryJsonWriter& Writer, const FHeldHeatmap& Held)
+{
+	static const ANSICHAR* const PlaneNames[] = {"xy", "xz", "yz"};
+
+	TArray<uint8> Encoded;
+	Held.Heatmap.Serialize(Encoded);
+
+	Writer.WriteRaw(",\"scope\":\"");
+	Writer.WriteRaw(Held.Scope == ETelemetryHeatmapScope::Session ? "session" : "run");
+	Writer.WriteRaw("\",\"plane\":\"");
+	Writer.WriteRaw(PlaneNames[FMath::Min<uint8>(static_cast<uint8>(Held.Heatmap.GetPlane()), 2)]);
+	Writer.WriteRaw("\",\"cell_size\":");
+	Writer.WriteFloat(Held.Heatmap.GetCellSize());
+	Writer.WriteRaw(",\"tiles\":");
+	Writer.WriteInt(Held.Heatmap.GetNumTiles());
+	Writer.WriteRaw(",\"data\":");
+	Writer.WriteString(FBase64::Encode(Encoded));
+}
+
+void FTelemetryWorker::WriteRunSummaryFields(FTelemetryJsonWriter& Writer, const FTelemetryRunData& Summary)
+{
+	Writer.WriteRaw(",\"run_start_time\":");
+	Writer.WriteFloat(Summary.RunStartTime);
+	Writer.WriteRaw(",\"run_end_time\":");
+	Writer.WriteFloat(Summary.RunEndTime);
+	Writer.WriteRaw(",\"run_total_time\":");
+	Writer.WriteFloat(Summary.RunTotalTime);
+	Writer.WriteRaw(",\"end_reason\":");
+	Writer.WriteString(Summary.EndReason);
+	Writer.WriteRaw(",\"rooms_cleared\":");
+	Writer.WriteInt(Summary.RoomsCleared);
+	Writer.WriteRaw(",\"distance_travelled\":");
+	Writer.WriteFloat(Summary.DistanceTravelled);
+	Writer.WriteRaw(",\"time_airborne\":");
+	Writer.WriteFloat(Summary.TimeAirborne);
+	Writer.WriteRaw(",\"damage_taken\":");
+	Writer.WriteFloat(Summary.DamageTaken);
+	Writer.WriteRaw(",\"deaths\":");
+	Writer.WriteInt(Summary.Deaths);
+
+	Writer.WriteRaw(",\"input_counts\":{");
+	bool bFirst = true;
+	for (const TPair<FName, int32>& Input : Summary.InputCounts)
+	{
+		if (!bFirst)
+		{
+			Writer.WriteChar(',');
+		}
+		bFirst = false;
+		Writer.WriteName(Input.Key);
+		Writer.WriteChar(':');
+		Writer.WriteInt(Input.Value);
+	}
+
+	Writer.WriteRaw("},\"damage_by_source\":{");
+	bFirst = true;
+	for (const TPair<FString, float>& Source : Summary.DamageBySource)
+	{
+		if (!bFirst)
+		{
+			Writer.WriteChar(',');
+		}
+		bFirst = false;
+		Writer.WriteString(Source.Key);
+		Writer.WriteChar(':');
+		Writer.WriteFloat(Source.Value);
+	}
+	Writer.WriteChar('}');
+}
+
+void FTelemetryWorker::WriteInputSpanFields(FTelemetryJsonWriter& Writer, const FTelemetryInputSpan& Span)
+{
+	Writer.WriteRaw(",\"input_action\":{\"action_name\":");
+	Writer.WriteName(Span.Action);
+	Writer.WriteRaw("},\"start_time\":");
+	Writer.WriteFloat(Span.StartTime);
+	Writer.WriteRaw(",\"duration\":");
+	Writer.WriteFloat(Span.Duration);
+	Writer.WriteRaw(",\"trigger_count\":");
+	Writer.WriteInt(Span.TriggerCount);
+	Writer.WriteRaw(Span.bCanceled ? ",\"canceled\":true" : ",\"canceled\":false");
+
+	// Only the axes the action actually has
+	auto WriteValue = [&Writer, &Span](const ANSICHAR* Key, const FVector3f& Value)
+	{
+		Writer.WriteRaw(Key);
+		for (int32 Axis = 0; Axis < Span.NumAxes; ++Axis)
+		{
+			if (Axis > 0)
+			{
+				Writer.WriteChar(',');
+			}
+			Writer.WriteFloat(Value[Axis]);
+		}
+		Writer.WriteChar(']');
+	};
+	WriteValue(",\"value_min\":[", Span.MinValue);
+	WriteValue(",\"value_max\":[", Span.MaxValue);
+}
+
+void FTelemetryWorker::WritePositionFrameFields(FTelemetryJsonWriter& Writer, const FTelemetryPositionFrame& Frame)
+{
+	Writer.WriteRaw(",\"actors\":[");
+	for (int32 Index = 0; Index < Frame.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			Writer.WriteChar(',');
+		}
+		Writer.WriteName(Frame.Actors[Index]);
+	}
+
+	// Coordinates as parallel arrays - far smaller than an object per actor
+	auto WriteAxis = [&Writer](const ANSICHAR* Key, const TArray<float>& Values)
+	{
+		Writer.WriteRaw(Key);
+		for (int32 Index = 0; Index < Values.Num(); ++Index)
+		{
+			if (Index > 0)
+			{
+				Writer.WriteChar(',');
+			}
+			Writer.WriteFloat(Values[Index]);
+		}
+		Writer.WriteChar(']');
+	};
+	WriteAxis("],\"x\":[", Frame.X);
+	WriteAxis(",\"y\":[", Frame.Y);
+	WriteAxis(",\"z\":[", Frame.Z);
+}
+
+void FTelemetryWorker::RebuildEventPrefix()
+{
+	WriteEventPrefix(EventPrefix, RunID);
+}
+
+void FTelemetryWorker::WriteEventPrefix(TArray<uint8>& OutPrefix, const FString& InRunID) const
+{
+	OutPrefix.Reset();
+	FTelemetryJsonWriter Writer(OutPrefix);
+
+	Writer.WriteRaw("{\"machine_id\":");
+	Writer.WriteString(MachineName);
+	Writer.WriteRaw(",\"session_id\":");
+	Writer.WriteString(SessionID);
+	Writer.WriteChar(',');
+
+	if (!InRunID.IsEmpty())
+	{
+		Writer.WriteRaw("\"run_id\":");
+		Writer.WriteString(InRunID);
+		Writer.WriteChar(',');
+	}
+}
+
+const FString& FTelemetryWorker::GetSessionString(uint32 Index) const
+{
+	static const FString Empty;
+	return SessionStrings ? SessionStrings->Get(Index) : Empty;
+}
+
+double FTelemetryWorker::GetSecondsUntilTimedFlush() const
+{
+	const float Interval = FlushInterval.load(std::memory_order_relaxed);
+	if (Interval <= 0.0f)
+	{
+		return -1.0;
+	}
+
+	return FMath::Max(0.0, LastFlushTime + Interval - FPlatformTime::Seconds());
+}
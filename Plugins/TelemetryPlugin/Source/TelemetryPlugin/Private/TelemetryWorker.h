@@ -0,0 +1,545 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "TelemetryTypes.h"
+#include "TelemetryEventRecord.h"
+#include "TelemetryEventQueue.h"
+#include "TelemetryFramePerformance.h"
+#include "TelemetryHeatmap.h"
+#include "TelemetryPositionFrame.h"
+#include "TelemetryInputSpan.h"
+#include "TelemetrySink.h"
+#include "TelemetryLatency.h"
+#include <atomic>
+
+class FTelemetryJsonWriter;
+class FTelemetryDispatcher;
+class FTelemetrySpool;
+class FTelemetryEventPolicies;
+class FTelemetryStreamTransport;
+
+/**
+ * Serialization and upload of one game instance's telemetry events
+ * Producers (any thread) only push FTelemetryEventRecord into a bounded lock-free MPSC ring;
+ * the worker drains it, builds the batch body and issues the HTTP request. Workers have no
+ * thread of their own - the process-wide FTelemetryDispatcher ticks all of them on one, and
+ * their uploads share its in-flight budget, spool and streams.
+ * Scalar events (positions, input, damage, lifecycle) never touch the heap on the way in: the
+ * ring is preallocated, the batch buffer is reused, and JSON is streamed as UTF-8 into a reused
+ * body behind a cached session/run prefix. Payload events (position frames, input spans,
+ * histograms, heatmaps) are held in maps until encoded, and each upload copies its body and
+ * capture times into a request of its own.
+ * BACKPRESSURE:
+ * At most MaxInFlightRequests uploads are outstanding. While the collector is behind, events
+ * are held back and, past the backlog budget, position frames, then positions, then input
+ * events and spans are shed oldest first. Lifecycle and outcome events are never shed.
+ * RETRIES:
+ * Every body carries an Idempotency-Key (its spool segment name) so the collector can drop one
+ * it already has. Failed uploads come back to the worker, which retries them after a jittered
+ * exponential backoff while the retry budget lasts, and sizes batches by AIMD on the outcome.
+ * DELIVERY LATENCY:
+ * Events are stamped with engine frame and capture time on Enqueue and numbered per session once
+ * batched. Each body carries its events' capture times to the collector's answer; every
+ * DeliveryReportInterval the worker sends what was measured as a delivery_report event, and
+ * session_end forces one. Answers arriving between sessions wait for the next session's first report.
+ */
+class FTelemetryWorker : public TSharedFromThis<FTelemetryWorker, ESPMode::ThreadSafe>
+{
+public:
+	FTelemetryWorker(const FString& InMachineName, const TSharedPtr<FTelemetryEventPolicies, ESPMode::ThreadSafe>& InPolicies,
+		const TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe>& InDispatcher);
+	~FTelemetryWorker();
+
+	/**
+	 * Queue an event - safe to call from any thread
+	 * @return false if the queue is full and the event was dropped
+	 */
+	bool Enqueue(const FTelemetryEventRecord& Record);
+
+	/**
+	 * Queue a session_start event along with the session's ID and string table - safe to call from any thread
+	 * @param Record - SessionStart record, Name is unique per session
+	 * @param InSessionStrings - Table the StringIndex of the session's events refers to
+	 */
+	void EnqueueSessionStart(const FTelemetryEventRecord& Record, const FString& InSessionID,
+		const TSharedRef<FTelemetryStringTable, ESPMode::ThreadSafe>& InSessionStrings);
+
+	/**
+	 * Queue a run's frame_performance event along with its histograms - safe to call from any thread
+	 * @param Record - FramePerformance record, Name is unique per run
+	 */
+	void EnqueueFramePerformance(const FTelemetryEventRecord& Record, FTelemetryFramePerformance&& Performance);
+
+	/**
+	 * Queue a run's run_summary event along with its aggregates - safe to call from any thread
+	 * @param Record - RunSummary record, Name is unique per run
+	 */
+	void EnqueueRunSummary(const FTelemetryEventRecord& Record, FTelemetryRunData&& Summary);
+
+	/**
+	 * Queue a heatmap event along with its grid - safe to call from any thread
+	 * @param Record - Heatmap record, Name is unique per heatmap
+	 */
+	void EnqueueHeatmap(const FTelemetryEventRecord& Record, FTelemetryHeatmap&& Heatmap, ETelemetryHeatmapScope Scope);
+
+	/**
+	 * Queue a position_frame event along with its per-actor positions - safe to call from any thread
+	 * @param Record - PositionFrame record, Name is unique per frame
+	 * @return false if the queue is full and the frame was dropped
+	 */
+	bool EnqueuePositionFrame(const FTelemetryEventRecord& Record, FTelemetryPositionFrame&& Frame);
+
+	/**
+	 * Queue an input_span event along with its span - safe to call from any thread
+	 * @param Record - InputSpan record, Name is unique per span
+	 * @return false if the queue is full and the span was dropped
+	 */
+	bool EnqueueInputSpan(const FTelemetryEventRecord& Record, FTelemetryInputSpan&& Span);
+
+	/**
+	 * Replace the local sinks and the event types the HTTP upload receives - safe to call from any thread
+	 * Takes effect at the worker's next pass, after the previous sinks were flushed
+	 * @param InHttpTypeMask - Bit per ETelemetryEventType, 0 turns HTTP upload off
+	 */
+	void SetSinks(TArray<FTelemetrySinkEntry>&& InSinks, uint32 InHttpTypeMask);
+
+	/**
+	 * Frame upload bodies onto this stream while it is connected, null = POST only
+	 * Frames a replaced stream hands back are still POSTed.
+	 */
+	void SetStreamTransport(const TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe>& InStreamTransport);
+
+	/** Ask the worker to upload everything queued so far - safe to call from any thread */
+	void RequestFlush();
+
+	/** Leave the dispatcher, then drain and flush everything queued on the calling thread */
+	void Shutdown();
+
+	void SetServerURL(const FString& InServerURL);
+	void SetBatching(int32 InMaxBatchSize, float InFlushInterval, ETelemetryBatchFormat InBatchFormat);
+	void SetWireFormat(ETelemetryWireFormat InWireFormat);
+	void SetCompression(ETelemetryCompression InCompression, int32 InMinCompressBytes);
+	void SetSpool(bool bInEnabled, int64 InMaxBytes, const FString& InDirectory);
+	void SetStringDictionary(bool bInEnabled);
+	void SetBackpressure(int32 InMaxInFlightRequests, int64 InMaxBacklogBytes);
+	void SetDeliveryReportInterval(float InInterval);
+	void SetRetry(const FTelemetryRetrySettings& InRetry);
+
+	/** Snapshot of compression totals - safe to call from any thread */
+	FTelemetryCompressionStats GetCompressionStats() const;
+
+	/** Events queued or batched but not yet handed to HTTP */
+	int32 GetPendingEventCount() const { return PendingEventCount.load(std::memory_order_relaxed); }
+
+	/** Events dropped because the queue was full */
+	int64 GetDroppedEventCount() const { return DroppedEventCount.load(std::memory_order_relaxed); }
+
+	/** Snapshot of upload backlog and shedding - safe to call from any thread */
+	FTelemetryBackpressureStats GetBackpressureStats() const;
+
+	/** Drain the queue, upload what is due and retry what failed (dispatcher thread) */
+	void Tick();
+
+	/** Seconds until timed work (flush, coalescing, replay, retry) is due, or -1 if none (dispatcher thread) */
+	double GetSecondsUntilNextTick() const;
+
+private:
+	struct FWaitingUpload;
+	struct FUploadResult;
+	struct FHeldHeatmap;
+	struct FHeldSession;
+
+	/** Drain the queue into the current batch and flush when due */
+	void ProcessQueue();
+
+	/** Take a dequeued record: coalesce it, or add it to the current batch */
+	void AddRecord(const FTelemetryEventRecord& Record);
+
+	/** Hand to the sinks, then append to the current batch if it is uploaded, flushing when full */
+	void AddToBatch(const FTelemetryEventRecord& Record);
+
+	/** Give the record to every sink that accepts it, serializing it once for all JSON sinks */
+	void WriteToSinks(const FTelemetryEventRecord& Record);
+
+	/** Push out whatever the sinks buffered */
+	void FlushSinks();
+
+	/** Swap in sinks set by SetSinks, if any */
+	void ApplyPendingSinks();
+
+	/** Merge into the open burst for its type if it has a coalescing window, true if absorbed or held */
+	bool TryCoalesce(const FTelemetryEventRecord& Record);
+
+	/** Move merged bursts into the batch - those whose window has passed, or all of them */
+	void EmitCoalesced(bool bAll);
+
+	/** Seconds until the earliest open burst closes, or -1 if none is open */
+	double GetSecondsUntilCoalesceExpiry() const;
+
+	/**
+	 * Encode, spool and upload the current batch in chunks of MaxBatchSize
+	 * @param bForce - Encode everything even without a free upload slot (session change, shutdown)
+	 */
+	void FlushBatch(bool bForce = false);
+
+	/** Encode and spool one chunk, then send it or park it until a slot frees up */
+	void EncodeAndUpload(const FString& URL, TConstArrayView<FTelemetryEventRecord> Records);
+
+	/**
+	 * Compress and spool BodyScratch, then send it or park it until a slot frees up
+	 * @param Timing - Capture times of the body's events and when it was serialized
+	 */
+	void UploadBody(const FString& URL, const TCHAR* ContentType, FTelemetryBatchTiming&& Timing);
+
+	/** Add a delivery_report with the latency measured so far, if one is due (or bForce) */
+	void EmitDeliveryReport(bool bForce);
+
+	/** Send parked batches in order while slots are free (or all of them) */
+	void SendWaitingUploads(bool bIgnoreLimit = false);
+
+	/** New uploads may start - nothing parked and below the in-flight cap */
+	bool HasUploadSlot() const;
+
+	/** Shed low-value held-back events once they exceed what encoded bodies leave of the backlog budget */
+	void ShedBacklog();
+
+	/**
+	 * Shed a low-value record on arrival while encoded bodies alone fill the backlog budget
+	 * @return Whether the record was shed rather than added to the batch
+	 */
+	bool RefuseSheddable(const FTelemetryEventRecord& Record);
+
+	/** Held-back records plus bodies waiting for a slot or a retry - what the stats measure */
+	int64 GetBacklogBytes() const;
+
+	/** Bodies waiting for a slot or a retry - encoded already, so they cannot be shed */
+	int64 GetEncodedBacklogBytes() const;
+
+	/** Called from the HTTP thread when an upload finishes, hands the outcome to the worker */
+	void OnUploadComplete(int64 BodyBytes, FUploadResult&& Result);
+
+	/** Adapt the batch size to finished uploads and schedule or give up on failed ones */
+	void ProcessUploadResults();
+
+	/** Send retries whose backoff has passed while slots are free (or all of them) */
+	void SendDueRetries(bool bIgnoreLimit = false);
+
+	/** Seconds until the earliest retry is due, or -1 if none is waiting */
+	double GetSecondsUntilNextRetry() const;
+
+	/** Events per upload right now - MaxBatchSize scaled down while the collector struggles */
+	int32 GetBatchSize() const;
+
+	/** Segment name of a spooled body, so a replay from a later process keeps its key */
+	FString MakeIdempotencyKey(const FString& SegmentPath);
+
+	/** POST a finished body; the response completes its spool segment or comes back for a retry */
+	void SendBody(const FString& URL, FWaitingUpload&& Upload);
+
+	/** Upload a few segments left over from earlier sessions */
+	void ReplaySpooledSegments();
+
+	/** The dispatcher's spool if enabled, created on first use (worker thread only) */
+	FTelemetrySpool* GetSpool();
+
+	FString GetServerURL() const;
+	FTelemetryRetrySettings GetRetrySettings() const;
+
+	TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> GetStreamTransport() const;
+
+	/** Park frames a dead stream gave back so they go out over POST */
+	void TakeStreamFallback();
+
+	/** Serialize records as a JSON array or NDJSON body into OutBody */
+	void BuildJsonBody(ETelemetryBatchFormat Format, TConstArrayView<FTelemetryEventRecord> Records, TArray<uint8>& OutBody);
+
+	/** Compress the body in place if enabled and worthwhile, returns the Content-Encoding or nullptr */
+	const TCHAR* CompressBody(TArray<uint8>& Body);
+
+	/** Stream the heatmap event fields (grid settings and base64 encoding), starting with a leading comma */
+	static void WriteHeatmapFields(FTelemetryJsonWriter& Writer, const FHeldHeatmap& Held);
+
+	/** Stream the position_frame actor and coordinate arrays, starting with a leading comma */
+	static void WritePositionFrameFields(FTelemetryJsonWriter& Writer, const FTelemetryPositionFrame& Frame);
+
+	/** Stream the input_span action, timing and value range, starting with a leading comma */
+	static void WriteInputSpanFields(FTelemetryJsonWriter& Writer, const FTelemetryInputSpan& Span);
+
+	/** Stream the run_summary aggregate fields, starting with a leading comma */
+	static void WriteRunSummaryFields(FTelemetryJsonWriter& Writer, const FTelemetryRunData& Summary);
+
+	/**
+	 * Stream one record in the JSON event layout
+	 * @param Prefix - Serialized machine/session/run fields, see WriteEventPrefix
+	 */
+	void WriteEventJson(FTelemetryJsonWriter& Writer, const FTelemetryEventRecord& Record, int32 StringID, TConstArrayView<uint8> Prefix) const;
+
+	/** Re-serialize the fields shared by every uploaded event (machine, session, run) */
+	void RebuildEventPrefix();
+
+	/** Serialize `{"machine_id":..,"session_id":..,["run_id":..,]` for the given run */
+	void WriteEventPrefix(TArray<uint8>& OutPrefix, const FString& InRunID) const;
+
+	/** Forget the held IDs and payloads of records that have been encoded or dropped */
+	void ReleaseHeldPayloads(TConstArrayView<FTelemetryEventRecord> Records);
+
+	/** Free-form string of one of the current session's records, empty if unknown */
+	const FString& GetSessionString(uint32 Index) const;
+
+	/**
+	 * Session-scoped ID for the record's action name, damage source or death cause
+	 * @return INDEX_NONE for events whose strings are sent inline
+	 */
+	int32 FindOrAddStringID(const FTelemetryEventRecord& Record);
+
+	/** Stream the dictionary event that defines StringID */
+	void WriteDictionaryJson(FTelemetryJsonWriter& Writer, const FTelemetryEventRecord& Record, int32 StringID) const;
+
+	/** Seconds until the next timed flush, or -1 if timed flush is disabled */
+	double GetSecondsUntilTimedFlush() const;
+
+	/** Incoming events from all producers */
+	TTelemetryEventQueue<FTelemetryEventRecord> Queue;
+
+	/** Unbounded fallback so events that must not be shed survive a full queue (may reorder them slightly) */
+	TQueue<FTelemetryEventRecord, EQueueMode::Mpsc> OverflowQueue;
+
+	/** Machine name stamped on every event */
+	const FString MachineName;
+
+	/** Session the worker is currently serializing for (set by SessionStart records) */
+	FString SessionID;
+
+	/** Strings the current session's records index into, null before the first session (worker thread only) */
+	TSharedPtr<FTelemetryStringTable, ESPMode::ThreadSafe> SessionStrings;
+
+	/** Run the worker is currently serializing for, empty between runs (worker thread only) */
+	FString RunID;
+
+	/** Pre-serialized `{"machine_id":..,"session_id":..,["run_id":..,]` (worker thread only) */
+	TArray<uint8> EventPrefix;
+
+	/** Local destinations besides HTTP (worker thread only) */
+	TArray<FTelemetrySinkEntry> Sinks;
+
+	/** Event types uploaded over HTTP (worker thread only) */
+	uint32 HttpTypeMask = MAX_uint32;
+
+	/** Sinks are fed at batching time, so they follow runs separately from the upload path (worker thread only) */
+	FString SinkRunID;
+	TArray<uint8> SinkEventPrefix;
+	TArray<uint8> SinkScratch;
+
+	/** Set by SetSinks, guarded by SettingsLock */
+	TArray<FTelemetrySinkEntry> PendingSinks;
+	uint32 PendingHttpTypeMask = MAX_uint32;
+	std::atomic<bool> bSinksPending{false};
+
+	/** Sampling, rate limit and coalescing settings shared with the producers */
+	TSharedPtr<FTelemetryEventPolicies, ESPMode::ThreadSafe> Policies;
+
+	/** Burst being merged for one event type (worker thread only) */
+	struct FCoalesceSlot
+	{
+		FTelemetryEventRecord Record;
+		double WindowEnd = 0.0;
+		bool bActive = false;
+	};
+
+	/** Indexed by ETelemetryEventType, only types with a policy coalesce */
+	FCoalesceSlot CoalesceSlots[NumTelemetryEventTypes];
+	static_assert(UE_ARRAY_COUNT(CoalesceSlots) == NumTelemetryEventTypes, "One coalesce slot per event type");
+
+	/** A heatmap waiting for its record to be serialized */
+	struct FHeldHeatmap
+	{
+		FTelemetryHeatmap Heatmap;
+		ETelemetryHeatmapScope Scope = ETelemetryHeatmapScope::Run;
+	};
+
+	/** IDs given to action names and session strings this session (worker thread only) */
+	TMap<FName, int32> StringIDs;
+	TMap<uint32, int32> SessionStringIDs;
+
+	/** Per-record IDs and the IDs already defined in the body being built, reused (worker thread only) */
+	TArray<int32> StringIDScratch;
+	TBitArray<> DefinedStringIDs;
+
+	/** Events in the current batch, all from the same session (worker thread only) */
+	TArray<FTelemetryEventRecord> PendingRecords;
+
+	/** Held-payload records of a binary batch that go up as JSON, reused (worker thread only) */
+	TArray<FTelemetryEventRecord> SideRecords;
+
+	/** Reused body buffer, grows to the working batch size once (worker thread only) */
+	TArray<uint8> BodyScratch;
+
+	/** A session's ID and strings waiting for its session_start record */
+	struct FHeldSession
+	{
+		FString SessionID;
+		TSharedPtr<FTelemetryStringTable, ESPMode::ThreadSafe> Strings;
+	};
+
+	/** IDs for queued session_start records, keyed by their numbered name */
+	TMap<FName, FHeldSession> Sessions;
+	/** Payloads for queued frame_performance, run_summary and heatmap records, keyed by their numbered name */
+	TMap<FName, FTelemetryFramePerformance> FramePerformances;
+	TMap<FName, FTelemetryRunData> RunSummaries;
+	TMap<FName, FHeldHeatmap> Heatmaps;
+	/** Payloads for queued position_frame and input_span records, keyed by their numbered name */
+	TMap<FName, FTelemetryPositionFrame> PositionFrames;
+	TMap<FName, FTelemetryInputSpan> InputSpans;
+	TMap<FName, FTelemetryDeliveryReport> DeliveryReports;
+	mutable FCriticalSection HeldPayloadLock;
+
+	/** An encoded, spooled batch waiting for an upload slot or a retry */
+	struct FWaitingUpload
+	{
+		FString ContentType;
+
+		/** Content-Encoding header value, empty if uncompressed */
+		FString ContentEncoding;
+
+		TArray<uint8> Body;
+		FString SegmentPath;
+		FString IdempotencyKey;
+		FTelemetryBatchTiming Timing;
+
+		/** Retries so far, and when the next one is due */
+		int32 Attempt = 0;
+		double RetryTime = 0.0;
+	};
+
+	/** How an upload ended, passed from the HTTP thread to the worker */
+	struct FUploadResult
+	{
+		bool bAccepted = false;
+		double RoundTripMs = 0.0;
+
+		/** Worth sending again - Upload holds the body, its spool segment is still in flight */
+		bool bRetry = false;
+		double RetryAfter = 0.0;
+		FWaitingUpload Upload;
+	};
+
+	/** Batches parked while the collector is behind, oldest first (worker thread only) */
+	TArray<FWaitingUpload> WaitingUploads;
+	int64 WaitingUploadBytes = 0;
+
+	/** Failed uploads waiting out their backoff, in the order they failed (worker thread only) */
+	TArray<FWaitingUpload> RetryUploads;
+	int64 RetryUploadBytes = 0;
+
+	/** Records refused by RefuseSheddable since ShedBacklog last logged them (worker thread only) */
+	int32 NumRefusedEvents = 0;
+
+	TQueue<FUploadResult, EQueueMode::Mpsc> UploadResults;
+
+	/** Retries left, earned back by successful uploads (worker thread only) */
+	float RetryTokens = MaxRetryTokens;
+
+	/** AIMD batch size, clamped to MaxBatchSize when used (worker thread only) */
+	int32 AdaptiveBatchSize = MAX_int32;
+
+	/** Backoff jitter, seeded per process so clients do not retry in step (worker thread only) */
+	FRandomStream JitterStream;
+
+	/** Keys bodies that are not spooled (worker thread only) */
+	uint32 UploadSerial = 0;
+
+	/** Endpoint, guarded by SettingsLock */
+	FString ServerURL;
+
+	/** Optional WebSocket stream, guarded by SettingsLock */
+	TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> StreamTransport;
+
+	/** Streams replaced by SetStreamTransport, drained of fallback frames once, guarded by SettingsLock */
+	TArray<TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe>> RetiredStreamTransports;
+
+	/** Retry and batch size policy, guarded by SettingsLock */
+	FTelemetryRetrySettings RetrySettings;
+	mutable FCriticalSection SettingsLock;
+
+	std::atomic<int32> MaxBatchSize{50};
+	std::atomic<float> FlushInterval{2.0f};
+	std::atomic<ETelemetryBatchFormat> BatchFormat{ETelemetryBatchFormat::JsonArray};
+	std::atomic<ETelemetryWireFormat> WireFormat{ETelemetryWireFormat::Json};
+	std::atomic<ETelemetryCompression> Compression{ETelemetryCompression::None};
+	std::atomic<int32> MinCompressBytes{1024};
+	std::atomic<bool> bStringDictionary{false};
+	std::atomic<int32> MaxInFlightRequests{4};
+	std::atomic<int64> MaxBacklogBytes{1024 * 1024};
+
+	/** Compression totals, guarded by StatsLock */
+	FTelemetryCompressionStats CompressionStats;
+	mutable FCriticalSection StatsLock;
+
+	/** Reused output buffer for compression (worker thread only) */
+	TArray<uint8> CompressionScratch;
+
+	/** On-disk copy of every batch until it is acknowledged, shared through the dispatcher */
+	TSharedPtr<FTelemetrySpool, ESPMode::ThreadSafe> Spool;
+	std::atomic<bool> bSpoolEnabled{false};
+	std::atomic<int64> SpoolMaxBytes{0};
+
+	/** Segment directory, empty for the default - guarded by SettingsLock */
+	FString SpoolDirectory;
+
+	/** Segments from earlier sessions still to be replayed (worker thread only) */
+	TArray<FString> PendingReplay;
+
+	std::atomic<int32> PendingEventCount{0};
+	std::atomic<int64> UploadedEventCount{0};
+	std::atomic<int64> DroppedEventCount{0};
+	std::atomic<int64> ShedEventCount{0};
+
+	/** Last sequence number handed out in this session (worker thread only) */
+	uint32 EventSequence = 0;
+
+	/** Capture time of session_start - capture_us counts from here (worker thread only) */
+	double SessionStartTime = 0.0;
+
+	/** Frame and game time of the latest event, borrowed by worker-made events (worker thread only) */
+	int32 LastFrame = 0;
+	float LastGameTime = 0.0f;
+
+	/** Answers from the collector, fed from the HTTP thread and stream acks */
+	TSharedPtr<FTelemetryLatencyTracker, ESPMode::ThreadSafe> LatencyTracker;
+	std::atomic<float> DeliveryReportInterval{30.0f};
+	double LastDeliveryReportTime = 0.0;
+	int32 DeliveryReportSerial = 0;
+
+	/** Between session_start and session_end - no reports outside a session (worker thread only) */
+	bool bSessionActive = false;
+
+	/** Published by the worker for GetBackpressureStats */
+	std::atomic<int32> InFlightRequests{0};
+	std::atomic<int64> InFlightBytes{0};
+	std::atomic<int32> WaitingBatchCount{0};
+	std::atomic<int32> CurrentBatchSize{0};
+	std::atomic<int64> RetriedUploadCount{0};
+	std::atomic<int64> FailedUploadCount{0};
+	std::atomic<int64> BacklogBytes{0};
+	std::atomic<bool> bFlushRequested{false};
+
+	/** Time of the last upload, for timed flush */
+	double LastFlushTime = 0.0;
+
+	const TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe> Dispatcher;
+	bool bRegistered = false;
+
+	/** Queue slots - enough for several seconds of events if the worker stalls */
+	static constexpr uint32 QueueCapacity = 16384;
+
+	/** HTTP request timeout in seconds */
+	static constexpr float RequestTimeout = 5.0f;
+
+	/** Segments replayed per worker pass, and how often passes run while replaying */
+	static constexpr int32 ReplaySegmentsPerPass = 4;
+	static constexpr double ReplayInterval = 0.25;
+
+	/** Retry budget cap - how many retries a burst of failures can use before successes refill it */
+	static constexpr float MaxRetryTokens = 10.0f;
+};
@@ -0,0 +1,606 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "TelemetrySubsystem.h"
+#include "TelemetryBinaryFormat.h"
+#include "TelemetryStringTable.h"
+#include "TelemetryLocalCollector.h"
+#include "TelemetryCountingMalloc.h"
+#include "InputAction.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/Package.h"
+
+namespace TelemetryPluginTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	/** Give up waiting for the worker or the collector after this long */
+	constexpr double DefaultTimeoutSeconds = 10.0;
+
+	/** Collector ports, one per test so a listener left behind by a failed test does not leak into the next */
+	constexpr uint32 BatchingPort = 18090;
+	constexpr uint32 SpoolReplayPort = 18091;
+	constexpr uint32 SheddingPort = 18092;
+	constexpr uint32 AllocationPort = 18093;
+	constexpr uint32 SheddingRetryPort = 18094;
+
+	/**
+	 * Advance HTTP client and server until Predicate holds or the timeout passes
+	 * @return Whether Predicate held in the end
+	 */
+	template <typename PredicateType>
+	bool TickUntil(PredicateType&& Predicate, double TimeoutSeconds = DefaultTimeoutSeconds)
+	{
+		const double EndTime = FPlatformTime::Seconds() + TimeoutSeconds;
+		double LastTime = FPlatformTime::Seconds();
+		while (!Predicate() && FPlatformTime::Seconds() < EndTime)
+		{
+			const double Now = FPlatformTime::Seconds();
+			FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTime));
+			LastTime = Now;
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return Predicate();
+	}
+
+	/** Keep HTTP client and server running for a while, to show that something does not happen */
+	void TickFor(double Seconds)
+	{
+		TickUntil([]() { return false; }, Seconds);
+	}
+
+	/** Nothing captured, waiting or in flight */
+	bool IsDrained(const FTelemetryBackpressureStats& Stats)
+	{
+		return Stats.BacklogEvents == 0 && Stats.WaitingBatches == 0 && Stats.InFlightRequests == 0;
+	}
+
+	/**
+	 * Telemetry subsystem of a standalone game instance, like the game would own it
+	 * Everything DefaultGame.ini sets that the tests depend on is overridden, so results do not
+	 * change with the project's settings: no spool, every position sent, batches of BatchSize
+	 * only flushed when full or on Flush, no compression and no shedding.
+	 */
+	struct FTestTelemetry
+	{
+		static constexpr int32 BatchSize = 10;
+
+		explicit FTestTelemetry(const FString& URL)
+			: GameInstance(NewObject<UGameInstance>(GEngine))
+		{
+			GameInstance->InitializeStandalone();
+			Telemetry = GameInstance->GetSubsystem<UTelemetrySubsystem>();
+			if (Telemetry)
+			{
+				// Before StartNewSession, so the game's own spooled batches are not replayed to the test collector
+				Telemetry->ConfigureSpool(false, 1);
+				Telemetry->ConfigureAdaptivePositionSampling(FTelemetryAdaptiveSamplingSettings());
+				Telemetry->Configure(URL, ETelemetryWireFormat::Json);
+				Telemetry->ConfigureBatching(BatchSize, 0.0f, ETelemetryBatchFormat::JsonArray);
+				Telemetry->ConfigureCompression(ETelemetryCompression::None, 0);
+				Telemetry->ConfigureBackpressure(4, 0);
+				Telemetry->ConfigureRetry(FTelemetryRetrySettings());
+			}
+		}
+
+		~FTestTelemetry()
+		{
+			GameInstance->Shutdown();
+		}
+
+		TStrongObjectPtr<UGameInstance> GameInstance;
+		UTelemetrySubsystem* Telemetry = nullptr;
+	};
+}
+
+using namespace TelemetryPluginTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTelemetryBatchingTest, "TelemetryPlugin.Batching", TelemetryPluginTests::TestFlags)
+
+bool FTelemetryBatchingTest::RunTest(const FString& Parameters)
+{
+	FTelemetryLocalCollector Collector(BatchingPort);
+	if (!TestTrue(TEXT("Local collector started"), Collector.Start()))
+	{
+		return false;
+	}
+
+	{
+		FTestTelemetry Test(Collector.GetURL());
+		if (!TestNotNull(TEXT("Telemetry subsystem"), Test.Telemetry))
+		{
+			Collector.Stop();
+			return false;
+		}
+		UTelemetrySubsystem& Telemetry = *Test.Telemetry;
+
+		// session_start and run_start plus these positions make exactly one full batch
+		Telemetry.StartNewSession();
+		Telemetry.StartRun();
+		for (int32 Index = 0; Index < FTestTelemetry::BatchSize - 2; ++Index)
+		{
+			Telemetry.SendPositionUpdate(FVector(Index * 10.0, 0.0, 100.0), Index * 0.1f);
+		}
+
+		TickUntil([&]() { return Collector.GetStats().Events >= FTestTelemetry::BatchSize; });
+		TestEqual(TEXT("Full batch uploaded"), Collector.GetStats().Events, static_cast<int64>(FTestTelemetry::BatchSize));
+		TestEqual(TEXT("Full batch sent as one request"), Collector.GetStats().Requests, static_cast<int64>(1));
+
+		// A partial batch waits for Flush
+		constexpr int32 NumPartial = 5;
+		for (int32 Index = 0; Index < NumPartial; ++Index)
+		{
+			Telemetry.SendPositionUpdate(FVector(Index * 10.0, 0.0, 200.0), 1.0f + Index * 0.1f);
+		}
+
+		TickFor(0.25);
+		TestEqual(TEXT("Partial batch held back"), Collector.GetStats().Requests, static_cast<int64>(1));
+		TestEqual(TEXT("Partial batch pending"), Telemetry.GetPendingEventCount(), NumPartial);
+
+		Telemetry.Flush();
+		TickUntil([&]() { return Collector.GetStats().Events >= FTestTelemetry::BatchSize + NumPartial; });
+		TestEqual(TEXT("Partial batch uploaded on Flush"), Collector.GetStats().Events, static_cast<int64>(FTestTelemetry::BatchSize + NumPartial));
+		TestEqual(TEXT("Partial batch sent as one request"), Collector.GetStats().Requests, static_cast<int64>(2));
+
+		// Summaries and reports added on the way out are counted by the worker like any other event
+		Telemetry.EndRun(TEXT("test"));
+		Telemetry.EndSession();
+		Telemetry.Flush();
+
+		FTelemetryBackpressureStats Backpressure;
+		const bool bDrained = TickUntil([&]()
+		{
+			Backpressure = Telemetry.GetBackpressureStats();
+			return IsDrained(Backpressure) && Collector.GetStats().Events >= Backpressure.UploadedEvents;
+		});
+		TestTrue(TEXT("Session drained"), bDrained);
+
+		const FTelemetryLocalCollector::FStats& Stats = Collector.GetStats();
+		TestEqual(TEXT("Collector received every uploaded event"), Stats.Events, Backpressure.UploadedEvents);
+		TestEqual(TEXT("No sequence gaps"), Stats.MissingEvents, static_cast<int64>(0));
+		TestEqual(TEXT("No duplicate events"), Stats.DuplicateEvents, static_cast<int64>(0));
+		TestEqual(TEXT("No rejected requests"), Stats.RejectedRequests, static_cast<int64>(0));
+	}
+
+	Collector.Stop();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTelemetryBinaryRoundTripTest, "TelemetryPlugin.BinaryRoundTrip", TelemetryPluginTests::TestFlags)
+
+bool FTelemetryBinaryRoundTripTest::RunTest(const FString& Parameters)
+{
+	FTelemetryStringTable Strings;
+	TArray<FTelemetryEventRecord> Records;
+
+	// Reserved so the pointers AddRecord returns stay valid
+	Records.Reserve(8);
+	auto AddRecord = [&Records](ETelemetryEventType Type)
+	{
+		FTelemetryEventRecord& Record = Records.AddDefaulted_GetRef();
+		Record.Type = Type;
+		Record.Frame = 100 + Records.Num() * 3;
+		Record.GameTime = 12.5f + Records.Num() * 0.25f;
+		Record.Sequence = static_cast<uint32>(Records.Num());
+		Record.EngineFrame = static_cast<uint32>(5000 + Records.Num() * 2);
+		Record.CaptureTime = 1000.0 + Records.Num() * 0.01;
+		return &Record;
+	};
+
+	AddRecord(ETelemetryEventType::SessionStart);
+	AddRecord(ETelemetryEventType::RunStart)->StringIndex = Strings.FindOrAdd(TEXT("run-123"));
+	AddRecord(ETelemetryEventType::Position)->Position = FVector3f(100.0f, -50.0f, 25.5f);
+	AddRecord(ETelemetryEventType::InputReceived)->Name = TEXT("IA_Jump");
+
+	FTelemetryEventRecord* Damage = AddRecord(ETelemetryEventType::Damage);
+	Damage->Position = FVector3f(10.0f, 0.0f, 5.0f);
+	Damage->DamageAmount = 15.0f;
+	Damage->HealthBefore = 100.0f;
+	Damage->HealthAfter = 85.0f;
+	Damage->StringIndex = Strings.FindOrAdd(TEXT("Lava"));
+
+	// Differs from the damage source only in case - must stay a separate string
+	FTelemetryEventRecord* Death = AddRecord(ETelemetryEventType::Death);
+	Death->Position = FVector3f(12.0f, 0.0f, 5.0f);
+	Death->StringIndex = Strings.FindOrAdd(TEXT("lava"));
+	TestNotEqual(TEXT("String table is case-sensitive"), Damage->StringIndex, Death->StringIndex);
+
+	AddRecord(ETelemetryEventType::RunEnd)->StringIndex = Strings.FindOrAdd(TEXT("completed"));
+	AddRecord(ETelemetryEventType::SessionEnd);
+
+	TArray<uint8> Data;
+	TelemetryBinaryFormat::EncodeBatch(TEXT("TestMachine"), TEXT("TestSession"), &Strings, Records, Data);
+
+	TelemetryBinaryFormat::FDecodedBatch Batch;
+	FString Error;
+	if (!TestTrue(FString::Printf(TEXT("Batch decodes (%s)"), *Error), TelemetryBinaryFormat::DecodeBatch(Data, Batch, &Error)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Schema version"), static_cast<int32>(Batch.SchemaVersion), static_cast<int32>(TelemetryBinaryFormat::SchemaVersion));
+	TestEqual(TEXT("Machine ID"), Batch.MachineID, FString(TEXT("TestMachine")));
+	TestEqual(TEXT("Session ID"), Batch.SessionID, FString(TEXT("TestSession")));
+	if (!TestEqual(TEXT("Record count"), Batch.Records.Num(), Records.Num()))
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Records.Num(); ++Index)
+	{
+		const FTelemetryEventRecord& Expected = Records[Index];
+		const FTelemetryEventRecord& Actual = Batch.Records[Index];
+		const FString What = FString::Printf(TEXT("Record %d (%s)"), Index, LexToString(Expected.Type));
+
+		TestEqual(*(What + TEXT(" type")), static_cast<int32>(Actual.Type), static_cast<int32>(Expected.Type));
+		TestEqual(*(What + TEXT(" frame")), Actual.Frame, Expected.Frame);
+		TestEqual(*(What + TEXT(" game_time")), Actual.GameTime, Expected.GameTime, KINDA_SMALL_NUMBER);
+		TestEqual(*(What + TEXT(" sequence")), Actual.Sequence, Expected.Sequence);
+		TestEqual(*(What + TEXT(" engine frame")), Actual.EngineFrame, Expected.EngineFrame);
+
+		// Capture time travels as whole microseconds
+		TestEqual(*(What + TEXT(" capture time")), Actual.CaptureTime, Expected.CaptureTime, 1.0e-5);
+
+		if (Expected.Type == ETelemetryEventType::Position || Expected.Type == ETelemetryEventType::Damage || Expected.Type == ETelemetryEventType::Death)
+		{
+			TestEqual(*(What + TEXT(" position")), FVector(Actual.Position), FVector(Expected.Position), KINDA_SMALL_NUMBER);
+		}
+	}
+
+	const FTelemetryEventRecord& DecodedRunStart = Batch.Records[1];
+	const FTelemetryEventRecord& DecodedRunEnd = Batch.Records[6];
+	if (TestTrue(TEXT("Run ID index in range"), Batch.Strings.IsValidIndex(DecodedRunStart.StringIndex))
+		&& TestTrue(TEXT("End reason index in range"), Batch.Strings.IsValidIndex(DecodedRunEnd.StringIndex)))
+	{
+		TestEqual(TEXT("Run ID"), Batch.Strings[DecodedRunStart.StringIndex], FString(TEXT("run-123")));
+		TestEqual(TEXT("End reason"), Batch.Strings[DecodedRunEnd.StringIndex], FString(TEXT("completed")));
+	}
+
+	TestEqual(TEXT("Input action"), Batch.Records[3].Name.ToString(), FString(TEXT("IA_Jump")));
+
+	const FTelemetryEventRecord& DecodedDamage = Batch.Records[4];
+	TestEqual(TEXT("Damage amount"), DecodedDamage.DamageAmount, 15.0f);
+	TestEqual(TEXT("Health before"), DecodedDamage.HealthBefore, 100.0f);
+	TestEqual(TEXT("Health after"), DecodedDamage.HealthAfter, 85.0f);
+
+	const FTelemetryEventRecord& DecodedDeath = Batch.Records[5];
+	if (TestTrue(TEXT("Damage source index in range"), Batch.Strings.IsValidIndex(DecodedDamage.StringIndex))
+		&& TestTrue(TEXT("Death cause index in range"), Batch.Strings.IsValidIndex(DecodedDeath.StringIndex)))
+	{
+		TestTrue(TEXT("Damage source keeps its case"), Batch.Strings[DecodedDamage.StringIndex].Equals(TEXT("Lava"), ESearchCase::CaseSensitive));
+		TestTrue(TEXT("Death cause keeps its case"), Batch.Strings[DecodedDeath.StringIndex].Equals(TEXT("lava"), ESearchCase::CaseSensitive));
+	}
+
+	// Truncated batches are rejected rather than read past the end
+	Data.SetNum(Data.Num() - 1);
+	TelemetryBinaryFormat::FDecodedBatch Truncated;
+	TestFalse(TEXT("Truncated batch is rejected"), TelemetryBinaryFormat::DecodeBatch(Data, Truncated));
+
+	// Session records carry no payload, so a batch of them is a valid version 2 batch apart from the version
+	const uint16 OldVersion = 2;
+	const TArray<FTelemetryEventRecord> SessionRecords = {Records[0], Records.Last()};
+	TArray<uint8> V2Data;
+	TelemetryBinaryFormat::EncodeBatch(TEXT("TestMachine"), TEXT("TestSession"), &Strings, SessionRecords, V2Data);
+	FMemory::Memcpy(V2Data.GetData() + sizeof(uint32), &OldVersion, sizeof(OldVersion));
+	TelemetryBinaryFormat::FDecodedBatch V2Batch;
+	if (TestTrue(TEXT("Version 2 batch decodes"), TelemetryBinaryFormat::DecodeBatch(V2Data, V2Batch)))
+	{
+		TestEqual(TEXT("Version 2 record count"), V2Batch.Records.Num(), 2);
+		TestEqual(TEXT("Version 2 session_end sequence"), V2Batch.Records[1].Sequence, Records.Last().Sequence);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTelemetrySpoolReplayTest, "TelemetryPlugin.SpoolReplay", TelemetryPluginTests::TestFlags)
+
+bool FTelemetrySpoolReplayTest::RunTest(const FString& Parameters)
+{
+	// Not started yet - every upload of the first session is refused
+	FTelemetryLocalCollector Collector(SpoolReplayPort);
+
+	// A spool of its own, so segments the game left in Saved/Telemetry/Spool are neither replayed nor consumed
+	const FString SpoolDirectory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("TelemetrySpoolReplay"));
+	IFileManager::Get().DeleteDirectory(*SpoolDirectory, false, true);
+
+	{
+		FTestTelemetry Test(Collector.GetURL());
+		if (!TestNotNull(TEXT("Telemetry subsystem"), Test.Telemetry))
+		{
+			return false;
+		}
+		UTelemetrySubsystem& Telemetry = *Test.Telemetry;
+
+		// Failed uploads go straight back to the spool instead of being retried this session
+		FTelemetryRetrySettings NoRetry;
+		NoRetry.MaxRetries = 0;
+		Telemetry.ConfigureRetry(NoRetry);
+		Telemetry.ConfigureSpool(true, 16, SpoolDirectory);
+
+		Telemetry.StartNewSession();
+		Telemetry.StartRun();
+		for (int32 Index = 0; Index < 25; ++Index)
+		{
+			Telemetry.SendPositionUpdate(FVector(Index * 10.0, 0.0, 100.0), Index * 0.1f);
+		}
+		Telemetry.EndRun(TEXT("test"));
+		Telemetry.EndSession();
+		Telemetry.Flush();
+
+		FTelemetryBackpressureStats Offline;
+		TickUntil([&]()
+		{
+			Offline = Telemetry.GetBackpressureStats();
+			return IsDrained(Offline) && Offline.FailedUploads > 0;
+		});
+		TestTrue(TEXT("Uploads failed while the collector was down"), Offline.FailedUploads > 0);
+		TestTrue(TEXT("Events were encoded for upload"), Offline.UploadedEvents > 0);
+
+		if (!TestTrue(TEXT("Local collector started"), Collector.Start()))
+		{
+			return false;
+		}
+
+		// The next session replays what the first could not deliver
+		Telemetry.StartNewSession();
+		Telemetry.EndSession();
+		Telemetry.Flush();
+
+		FTelemetryBackpressureStats Online;
+		const bool bDelivered = TickUntil([&]()
+		{
+			Online = Telemetry.GetBackpressureStats();
+			return IsDrained(Online) && Collector.GetStats().Events >= Online.UploadedEvents;
+		});
+
+		// UploadedEvents counts both sessions' encoded events - replays are not encoded again
+		const FTelemetryLocalCollector::FStats& Stats = Collector.GetStats();
+		TestTrue(TEXT("Spooled events replayed"), bDelivered);
+		TestEqual(TEXT("Collector received both sessions"), Stats.Events, Online.UploadedEvents);
+		TestEqual(TEXT("No sequence gaps"), Stats.MissingEvents, static_cast<int64>(0));
+		TestEqual(TEXT("No duplicate events"), Stats.DuplicateEvents, static_cast<int64>(0));
+		TestEqual(TEXT("No duplicate batches"), Stats.DuplicateBatches, static_cast<int64>(0));
+	}
+
+	Collector.Stop();
+	IFileManager::Get().DeleteDirectory(*SpoolDirectory, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTelemetrySheddingTest, "TelemetryPlugin.Shedding", TelemetryPluginTests::TestFlags)
+
+bool FTelemetrySheddingTest::RunTest(const FString& Parameters)
+{
+	FTelemetryLocalCollector Collector(SheddingPort);
+	if (!TestTrue(TEXT("Local collector started"), Collector.Start()))
+	{
+		return false;
+	}
+
+	// Slow enough that one upload slot cannot keep up with the burst below
+	FTelemetryLocalCollector::FFaultSettings SlowCollector;
+	SlowCollector.LatencyMs = 500.0f;
+	Collector.SetFaults(SlowCollector);
+
+	{
+		FTestTelemetry Test(Collector.GetURL());
+		if (!TestNotNull(TEXT("Telemetry subsystem"), Test.Telemetry))
+		{
+			Collector.Stop();
+			return false;
+		}
+		UTelemetrySubsystem& Telemetry = *Test.Telemetry;
+		Telemetry.ConfigureBackpressure(1, 16);
+
+		Telemetry.StartNewSession();
+		Telemetry.StartRun();
+
+		constexpr int32 NumPositions = 2000;
+		constexpr int32 DeathInterval = 100;
+		int32 NumDeaths = 0;
+		for (int32 Index = 0; Index < NumPositions; ++Index)
+		{
+			const FVector Position(Index * 3.0, 0.0, 100.0);
+			Telemetry.SendPositionUpdate(Position, Index * 0.01f);
+			if (Index % DeathInterval == 0)
+			{
+				Telemetry.SendDeathEvent(TEXT("Spikes"), Position, Index * 0.01f);
+				++NumDeaths;
+			}
+		}
+
+		TestTrue(TEXT("Backlog shed"), TickUntil([&]() { return Telemetry.GetBackpressureStats().ShedEvents > 0; }));
+
+		// Let the collector catch up and drain the rest
+		Collector.SetFaults(FTelemetryLocalCollector::FFaultSettings());
+		Telemetry.EndRun(TEXT("test"));
+		Telemetry.EndSession();
+		Telemetry.Flush();
+
+		FTelemetryBackpressureStats Backpressure;
+		const bool bDrained = TickUntil([&]()
+		{
+			Backpressure = Telemetry.GetBackpressureStats();
+			return IsDrained(Backpressure) && Collector.GetStats().Events >= Backpressure.UploadedEvents;
+		}, 30.0);
+		TestTrue(TEXT("Session drained"), bDrained);
+
+		const FTelemetryLocalCollector::FStats& Stats = Collector.GetStats();
+		TestTrue(TEXT("Only positions were shed"), Backpressure.ShedEvents <= NumPositions);
+		TestEqual(TEXT("Nothing dropped at capture"), Backpressure.DroppedEvents, static_cast<int64>(0));
+		TestEqual(TEXT("Collector received every uploaded event"), Stats.Events, Backpressure.UploadedEvents);
+
+		// Sequences are assigned before shedding, so every gap is a shed event and nothing else went missing
+		TestEqual(TEXT("Sequence gaps are the shed events"), Stats.MissingEvents, Backpressure.ShedEvents);
+
+		// Deaths plus session_start, run_start, run_end and session_end are never shed
+		TestTrue(TEXT("Deaths and lifecycle events uploaded"), Backpressure.UploadedEvents >= NumPositions - Backpressure.ShedEvents + NumDeaths + 4);
+	}
+
+	Collector.Stop();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTelemetrySheddingRetryTest, "TelemetryPlugin.SheddingBehindRetry", TelemetryPluginTests::TestFlags)
+
+bool FTelemetrySheddingRetryTest::RunTest(const FString& Parameters)
+{
+	FTelemetryLocalCollector Collector(SheddingRetryPort);
+	if (!TestTrue(TEXT("Local collector started"), Collector.Start()))
+	{
+		return false;
+	}
+
+	// The first upload fails and waits out Retry-After, slowly enough to send more events meanwhile
+	FTelemetryLocalCollector::FFaultSettings FailingCollector;
+	FailingCollector.LatencyMs = 500.0f;
+	FailingCollector.ErrorRate = 1.0f;
+	FailingCollector.RetryAfterSeconds = 3;
+	Collector.SetFaults(FailingCollector);
+
+	{
+		FTestTelemetry Test(Collector.GetURL());
+		if (!TestNotNull(TEXT("Telemetry subsystem"), Test.Telemetry))
+		{
+			Collector.Stop();
+			return false;
+		}
+		UTelemetrySubsystem& Telemetry = *Test.Telemetry;
+
+		// Batches only go out on Flush, and the failed body alone is larger than the budget
+		constexpr int32 BacklogKilobytes = 1;
+		Telemetry.ConfigureBatching(1000, 0.0f, ETelemetryBatchFormat::JsonArray);
+		Telemetry.ConfigureBackpressure(1, BacklogKilobytes);
+
+		Telemetry.StartNewSession();
+		Telemetry.StartRun();
+		for (int32 Index = 0; Index < 20; ++Index)
+		{
+			Telemetry.SendPositionUpdate(FVector(Index * 10.0, 0.0, 100.0), Index * 0.1f);
+		}
+		Telemetry.Flush();
+		TestTrue(TEXT("First batch in flight"), TickUntil([&]() { return Telemetry.GetBackpressureStats().InFlightRequests > 0; }));
+
+		// Held back while the first batch is in flight, well within the budget
+		constexpr int32 NumHeld = 5;
+		for (int32 Index = 0; Index < NumHeld; ++Index)
+		{
+			Telemetry.SendPositionUpdate(FVector(Index * 10.0, 0.0, 200.0), 2.0f + Index * 0.1f);
+		}
+
+		FTelemetryBackpressureStats Backpressure;
+		const bool bParked = TickUntil([&]()
+		{
+			Backpressure = Telemetry.GetBackpressureStats();
+			return Backpressure.InFlightRequests == 0 && Backpressure.BacklogBytes >= BacklogKilobytes * 1024;
+		});
+		TestTrue(TEXT("Failed body parked for a retry"), bParked);
+		TestEqual(TEXT("Held-back positions kept behind the retry body"), Backpressure.BacklogEvents, NumHeld);
+		TestEqual(TEXT("Nothing shed yet"), Backpressure.ShedEvents, static_cast<int64>(0));
+
+		// New positions are refused while the body fills the budget, deaths never are
+		constexpr int32 NumRefused = 10;
+		for (int32 Index = 0; Index < NumRefused; ++Index)
+		{
+			Telemetry.SendPositionUpdate(FVector(Index * 10.0, 0.0, 300.0), 3.0f + Index * 0.1f);
+		}
+		Telemetry.SendDeathEvent(TEXT("Spikes"), FVector::ZeroVector, 4.0f);
+
+		TickUntil([&]()
+		{
+			Backpressure = Telemetry.GetBackpressureStats();
+			return Backpressure.ShedEvents >= NumRefused && Backpressure.BacklogEvents > NumHeld;
+		});
+		TestEqual(TEXT("New positions refused"), Backpressure.ShedEvents, static_cast<int64>(NumRefused));
+		TestEqual(TEXT("Held-back positions and the death kept"), Backpressure.BacklogEvents, NumHeld + 1);
+
+		// The retry goes through once the collector recovers
+		Collector.SetFaults(FTelemetryLocalCollector::FFaultSettings());
+		Telemetry.EndRun(TEXT("test"));
+		Telemetry.EndSession();
+		Telemetry.Flush();
+
+		const bool bDrained = TickUntil([&]()
+		{
+			Backpressure = Telemetry.GetBackpressureStats();
+			return IsDrained(Backpressure) && Backpressure.BacklogBytes == 0 && Collector.GetStats().Events >= Backpressure.UploadedEvents;
+		}, 30.0);
+		TestTrue(TEXT("Session drained"), bDrained);
+
+		const FTelemetryLocalCollector::FStats& Stats = Collector.GetStats();
+		TestEqual(TEXT("Collector received every uploaded event"), Stats.Events, Backpressure.UploadedEvents);
+		TestEqual(TEXT("Sequence gaps are the refused events"), Stats.MissingEvents, Backpressure.ShedEvents);
+	}
+
+	Collector.Stop();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTelemetryCaptureAllocationTest, "TelemetryPlugin.CaptureAllocations", TelemetryPluginTests::TestFlags)
+
+bool FTelemetryCaptureAllocationTest::RunTest(const FString& Parameters)
+{
+	FTelemetryLocalCollector Collector(AllocationPort);
+	if (!TestTrue(TEXT("Local collector started"), Collector.Start()))
+	{
+		return false;
+	}
+
+	{
+		FTestTelemetry Test(Collector.GetURL());
+		if (!TestNotNull(TEXT("Telemetry subsystem"), Test.Telemetry))
+		{
+			Collector.Stop();
+			return false;
+		}
+		UTelemetrySubsystem& Telemetry = *Test.Telemetry;
+
+		// Recording and heatmaps store what they capture by design - only the event path is measured
+		Telemetry.ConfigureGhostRecording(FTelemetryGhostSettings());
+		Telemetry.ConfigureHeatmap(FTelemetryHeatmapSettings());
+		Telemetry.StartNewSession();
+		Telemetry.StartRun();
+
+		TStrongObjectPtr<UInputAction> InputAction(NewObject<UInputAction>(GetTransientPackage(), TEXT("IA_Jump")));
+
+		constexpr int32 NumEvents = 1000;
+		auto SendEvents = [&](float StartTime)
+		{
+			for (int32 Index = 0; Index < NumEvents; ++Index)
+			{
+				const float GameTime = StartTime + Index * 0.01f;
+				Telemetry.SendPositionUpdate(FVector(Index * 3.0, 0.0, 100.0), GameTime);
+				Telemetry.SendPlayerInputAction(InputAction.Get(), GameTime);
+			}
+		};
+
+		// Warm up - run aggregates see the action once, queues and the worker reach their working size
+		SendEvents(0.0f);
+		Telemetry.Flush();
+		TestTrue(TEXT("Warmup drained"), TickUntil([&]() { return IsDrained(Telemetry.GetBackpressureStats()); }));
+
+		FTelemetryCountingMalloc& CountingMalloc = FTelemetryCountingMalloc::Get();
+		CountingMalloc.ResetAllocationCount();
+		CountingMalloc.StartCounting();
+		SendEvents(100.0f);
+		CountingMalloc.StopCounting();
+
+		TestEqual(TEXT("Allocations while capturing position and input events"), CountingMalloc.GetAllocationCount(), static_cast<uint64>(0));
+
+		Telemetry.EndRun(TEXT("test"));
+		Telemetry.EndSession();
+		Telemetry.Flush();
+		TickUntil([&]() { return IsDrained(Telemetry.GetBackpressureStats()); });
+	}
+
+	Collector.Stop();
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
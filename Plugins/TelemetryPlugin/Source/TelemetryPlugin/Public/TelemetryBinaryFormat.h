@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryEventRecord.h"
+
+class FTelemetryStringTable;
+
+/**
+ * Compact binary encoding for telemetry batches
+ * All values are little-endian.
+ *
+ * BATCH LAYOUT:
+ * - Header (fixed, 40 bytes):
+ *     uint32 Magic ('TLMB'), uint16 SchemaVersion, uint16 Flags,
+ *     uint32 EventCount, uint16 StringCount, uint16 Reserved,
+ *     int32 BaseFrame, float BaseGameTime,
+ *     uint32 BaseSequence, uint32 BaseEngineFrame, double BaseCaptureTime
+ * - String table: StringCount x (uint16 ByteLength + UTF-8 bytes)
+ *     index 0 = machine_id, index 1 = session_id, then payload strings
+ * - Records: EventCount x fixed-size record for its type
+ *     common: uint8 TypeTag, int32 FrameDelta, float GameTimeDelta,
+ *             int32 SequenceDelta, int32 EngineFrameDelta, int32 CaptureDeltaMicros
+ *     Position:      + float X, Y, Z
+ *     InputReceived: + uint16 ActionNameIndex
+ *     Damage:        + float X, Y, Z, Damage, HealthBefore, HealthAfter + uint16 SourceIndex
+ *     Death:         + float X, Y, Z + uint16 CauseIndex
+ *     RunStart:      + uint16 RunIDIndex
+ *     RunEnd:        + uint16 EndReasonIndex
+ *     session_start / session_end carry no payload
+ *
+ * Frame, game_time, sequence, engine frame and capture time are delta-encoded against the
+ * previous record (the first record against the header's base values). Capture time is on the
+ * client's FPlatformTime clock - differences between events are meaningful, the value is not.
+ * Version 2 batches (run records without payload) and version 1 batches (24-byte header, no
+ * sequence/engine frame/capture time either) still decode.
+ */
+namespace TelemetryBinaryFormat
+{
+	static constexpr uint32 Magic = 0x424D4C54; // "TLMB"
+	static constexpr uint16 SchemaVersion = 3;
+	static constexpr int32 HeaderSize = 40;
+
+	/** Content-Type used when uploading binary batches */
+	static const TCHAR* const ContentType = TEXT("application/vnd.telemetry.batch");
+
+	/** Size of a record's fixed part for the given type in the current version, or INDEX_NONE if unknown */
+	TELEMETRYPLUGIN_API int32 GetRecordSize(ETelemetryEventType Type);
+
+	/**
+	 * Encode one batch of events from a single session
+	 * @param MachineID - Written once into the string table
+	 * @param SessionID - Written once into the string table
+	 * @param SessionStrings - Table the damage, death and run records' StringIndex refers to
+	 * @param Records - Events in upload order (unknown types are skipped)
+	 * @param OutData - Encoded batch is appended here
+	 */
+	TELEMETRYPLUGIN_API void EncodeBatch(
+		const FString& MachineID,
+		const FString& SessionID,
+		const FTelemetryStringTable* SessionStrings,
+		TConstArrayView<FTelemetryEventRecord> Records,
+		TArray<uint8>& OutData);
+
+	/** Result of decoding a binary batch */
+	struct FDecodedBatch
+	{
+		uint16 SchemaVersion = 0;
+		FString MachineID;
+		FString SessionID;
+
+		/** The batch's string table - damage, death and run records' StringIndex points into it */
+		TArray<FString> Strings;
+
+		TArray<FTelemetryEventRecord> Records;
+	};
+
+	/**
+	 * Decode a batch produced by EncodeBatch
+	 * @return false if the data is truncated, has the wrong magic or an unsupported schema version
+	 */
+	TELEMETRYPLUGIN_API bool DecodeBatch(TConstArrayView<uint8> Data, FDecodedBatch& OutBatch, FString* OutError = nullptr);
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Event types understood by the telemetry pipeline
+ * Values are stable - they are used as numeric tags on the wire
+ */
+enum class ETelemetryEventType : uint8
+{
+	SessionStart = 0,
+	SessionEnd = 1,
+	RunStart = 2,
+	RunEnd = 3,
+	Position = 4,
+	InputReceived = 5,
+	Damage = 6,
+	Death = 7,
+	FramePerformance = 8,
+	RunSummary = 9,
+	Heatmap = 10,
+	PositionFrame = 11,
+	InputSpan = 12,
+	DeliveryReport = 13
+	// New types go here - keep NumTelemetryEventTypes pointing at the last one
+};
+
+/** Size of arrays indexed by ETelemetryEventType */
+inline constexpr int32 NumTelemetryEventTypes = static_cast<int32>(ETelemetryEventType::DeliveryReport) + 1;
+static_assert(NumTelemetryEventTypes <= 32, "Sink and HTTP filters keep one bit per event type in a uint32");
+
+/** event_type string used in JSON output */
+inline const TCHAR* LexToString(ETelemetryEventType Type)
+{
+	switch (Type)
+	{
+	case ETelemetryEventType::SessionStart:  return TEXT("session_start");
+	case ETelemetryEventType::SessionEnd:    return TEXT("session_end");
+	case ETelemetryEventType::RunStart:      return TEXT("run_start");
+	case ETelemetryEventType::RunEnd:        return TEXT("run_end");
+	case ETelemetryEventType::Position:      return TEXT("position");
+	case ETelemetryEventType::InputReceived: return TEXT("input_received");
+	case ETelemetryEventType::Damage:        return TEXT("damage");
+	case ETelemetryEventType::Death:         return TEXT("death");
+	case ETelemetryEventType::FramePerformance: return TEXT("frame_performance");
+	case ETelemetryEventType::RunSummary:    return TEXT("run_summary");
+	case ETelemetryEventType::Heatmap:       return TEXT("heatmap");
+	case ETelemetryEventType::PositionFrame: return TEXT("position_frame");
+	case ETelemetryEventType::InputSpan:     return TEXT("input_span");
+	case ETelemetryEventType::DeliveryReport: return TEXT("delivery_report");
+	default:                                 return TEXT("unknown");
+	}
+}
+
+/**
+ * Parse an event_type string
+ * @return false if no event type has that name
+ */
+inline bool LexFromString(ETelemetryEventType& OutType, const TCHAR* Name)
+{
+	for (int32 Index = 0; Index < NumTelemetryEventTypes; ++Index)
+	{
+		const ETelemetryEventType Type = static_cast<ETelemetryEventType>(Index);
+		if (FCString::Stricmp(LexToString(Type), Name) == 0)
+		{
+			OutType = Type;
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Session and run boundaries - every sink receives them regardless of its filter */
+inline bool IsLifecycleEvent(ETelemetryEventType Type)
+{
+	return Type == ETelemetryEventType::SessionStart
+		|| Type == ETelemetryEventType::SessionEnd
+		|| Type == ETelemetryEventType::RunStart
+		|| Type == ETelemetryEventType::RunEnd;
+}
+
+/**
+ * Compact, self-contained event as captured by the game (or any other) thread
+ * Only plain, trivially copyable values are stored here so capturing an event never
+ * allocates - all JSON and HTTP work happens on the worker
+ */
+struct FTelemetryEventRecord
+{
+	ETelemetryEventType Type = ETelemetryEventType::Position;
+
+	/** Event counter value assigned at capture time */
+	int32 Frame = 0;
+
+	float GameTime = 0.0f;
+
+	/** Per-session sequence, assigned by the worker once the event is certain to be emitted */
+	uint32 Sequence = 0;
+
+	/** Engine frame (GFrameCounter) the event was captured on */
+	uint32 EngineFrame = 0;
+
+	/** FPlatformTime::Seconds() at capture, for delivery latency */
+	double CaptureTime = 0.0;
+
+	FVector3f Position = FVector3f::ZeroVector;
+
+	/** Damage payload (Damage events only) */
+	float DamageAmount = 0.0f;
+	float HealthBefore = 0.0f;
+	float HealthAfter = 0.0f;
+
+	/** Input action name, or the numbered key of a payload the worker holds (see HasHeldPayload, HasHeldID) */
+	FName Name;
+
+	/** Damage source, death cause, run ID or end reason - index into the session's FTelemetryStringTable */
+	uint32 StringIndex = 0;
+
+	/** Low-value event that may be shed under backpressure - lifecycle and outcome events never are */
+	bool IsSheddable() const
+	{
+		return Type == ETelemetryEventType::Position
+			|| Type == ETelemetryEventType::InputReceived
+			|| Type == ETelemetryEventType::PositionFrame
+			|| Type == ETelemetryEventType::InputSpan;
+	}
+
+	/** Variable-size payload held by the worker, keyed by Name */
+	bool HasHeldPayload() const
+	{
+		return Type == ETelemetryEventType::FramePerformance
+			|| Type == ETelemetryEventType::RunSummary
+			|| Type == ETelemetryEventType::Heatmap
+			|| Type == ETelemetryEventType::PositionFrame
+			|| Type == ETelemetryEventType::InputSpan
+			|| Type == ETelemetryEventType::DeliveryReport;
+	}
+
+	/** Session ID held by the worker, keyed by Name - free-form IDs stay out of the name table */
+	bool HasHeldID() const
+	{
+		return Type == ETelemetryEventType::SessionStart;
+	}
+
+	/** Does this event carry a player position */
+	bool HasPosition() const
+	{
+		return Type == ETelemetryEventType::Position
+			|| Type == ETelemetryEventType::Damage
+			|| Type == ETelemetryEventType::Death;
+	}
+};
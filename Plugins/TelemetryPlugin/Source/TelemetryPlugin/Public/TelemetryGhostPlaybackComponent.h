@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TelemetryGhostPlaybackComponent.generated.h"
+
+struct FTelemetryGhostRecording;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTelemetryGhostInput, FName, Action, float, Duration);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnTelemetryGhostFinished);
+
+/**
+ * Drives its owner along a recorded run (.tlmg ghost file)
+ * Location is interpolated linearly and rotation spherically between samples, so playback is
+ * smooth at any frame rate. Recorded input presses are raised as OnGhostInput at their time,
+ * e.g. to play a jump animation on the ghost. Collision is ignored while moving.
+ */
+UCLASS(ClassGroup=(Telemetry), meta=(BlueprintSpawnableComponent))
+class TELEMETRYPLUGIN_API UTelemetryGhostPlaybackComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTelemetryGhostPlaybackComponent();
+
+	/** 
+	 * Load a ghost file, stopping any playback
+	 * @param Path - File written by the ghost recorder, see UTelemetrySubsystem::GetLastGhostRecordingPath
+	 * @return false if the file is missing, not a ghost file, or has no samples
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry|Ghost", meta=(Keywords="ghost replay load telemetry"))
+	bool LoadRecording(const FString& Path);
+
+	/** Start moving the owner from StartTime seconds into the recording */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry|Ghost", meta=(Keywords="ghost replay play telemetry"))
+	void Play(float StartTime = 0.0f);
+
+	/** Stop moving the owner, leaving it where it is */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry|Ghost", meta=(Keywords="ghost replay stop telemetry"))
+	void Stop();
+
+	UFUNCTION(BlueprintPure, Category = "Telemetry|Ghost")
+	bool IsPlaying() const;
+
+	/** Length of the loaded recording in seconds */
+	UFUNCTION(BlueprintPure, Category = "Telemetry|Ghost")
+	float GetDuration() const;
+
+	UFUNCTION(BlueprintPure, Category = "Telemetry|Ghost")
+	float GetPlaybackTime() const { return PlaybackTime; }
+
+	/** Restart from the beginning when the end is reached */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry|Ghost")
+	bool bLoop = false;
+
+	/** Playback speed multiplier */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry|Ghost", meta=(ClampMin="0.0"))
+	float PlaybackRate = 1.0f;
+
+	/** A recorded input press was reached */
+	UPROPERTY(BlueprintAssignable, Category = "Telemetry|Ghost")
+	FOnTelemetryGhostInput OnGhostInput;
+
+	/** Playback reached the end (not raised when looping) */
+	UPROPERTY(BlueprintAssignable, Category = "Telemetry|Ghost")
+	FOnTelemetryGhostFinished OnPlaybackFinished;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	/** Move the owner to PlaybackTime and raise inputs passed since the last call */
+	void ApplyPlaybackTime();
+
+	/** Put the cursors at PlaybackTime, without raising inputs */
+	void Seek();
+
+	TSharedPtr<FTelemetryGhostRecording> Recording;
+	float PlaybackTime = 0.0f;
+
+	/** Sample at or before PlaybackTime, and next input to raise - both only move forward */
+	int32 SampleCursor = 0;
+	int32 InputCursor = 0;
+};
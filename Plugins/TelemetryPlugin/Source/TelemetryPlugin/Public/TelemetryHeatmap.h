@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TelemetryTypes.h"
+
+/** What a heatmap cell counts */
+enum class ETelemetryHeatmapLayer : uint8
+{
+	Position = 0,
+	Damage = 1,
+	Death = 2,
+	Num
+};
+
+/**
+ * Sparse 2D grid of event counts on one world plane
+ * Cells are grouped into fixed TileCells x TileCells tiles kept in a hash map, each tile holding
+ * a dense count array per layer - so adding is one hash lookup and an increment, and memory
+ * only grows where players actually went.
+ *
+ * SERIALIZED LAYOUT (little-endian):
+ * - uint32 Magic ('TLMH'), uint16 SchemaVersion, uint8 Plane, uint8 LayerCount,
+ *   float CellSize, uint32 TileCount
+ * - TileCount x: int32 TileX, int32 TileY, then per layer:
+ *     uint16 CellCount + CellCount x (uint8 CellIndex, uint32 Count)
+ *   CellIndex is Y * TileCells + X within the tile, only non-zero cells are written.
+ * Tiles are written in (TileY, TileX) order so equal heatmaps serialize identically.
+ */
+class TELEMETRYPLUGIN_API FTelemetryHeatmap
+{
+public:
+	static constexpr int32 TileShift = 4;
+	static constexpr int32 TileCells = 1 << TileShift;
+	static constexpr int32 CellsPerTile = TileCells * TileCells;
+	static constexpr int32 NumLayers = static_cast<int32>(ETelemetryHeatmapLayer::Num);
+	static constexpr uint32 Magic = 0x484D4C54; // "TLMH"
+	static constexpr uint16 SchemaVersion = 1;
+
+	explicit FTelemetryHeatmap(float InCellSize = 100.0f, ETelemetryHeatmapPlane InPlane = ETelemetryHeatmapPlane::XZ);
+
+	/** Drop all counts and switch grid settings */
+	void Reset(float InCellSize, ETelemetryHeatmapPlane InPlane);
+
+	/** Count one event at a world position */
+	void Add(ETelemetryHeatmapLayer Layer, const FVector& Position, uint32 Count = 1);
+
+	/**
+	 * Add every count of another heatmap into this one
+	 * @return false (and nothing merged) if cell size or plane differ
+	 */
+	bool Merge(const FTelemetryHeatmap& Other);
+
+	/** Count in one cell, cell coordinates as produced from world position / CellSize */
+	uint32 GetCount(ETelemetryHeatmapLayer Layer, const FIntPoint& Cell) const;
+
+	/** Visit every non-zero cell */
+	void ForEachCell(TFunctionRef<void(ETelemetryHeatmapLayer Layer, const FIntPoint& Cell, uint32 Count)> Visitor) const;
+
+	bool IsEmpty() const { return Tiles.IsEmpty(); }
+	int32 GetNumTiles() const { return Tiles.Num(); }
+	float GetCellSize() const { return CellSize; }
+	ETelemetryHeatmapPlane GetPlane() const { return Plane; }
+
+	/** Append the compact encoding to OutData */
+	void Serialize(TArray<uint8>& OutData) const;
+
+	/**
+	 * Rebuild a heatmap written by Serialize
+	 * @return false if the data is truncated, has the wrong magic or an unsupported schema version
+	 */
+	static bool Deserialize(TConstArrayView<uint8> Data, FTelemetryHeatmap& OutHeatmap, FString* OutError = nullptr);
+
+private:
+	struct FTile
+	{
+		uint32 Counts[NumLayers][CellsPerTile] = {};
+	};
+
+	FIntPoint ToCell(const FVector& Position) const;
+	FTile& FindOrAddTile(const FIntPoint& TileCoord);
+
+	float CellSize = 100.0f;
+	ETelemetryHeatmapPlane Plane = ETelemetryHeatmapPlane::XZ;
+
+	/** Heap-allocated so rehashing moves pointers, not 3 KB tiles */
+	TMap<FIntPoint, TUniquePtr<FTile>> Tiles;
+};
@@ -3,9 +3,22 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+class FTelemetryDispatcher;
+
 class FTelemetryPluginModule : public IModuleInterface
 {
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+	static FTelemetryPluginModule& Get()
+	{
+		return FModuleManager::LoadModuleChecked<FTelemetryPluginModule>("TelemetryPlugin");
+	}
+
+	/** Shared by every game instance's telemetry, created when the first one starts */
+	TSharedRef<FTelemetryDispatcher, ESPMode::ThreadSafe> GetDispatcher();
+
+private:
+	TSharedPtr<FTelemetryDispatcher, ESPMode::ThreadSafe> Dispatcher;
 };
@@ -22,10 +22,12 @@ public:
 	 * Configure telemetry server endpoint
 	 * Call once at game start before using any other telemetry functions
 	 * @param ServerURL - Full HTTP endpoint (e.g., "http://10.20.5.27:8080/telemetry")
+	 * @param WireFormat - Upload events as JSON or as compact binary batches
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Telemetry",
 		meta=(WorldContext="WorldContextObject", Keywords="config setup start telemetry"))
-	static void ConfigureTelemetry(const UObject* WorldContextObject, const FString& ServerURL);
+	static void ConfigureTelemetry(const UObject* WorldContextObject, const FString& ServerURL,
+		ETelemetryWireFormat WireFormat = ETelemetryWireFormat::Json);
 
 	/** 
 	 * Start new telemetry session
@@ -71,10 +73,11 @@ public:
 	/** 
 	 * Log position update
 	 * Typically called on a timer for player tracking
+	 * @param bIsAirborne - Player is jumping/falling (feeds the run summary's time airborne)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Telemetry",
 		meta=(WorldContext="WorldContextObject", Keywords="position location telemetry"))
-	static void LogPosition(const UObject* WorldContextObject, FVector Position, float GameTime);
+	static void LogPosition(const UObject* WorldContextObject, FVector Position, float GameTime, bool bIsAirborne = false);
 
 	/** 
 	 * Log input action
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Crc.h"
+#include <atomic>
+
+/** TMap key funcs for FString keys that only match with the same case - FString's own hash and == ignore it */
+template <typename ValueType>
+struct TTelemetryCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, ValueType>, FString, false>
+{
+	using Super = BaseKeyFuncs<TPair<FString, ValueType>, FString, false>;
+
+	static typename Super::KeyInitType GetSetKey(typename Super::ElementInitType Element)
+	{
+		return Element.Key;
+	}
+
+	static bool Matches(typename Super::KeyInitType A, typename Super::KeyInitType B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static uint32 GetKeyHash(typename Super::KeyInitType Key)
+	{
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+/**
+ * Case-sensitive table of one session's free-form strings - damage sources, death causes, end reasons
+ * Events carry an index into it instead of an FName, so arbitrary strings never enter the global
+ * name table and "Lava" stays distinct from "lava". Strings are never moved or removed, so Get
+ * needs no lock and its reference stays valid for the table's lifetime. Index 0 is the empty string.
+ */
+class TELEMETRYPLUGIN_API FTelemetryStringTable
+{
+public:
+	FTelemetryStringTable();
+
+	/** Index of Value, added on first use - safe to call from any thread */
+	uint32 FindOrAdd(const FString& Value);
+
+	/** String at Index, empty if the table never handed it out - safe to call from any thread */
+	const FString& Get(uint32 Index) const;
+
+	/** Strings added so far, including the empty one */
+	uint32 Num() const { return NumStrings.load(std::memory_order_acquire); }
+
+private:
+	static constexpr uint32 ChunkSize = 256;
+	static constexpr uint32 MaxChunks = 256;
+
+	/** Fixed chunks, allocated as the table grows - published strings never move */
+	TUniquePtr<FString[]> Chunks[MaxChunks];
+	std::atomic<uint32> NumStrings{0};
+
+	/** Index of every string added and the full warning, guarded by Lock */
+	TMap<FString, uint32, FDefaultSetAllocator, TTelemetryCaseSensitiveKeyFuncs<uint32>> Indices;
+	bool bWarnedFull = false;
+	FCriticalSection Lock;
+};
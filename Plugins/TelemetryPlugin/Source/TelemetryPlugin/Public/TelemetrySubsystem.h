@@ -3,9 +3,28 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Http.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
 #include "TelemetryTypes.h"
+#include <atomic>
 #include "TelemetrySubsystem.generated.h"
 
+class FTelemetryWorker;
+class FTelemetryPositionSampler;
+class FTelemetryEventPolicies;
+class FTelemetryFramePerformanceCollector;
+class FTelemetryHeatmap;
+class UTelemetryTrackerComponent;
+class UTelemetryInputCapture;
+class FTelemetryGhostRecorder;
+class FTelemetryMemorySink;
+class FTelemetryStreamTransport;
+class AGameModeBase;
+class APlayerController;
+struct FTelemetryInputSpan;
+enum class ETelemetryHeatmapLayer : uint8;
+struct FTelemetryEventRecord;
+
 /**
  * Game Instance Subsystem for sending telemetry to HTTP endpoint
  * Automatically managed by UGameInstance - no manual instantiation needed
@@ -14,8 +33,87 @@
  * - Base fields: machine_id, session_id, event_type, frame, game_time
  * - Run data: run_id, run_start_time, run_end_time, run_total_time
  * - Event-specific fields: position, damage, input, etc.
+ * THREADING:
+ * Event functions only capture a compact record and push it onto a lock-free queue,
+ * so they may be called from any thread once a session is active.
+ * JSON serialization and HTTP dispatch run on a telemetry thread shared by every game instance
+ * in the process (PIE clients, in-process bots): one thread, one upload budget
+ * (MaxInFlightRequests counts all instances), one spool and one stream per collector URL.
+ * Each instance keeps its own session, run IDs and sequence numbers.
+ * BATCHING:
+ * Events are queued in memory and uploaded together as one request when
+ * MaxBatchSize events are pending or every FlushInterval seconds,
+ * and always on EndRun / EndSession / Deinitialize.
+ * SINKS:
+ * Events fan out to the sinks listed in ini (+Sinks=(Name=..,Type=..,EventTypes=(..))): the HTTP
+ * upload, rotating local NDJSON/binary files, an in-memory buffer for tests (GetCapturedEvents) and
+ * fire-and-forget UDP. Each sink receives only its EventTypes, plus session/run lifecycle events.
+ * Local sinks get events at batching time, before HTTP backpressure can hold them back or shed
+ * them. Without a Sinks entry, everything goes to HTTP only; without an HTTP sink, Configure is
+ * not needed.
+ * SPOOL:
+ * Batches are persisted to disk before upload and deleted once acknowledged;
+ * anything left over is replayed in the background on the next StartNewSession.
+ * STREAMING:
+ * With Streaming.bEnabled, StartNewSession opens a WebSocket to the collector and batch bodies
+ * are framed onto it with a sequence number instead of paying for a POST each. The collector
+ * acks by sequence; a dropped stream reconnects with backoff and resumes from the first
+ * unacknowledged frame. While it is down or too far behind, batches are POSTed as before.
+ * BACKPRESSURE:
+ * At most MaxInFlightRequests uploads are outstanding. While the collector is behind, events
+ * are held back; past MaxBacklogKilobytes, position frames, positions and then input
+ * events are shed.
+ * Session, run, damage and death events are never shed. See GetBackpressureStats.
+ * Failed uploads (connection errors, timeouts, 408, 429, 5xx) are retried with jittered
+ * exponential backoff while the retry budget lasts, each carrying an Idempotency-Key so the
+ * collector can drop repeats. Batches shrink on errors and slow responses and grow back on
+ * fast successes (Retry in ini).
+ * POLICIES:
+ * Position, input, damage and death events each have a sample rate, rate limit and coalescing
+ * window (PositionPolicy etc. in ini, Telemetry.<Type>.* console variables at runtime),
+ * checked before the event is built.
+ * RUN SUMMARY:
+ * Each run keeps O(1)-per-event aggregates (distance, time airborne, input counts per action,
+ * damage by source, deaths, rooms cleared) and sends them as one run_summary event before
+ * run_end. With bSummaryOnly, raw position and input events are not uploaded at all.
+ * HEATMAP:
+ * With Heatmap.bEnabled, position updates, damage and deaths are also counted in a sparse tile
+ * grid (FTelemetryHeatmap) on the configured plane, sent as one base64 heatmap event per run or
+ * per session. Grids from many sessions merge offline with -run=TelemetryHeatmapMerge.
+ * FRAME PERFORMANCE:
+ * With FramePerformance.bEnabled, each run ends with one frame_performance event (sent just
+ * before run_end, same run_id) holding log-bucketed frame, game-thread and render-thread time
+ * histograms, hitch counts per threshold and memory high-water marks.
+ * TRACKING:
+ * Actors with a UTelemetryTrackerComponent (added by hand, or automatically to AutoTrackClasses)
+ * are sampled together TrackerSampleRate times a second in one native pass and sent as a single
+ * position_frame event (parallel actors/x/y/z arrays). Player trackers also feed the run summary
+ * and heatmap, replacing a Blueprint timer calling SendPositionUpdate (whose updates then no
+ * longer count towards them, so a leftover timer does not double the distance).
+ * INPUT CAPTURE:
+ * With InputCapture.bEnabled, every action of the configured mapping context (IMC_SideScroller)
+ * is bound natively on the local player's Enhanced Input component when they log in. Each press
+ * becomes one input_span event (start time, duration, trigger count, per-axis value range) -
+ * a held action firing Triggered every frame is a single span, with no Blueprint involved.
+ * GHOST RECORDING:
+ * With Ghost.bEnabled, each run streams the player pawn's transform (SampleRate per second) and
+ * input presses to Saved/Telemetry/Ghosts/<run_id>.tlmg through a fixed-size ring, so memory use
+ * does not grow with run length. UTelemetryGhostPlaybackComponent replays a file on any actor.
+ * PROFILING:
+ * "stat Telemetry" shows the plugin's own cost per frame (event building, enqueue, serialization,
+ * compression, dispatch) and its event, byte, queue depth and latency counters. The same scopes
+ * are traced on the Telemetry channel for Unreal Insights (-trace=cpu,telemetry).
+ * Every event carries seq (per session, no gaps unless events were shed or sent to other sinks),
+ * engine_frame and capture_us (monotonic microseconds since session_start). A delivery_report
+ * every DeliveryReportInterval gives capture-to-collector latency percentiles, split into queue,
+ * serialization and round-trip time.
+ * STRING DICTIONARY:
+ * With bUseStringDictionary, JSON input actions, damage sources and death causes are sent
+ * as session-scoped IDs (action_id, damage_source_id, cause_id). Every body starts with a
+ * "dictionary" event (string_id, value) for each ID it uses, so no body depends on another.
+ * Defaults can be set in DefaultGame.ini under [/Script/TelemetryPlugin.TelemetrySubsystem]
  */
-UCLASS()
+UCLASS(Config=Game)
 class TELEMETRYPLUGIN_API UTelemetrySubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
@@ -25,10 +123,99 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
-	/** Configure the server endpoint - call this in GameInstance*/
+	/** 
+	 * Configure the server endpoint - call this in GameInstance
+	 * @param ServerURL - Full HTTP endpoint, empty uses the default lab server
+	 *                    (-TelemetryURL=<url> on the command line overrides both)
+	 * @param WireFormat - Upload events as JSON or as compact binary batches
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Telemetry",
 		meta=(Keywords="start setup config configure endpoint telemetry"))
-	void Configure(const FString& ServerURL);
+	void Configure(const FString& ServerURL, ETelemetryWireFormat WireFormat = ETelemetryWireFormat::Json);
+
+	/** 
+	 * Configure how events are batched before upload
+	 * @param InMaxBatchSize - Flush as soon as this many events are queued (1 = no batching)
+	 * @param InFlushInterval - Flush queued events at least this often, in seconds (0 = size-based only)
+	 * @param InBatchFormat - Upload body layout (JSON array or NDJSON)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="batch flush interval config telemetry"))
+	void ConfigureBatching(int32 InMaxBatchSize, float InFlushInterval, ETelemetryBatchFormat InBatchFormat);
+
+	/** 
+	 * Configure compression of upload bodies
+	 * @param InCompression - Compression method, sent as the Content-Encoding header
+	 * @param InMinCompressBytes - Bodies smaller than this are sent uncompressed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="compression gzip deflate config telemetry"))
+	void ConfigureCompression(ETelemetryCompression InCompression, int32 InMinCompressBytes);
+
+	/** 
+	 * Configure the on-disk spool
+	 * Disable it before StartNewSession to keep spooled batches from other sessions untouched
+	 * @param bInEnabled - Persist batches until the collector acknowledges them
+	 * @param InMaxSpoolMegabytes - Disk budget, oldest segments are dropped beyond this
+	 * @param InSpoolDirectory - Where segments are written, empty for Saved/Telemetry/Spool
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="spool disk offline config telemetry"))
+	void ConfigureSpool(bool bInEnabled, int32 InMaxSpoolMegabytes, const FString& InSpoolDirectory = TEXT(""));
+
+	/** 
+	 * Configure how much upload work may pile up while the collector is slow
+	 * @param InMaxInFlightRequests - Uploads outstanding at once, further batches wait
+	 * @param InMaxBacklogKilobytes - Held-back events beyond this shed position/input events (0 = never shed)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="backpressure in flight backlog drop config telemetry"))
+	void ConfigureBackpressure(int32 InMaxInFlightRequests, int32 InMaxBacklogKilobytes);
+
+	/** 
+	 * Configure upload retries and adaptive batch sizing
+	 * @param InRetry - Backoff, retry budget and batch size bounds
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="retry backoff jitter batch size config telemetry"))
+	void ConfigureRetry(const FTelemetryRetrySettings& InRetry);
+
+	/** 
+	 * Replace the configured sinks
+	 * @param InSinks - Destinations and their event filters, empty = HTTP only
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="sink file udp memory output config telemetry"))
+	void ConfigureSinks(const TArray<FTelemetrySinkSettings>& InSinks);
+
+	/** 
+	 * Configure the WebSocket stream to the collector
+	 * Takes effect at the next StartNewSession. Instances streaming to the same URL share one
+	 * socket, whose settings are those of the instance that opened it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="stream websocket connection config telemetry"))
+	void ConfigureStreaming(const FTelemetryStreamingSettings& InStreaming);
+
+	/** Events captured so far by a Memory sink, as JSON strings, oldest first */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry", meta=(Keywords="sink memory captured events test telemetry"))
+	TArray<FString> GetCapturedEvents(FName SinkName) const;
+
+	/** Forget the events a Memory sink captured so far */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry", meta=(Keywords="sink memory clear test telemetry"))
+	void ClearCapturedEvents(FName SinkName);
+
+	/** In-flight uploads, backlog and shed/dropped event counts */
+	UFUNCTION(BlueprintPure, Category = "Telemetry", meta=(Keywords="backpressure backlog drop stats telemetry"))
+	FTelemetryBackpressureStats GetBackpressureStats() const;
+
+	/** Compression ratio and CPU cost so far */
+	UFUNCTION(BlueprintPure, Category = "Telemetry", meta=(Keywords="compression stats ratio telemetry"))
+	FTelemetryCompressionStats GetCompressionStats() const;
+
+	/** Upload all queued events immediately */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry", meta=(Keywords="flush send batch telemetry"))
+	void Flush();
 
 	/** Start a new session - call on startup (will prob need delay)*/
 	UFUNCTION(BlueprintCallable, Category = "Telemetry", meta=(Keywords = "start session telemetry"))
@@ -58,9 +245,88 @@ public:
 		meta=(Keywords="end run telemetry"))
 	void EndRun(const FString& Reason);
 
-	/** Send position update - call from a timer */
+	/** Count a cleared room/arena in the current run's summary */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry", meta=(Keywords="room cleared progress telemetry"))
+	void IncrementRoomsCleared();
+
+	/** 
+	 * Configure adaptive position sampling
+	 * When enabled, SendPositionUpdate drops samples a linear predictor would reconstruct
+	 * within the error tolerance, so a fast timer costs little while the player idles or runs straight
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="adaptive position sampling dead reckoning config telemetry"))
+	void ConfigureAdaptivePositionSampling(const FTelemetryAdaptiveSamplingSettings& Settings);
+
+	/** 
+	 * Configure per-run frame performance collection
+	 * When enabled, frame/game-thread/render-thread time histograms, hitch counts and memory
+	 * high-water marks are collected from StartRun and sent as one frame_performance event in EndRun
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="frame time hitch performance histogram config telemetry"))
+	void ConfigureFramePerformance(const FTelemetryFramePerformanceSettings& Settings);
+
+	/** 
+	 * Configure the client-side heatmap
+	 * When enabled, position updates, damage and deaths are counted in a sparse grid on the
+	 * chosen plane and sent as one heatmap event per run or per session
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="heatmap grid spatial config telemetry"))
+	void ConfigureHeatmap(const FTelemetryHeatmapSettings& Settings);
+
+	/** 
+	 * Configure the native tracker pass
+	 * @param InSampleRate - Position frames per second for all tracked actors (0 = disabled)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="tracker tracking position frame rate config telemetry"))
+	void ConfigureTracking(float InSampleRate);
+
+	/** 
+	 * Configure native Enhanced Input capture
+	 * Applied to the first local player right away, and to local players logging in from then on
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="enhanced input capture span config telemetry"))
+	void ConfigureInputCapture(const FTelemetryInputCaptureSettings& Settings);
+
+	/** 
+	 * Capture input spans from this controller with the configured mapping context
+	 * Only needed for controllers that do not go through a game mode login
+	 * @return false if the controller has no Enhanced Input component or the context could not be loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry", meta=(Keywords="enhanced input capture start telemetry"))
+	bool StartInputCapture(APlayerController* PlayerController);
+
+	/** Send one captured input span - called by the input capture (game thread only) */
+	void SendInputSpan(FTelemetryInputSpan&& Span);
+
+	/** 
+	 * Configure per-run ghost recording
+	 * When enabled, each run from the next StartRun on is recorded to its own ghost file
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Telemetry",
+		meta=(Keywords="ghost replay recording config telemetry"))
+	void ConfigureGhostRecording(const FTelemetryGhostSettings& Settings);
+
+	/** Ghost file of the current or last recorded run, empty if none was recorded */
+	UFUNCTION(BlueprintPure, Category = "Telemetry", meta=(Keywords="ghost replay recording file telemetry"))
+	FString GetLastGhostRecordingPath() const { return LastGhostPath; }
+
+	/** Add a tracker to the sampling pass - called by UTelemetryTrackerComponent (game thread only) */
+	void RegisterTracker(UTelemetryTrackerComponent* Tracker);
+
+	/** Remove a tracker from the sampling pass (game thread only) */
+	void UnregisterTracker(UTelemetryTrackerComponent* Tracker);
+
+	/** 
+	 * Send position update - call from a timer
+	 * @param bIsAirborne - Player is jumping/falling, counted towards the run's time airborne
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Telemetry", meta=(Keywords="position update location tracking"))
-	void SendPositionUpdate(FVector Position, float GameTime);
+	void SendPositionUpdate(FVector Position, float GameTime, bool bIsAirborne = false);
 
 	/** 
 	 * Send input action event
@@ -105,19 +371,171 @@ public:
 		meta=(Keywords="death player end"))
 	void SendDeathEvent(const FString& Cause, FVector Position, float GameTime);
 
+	/** Check if a session is currently active */
+	bool IsSessionActive() const { return !CurrentSessionID.IsEmpty(); }
+
+	/** Number of events queued or batched but not yet uploaded */
+	int32 GetPendingEventCount() const;
+
+	/** Number of events dropped because the worker queue was full */
+	int64 GetDroppedEventCount() const;
+
+	/** Trackers in the sampling pass, including any whose actor is already gone */
+	int32 GetNumTrackers() const { return Trackers.Num(); }
+
+protected:
+	/** Flush once this many events are queued */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Batching", meta=(ClampMin="1"))
+	int32 MaxBatchSize = 50;
+
+	/** Flush queued events at least this often (seconds, 0 disables timed flush) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Batching", meta=(ClampMin="0.0"))
+	float FlushInterval = 2.0f;
+
+	/** Layout of the upload body */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Batching")
+	ETelemetryBatchFormat BatchFormat = ETelemetryBatchFormat::JsonArray;
+
+	/** Compression applied to upload bodies */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Compression")
+	ETelemetryCompression Compression = ETelemetryCompression::None;
+
+	/** Bodies smaller than this many bytes are sent uncompressed */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Compression", meta=(ClampMin="0"))
+	int32 MinCompressBytes = 1024;
+
+	/** Dead-reckoning filter for SendPositionUpdate */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Position")
+	FTelemetryAdaptiveSamplingSettings AdaptivePositionSampling;
+
+	/** Position frames per second sent for all tracked actors (0 disables the tracker pass) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Tracking", meta=(ClampMin="0.0"))
+	float TrackerSampleRate = 10.0f;
+
+	/** Actors of these classes get a UTelemetryTrackerComponent when they spawn */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Tracking")
+	TArray<TSoftClassPtr<AActor>> AutoTrackClasses;
+
+	/** Native Enhanced Input capture as input_span events */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Input")
+	FTelemetryInputCaptureSettings InputCapture;
+
+	/** Per-run ghost file of the player's transforms and inputs */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Ghost")
+	FTelemetryGhostSettings Ghost;
+
+	/** Per-run frame time histograms and hitch counts */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Performance")
+	FTelemetryFramePerformanceSettings FramePerformance;
+
+	/** Seconds between delivery_report events, 0 disables them */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Performance", meta=(ClampMin="0.0"))
+	float DeliveryReportInterval = 30.0f;
+
+	/** Sparse position/damage/death grid sent per run or per session */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Heatmap")
+	FTelemetryHeatmapSettings Heatmap;
+
+	/** Send a run_summary event with the run's aggregates just before run_end */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Aggregates")
+	bool bSendRunSummary = true;
+
+	/** Only keep aggregates for position and input - the raw streams are never uploaded */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Aggregates")
+	bool bSummaryOnly = false;
+
+	/** Destinations for events and the event types each receives (empty = HTTP only) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Sinks")
+	TArray<FTelemetrySinkSettings> Sinks;
+
+	/** Frame batches onto a long-lived WebSocket instead of one POST each */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Streaming")
+	FTelemetryStreamingSettings Streaming;
+
+	/** Write every batch to SpoolDirectory until the collector acknowledges it */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Spool")
+	bool bEnableSpool = true;
+
+	/** Where spooled batches are written - empty for Saved/Telemetry/Spool */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Spool")
+	FString SpoolDirectory;
+
+	/** Disk budget for the spool - oldest segments are dropped beyond this */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Spool", meta=(ClampMin="1"))
+	int32 MaxSpoolMegabytes = 64;
+
+	/** Capture policy for SendPositionUpdate (Telemetry.Position.* console variables override it) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Policies")
+	FTelemetryEventPolicy PositionPolicy;
+
+	/** Capture policy for SendPlayerInputAction (Telemetry.Input.*) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Policies")
+	FTelemetryEventPolicy InputPolicy;
+
+	/** Capture policy for SendDamageEvent (Telemetry.Damage.*) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Policies")
+	FTelemetryEventPolicy DamagePolicy;
+
+	/** Capture policy for SendDeathEvent (Telemetry.Death.*) - deaths are never coalesced */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Policies")
+	FTelemetryEventPolicy DeathPolicy;
+
+	/** Uploads outstanding at once - further batches wait for a response */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Backpressure", meta=(ClampMin="1"))
+	int32 MaxInFlightRequests = 4;
+
+	/** Memory held-back events may use before position and input events are shed (0 = never shed) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Backpressure", meta=(ClampMin="0"))
+	int32 MaxBacklogKilobytes = 1024;
+
+	/** Retries of failed uploads and the adaptive batch size */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Backpressure")
+	FTelemetryRetrySettings Retry;
+
+	/** Send repeated JSON payload names as session-scoped IDs (binary batches always use their string table) */
+	UPROPERTY(Config, EditAnywhere, Category = "Telemetry|Batching")
+	bool bUseStringDictionary = false;
+
 private:
-	/** Send JSON telemetry event to server */
-	void SendTelemetryEvent(const TSharedPtr<FJsonObject>& JsonData) const;
+	/** Stamp the record and hand it to the worker - safe from any thread */
+	void SendTelemetryEvent(FTelemetryEventRecord&& Record);
 
-	/** Create base telemetry object with common fields and run data */
-	TSharedPtr<FJsonObject> CreateBaseTelemetryObject(const FString& EventType, float GameTime);
-	
-	/** Create position JSON object from vector */
-	TSharedPtr<FJsonObject> CreatePositionObject(FVector Position);
-	
-	/** Check if telemetry is ready to send events */
+	/** Check if telemetry is ready to send events - safe from any thread */
 	bool IsTelemetryReady() const;
 
+	/** Start a fresh heatmap for the given scope */
+	void BeginHeatmap(ETelemetryHeatmapScope Scope);
+
+	/** Count an event in the active heatmap, if any - safe from any thread */
+	void AddToHeatmap(ETelemetryHeatmapLayer Layer, const FVector& Position);
+
+	/** Hand the heatmap to the worker if one is active for this scope */
+	void SendHeatmap(ETelemetryHeatmapScope Scope, float GameTime);
+
+	/** Queue an event whose payload is a free-form string - safe from any thread */
+	void SendStringEvent(FTelemetryEventRecord&& Record, const FString& Value);
+
+	/** Sample every registered tracker and send one position_frame (ticker callback) */
+	bool SampleTrackers(float DeltaTime);
+
+	/** (Re)start or stop the tracker ticker for TrackerSampleRate */
+	void UpdateTrackerTicker();
+
+	/** Hook actor spawning in a newly started game world for AutoTrackClasses */
+	void OnWorldInitializedActors(const UWorld::FActorsInitializedParams& Params);
+
+	/** Give the actor a tracker if its class is in AutoTrackClasses */
+	void AutoTrackActor(AActor* Actor);
+
+	/** Create the configured sinks and hand them to the worker */
+	void ApplySinks();
+
+	/** Streaming.URL, or the server URL as ws(s)://.../stream */
+	FString GetStreamURL() const;
+
+	/** Start input capture for local players as they log in */
+	void OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+
 	// State Variables
 	
 	/** HTTP endpoint for telemetry server */
@@ -125,6 +543,14 @@ private:
 	
 	/** Current session identifier (machine_timestamp) */
 	FString CurrentSessionID;
+
+	/**
+	 * Damage sources, death causes and end reasons of the current session, replaced by StartNewSession
+	 * Read-locked while a string is added and its event queued, write-locked while the table is
+	 * replaced, so no event reaches the worker behind the session_start of another table.
+	 */
+	TSharedPtr<FTelemetryStringTable, ESPMode::ThreadSafe> SessionStrings;
+	FRWLock SessionStringsLock;
 	
 	/** Machine name (computer name) */
 	FString MachineName;
@@ -132,12 +558,74 @@ private:
 	/** User name (OS username) */
 	FString UserName;
 	
-	/** Current run data (active gameplay attempt) */
+	/** Current run data (active gameplay attempt), aggregates guarded by RunDataLock */
 	FTelemetryRunData CurrentRunData;
+	FCriticalSection RunDataLock;
 	
-	/** Frame counter for event ordering */
-	int32 FrameCounter;
+	/** Frame counter for event ordering - incremented by any producer thread */
+	std::atomic<int32> FrameCounter{0};
+
+	/** Readiness flags mirrored for producers on other threads */
+	std::atomic<bool> bServerConfigured{false};
+	std::atomic<bool> bSessionActive{false};
+
+	/** Serializes and uploads events off the game thread */
+	TSharedPtr<FTelemetryWorker> Worker;
+
+	/** Adaptive position filter, guarded by PositionSamplerLock */
+	TSharedPtr<FTelemetryPositionSampler> PositionSampler;
+	FCriticalSection PositionSamplerLock;
+
+	/** Frame histograms for the active run (game thread only) */
+	TSharedPtr<FTelemetryFramePerformanceCollector> FramePerformanceCollector;
+
+	/** Heatmap being accumulated, guarded by HeatmapLock */
+	TSharedPtr<FTelemetryHeatmap> ActiveHeatmap;
+	ETelemetryHeatmapScope ActiveHeatmapScope = ETelemetryHeatmapScope::Run;
+	bool bHeatmapActive = false;
+	FCriticalSection HeatmapLock;
+
+	/** Components sampled by the tracker pass (game thread only) */
+	TArray<TWeakObjectPtr<UTelemetryTrackerComponent>> Trackers;
+
+	/** AutoTrackClasses resolved once, kept referenced for the subsystem's lifetime */
+	UPROPERTY(Transient)
+	TArray<TSubclassOf<AActor>> LoadedAutoTrackClasses;
+
+	/** Last tracker pass saw a player tracker - SendPositionUpdate then leaves aggregates alone */
+	std::atomic<bool> bPlayerTracked{false};
+
+	/** Numbers position_frame keys so they reuse one name table entry */
+	int32 TrackerFrameSerial = 0;
+
+	FTSTicker::FDelegateHandle TrackerTickerHandle;
+	FDelegateHandle WorldInitializedActorsHandle;
+	FDelegateHandle ActorSpawnedHandle;
+	TWeakObjectPtr<UWorld> AutoTrackWorld;
+
+	/** WebSocket to the collector while Streaming.bEnabled, shared with other instances using StreamURL */
+	TSharedPtr<FTelemetryStreamTransport, ESPMode::ThreadSafe> StreamTransport;
+	FString StreamURL;
+
+	/** Memory sinks by name, for GetCapturedEvents */
+	TMap<FName, TSharedPtr<FTelemetryMemorySink, ESPMode::ThreadSafe>> MemorySinks;
+
+	/** Ghost file writer for the active run */
+	TSharedPtr<FTelemetryGhostRecorder> GhostRecorder;
+	FString LastGhostPath;
+
+	/** Enhanced Input bindings for the local player, null until capture starts */
+	UPROPERTY(Transient)
+	TObjectPtr<UTelemetryInputCapture> ActiveInputCapture;
+
+	FDelegateHandle PostLoginHandle;
+
+	/** Numbers input_span keys (game thread only) */
+	int32 InputSpanSerial = 0;
+
+	/** Numbers session_start, frame_performance, run_summary and heatmap keys (game thread only) */
+	int32 HeldKeySerial = 0;
 
-	/** HTTP request timeout in seconds */
-	static constexpr float RequestTimeout = 5.0f;
+	/** Per-type sampling, rate limit and coalescing, shared with the worker */
+	TSharedPtr<FTelemetryEventPolicies, ESPMode::ThreadSafe> EventPolicies;
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TelemetryTrackerComponent.generated.h"
+
+/**
+ * Marks its owner for position tracking by the telemetry subsystem
+ * The component itself never ticks: the subsystem samples every registered tracker in one
+ * pass at TrackerSampleRate and sends a single position_frame event per pass.
+ * Added automatically to actors of the subsystem's AutoTrackClasses, or by hand in a Blueprint.
+ */
+UCLASS(ClassGroup=(Telemetry), meta=(BlueprintSpawnableComponent))
+class TELEMETRYPLUGIN_API UTelemetryTrackerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTelemetryTrackerComponent();
+
+	/** Name used for this actor in position frames (None = actor name) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	FName TrackingLabel;
+
+	/** Samples also feed run aggregates and the heatmap - on by default for player-controlled pawns */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	bool bIsPlayer = false;
+
+	FName GetTrackingLabel() const;
+
+	/** bIsPlayer, or the owner is a pawn controlled by a local player */
+	bool IsPlayerTracker() const;
+
+	/** Owner is a character that is currently jumping or falling */
+	bool IsAirborne() const;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
@@ -2,11 +2,448 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "TelemetryStringTable.h"
 #include "TelemetryTypes.generated.h"
 
+class UInputMappingContext;
+
+/**
+ * Encoding used for uploaded events
+ */
+UENUM(BlueprintType)
+enum class ETelemetryWireFormat : uint8
+{
+	/** Human readable JSON events, laid out according to ETelemetryBatchFormat */
+	Json UMETA(DisplayName = "JSON"),
+
+	/** Compact schema-versioned binary batches, see TelemetryBinaryFormat.h */
+	Binary UMETA(DisplayName = "Binary")
+};
+
+/**
+ * How batched JSON events are packed into a single upload body
+ */
+UENUM(BlueprintType)
+enum class ETelemetryBatchFormat : uint8
+{
+	/** One JSON array containing every event: [{...},{...}] */
+	JsonArray UMETA(DisplayName = "JSON Array"),
+
+	/** Newline-delimited JSON, one event object per line */
+	NDJson UMETA(DisplayName = "NDJSON")
+};
+
+/**
+ * Where a telemetry sink delivers events
+ */
+UENUM(BlueprintType)
+enum class ETelemetrySinkType : uint8
+{
+	/** The batched, spooled HTTP upload to the configured server */
+	Http UMETA(DisplayName = "HTTP"),
+
+	/** Rotating NDJSON or binary files under Saved/Telemetry/Sinks */
+	File UMETA(DisplayName = "Local File"),
+
+	/** Most recent events kept in memory, read with GetCapturedEvents (tests) */
+	Memory UMETA(DisplayName = "In-Memory"),
+
+	/** Fire-and-forget datagrams to Address - no retry, no spool */
+	Udp UMETA(DisplayName = "UDP")
+};
+
+/**
+ * Compression applied to upload bodies (sent with a matching Content-Encoding header)
+ */
+UENUM(BlueprintType)
+enum class ETelemetryCompression : uint8
+{
+	None UMETA(DisplayName = "None"),
+
+	/** Content-Encoding: gzip */
+	Gzip UMETA(DisplayName = "Gzip"),
+
+	/** Content-Encoding: deflate (zlib stream) - slightly smaller header than gzip */
+	Deflate UMETA(DisplayName = "Deflate")
+};
+
+/**
+ * World plane a heatmap is projected onto
+ */
+UENUM(BlueprintType)
+enum class ETelemetryHeatmapPlane : uint8
+{
+	XY UMETA(DisplayName = "XY (top-down)"),
+
+	/** Side-scroller view - X along the level, Z up */
+	XZ UMETA(DisplayName = "XZ (side view)"),
+
+	YZ UMETA(DisplayName = "YZ")
+};
+
+/**
+ * How long a heatmap accumulates before it is sent
+ */
+UENUM(BlueprintType)
+enum class ETelemetryHeatmapScope : uint8
+{
+	/** One heatmap per run, sent before run_end */
+	Run UMETA(DisplayName = "Per Run"),
+
+	/** One heatmap per session, sent before session_end */
+	Session UMETA(DisplayName = "Per Session")
+};
+
+/**
+ * Running totals for upload compression, used to tune the size/CPU tradeoff per platform
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryCompressionStats
+{
+	GENERATED_BODY()
+
+	/** Bodies that were sent compressed */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int32 BatchesCompressed = 0;
+
+	/** Bodies sent uncompressed (below the minimum size or compression did not help) */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int32 BatchesSkipped = 0;
+
+	/** Input bytes of the compressed bodies */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 UncompressedBytes = 0;
+
+	/** Output bytes of the compressed bodies */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 CompressedBytes = 0;
+
+	/** Total time spent compressing, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	float CompressionTimeMs = 0.0f;
+
+	/** CompressedBytes / UncompressedBytes (1 = no savings) */
+	float GetRatio() const
+	{
+		return UncompressedBytes > 0 ? static_cast<float>(static_cast<double>(CompressedBytes) / UncompressedBytes) : 1.0f;
+	}
+};
+
+/**
+ * Upload backlog and shedding counters, to see backpressure happen while the collector is slow
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryBackpressureStats
+{
+	GENERATED_BODY()
+
+	/** Uploads sent and not yet answered */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int32 InFlightRequests = 0;
+
+	/** Body bytes of the in-flight uploads */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 InFlightBytes = 0;
+
+	/** Encoded batches waiting for a free upload slot */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int32 WaitingBatches = 0;
+
+	/** Events captured but not yet handed to HTTP */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int32 BacklogEvents = 0;
+
+	/** Events encoded into upload bodies so far - what the collector receives unless uploads fail */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 UploadedEvents = 0;
+
+	/** Memory held by held-back events and waiting batches */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 BacklogBytes = 0;
+
+	/** Low-value events (position, input) shed to keep the backlog within budget */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 ShedEvents = 0;
+
+	/** Events dropped because the capture queue was full */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 DroppedEvents = 0;
+
+	/** Uploads sent again after an error or timeout */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 RetriedUploads = 0;
+
+	/** Uploads given up on this session - spooled ones are replayed in the next */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int64 FailedUploads = 0;
+
+	/** Events per upload right now, between MinBatchSize and MaxBatchSize */
+	UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+	int32 BatchSize = 0;
+};
+
+/**
+ * Settings for adaptive (dead-reckoning) position sampling
+ * A position sample is only sent when a linear predictor built from the last two
+ * sent samples would miss it by more than ErrorTolerance, on direction changes and jumps,
+ * or when KeepAliveInterval has passed.
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryAdaptiveSamplingSettings
+{
+	GENERATED_BODY()
+
+	/** Off by default - every SendPositionUpdate is sent */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	bool bEnabled = false;
+
+	/** Max distance (world units) between predicted and actual position before a sample is sent */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float ErrorTolerance = 25.0f;
+
+	/** Send when the movement direction turns by more than this many degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0", ClampMax="180.0"))
+	float DirectionChangeDegrees = 30.0f;
+
+	/** Speeds below this (units/s) count as standing still for direction and jump checks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float MinSpeed = 10.0f;
+
+	/** Always send at least this often (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float KeepAliveInterval = 2.0f;
+
+	/** Coordinates are rounded to multiples of this (0 = full precision) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float QuantizationStep = 1.0f;
+};
+
+/**
+ * Settings for the per-run frame performance collector
+ * While a run is active, frame, game-thread and render-thread times go into log-bucketed
+ * histograms and memory is sampled; EndRun sends it all as one frame_performance event.
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryFramePerformanceSettings
+{
+	GENERATED_BODY()
+
+	/** Off by default - takes effect at the next StartRun */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	bool bEnabled = false;
+
+	/** Frames at or above each of these times (ms) are counted as hitches */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	TArray<float> HitchThresholdsMs = {50.0f, 100.0f, 250.0f};
+
+	/** How often memory use is sampled for the high-water marks (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float MemorySampleInterval = 0.5f;
+};
+
+/**
+ * Settings for the client-side position/damage/death heatmap
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryHeatmapSettings
+{
+	GENERATED_BODY()
+
+	/** Off by default - takes effect at the next StartRun / StartNewSession */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	bool bEnabled = false;
+
+	/** Cell edge length in world units */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="1.0"))
+	float CellSize = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	ETelemetryHeatmapPlane Plane = ETelemetryHeatmapPlane::XZ;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	ETelemetryHeatmapScope Scope = ETelemetryHeatmapScope::Run;
+};
+
+/**
+ * Settings for native Enhanced Input capture
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryInputCaptureSettings
+{
+	GENERATED_BODY()
+
+	/** Off by default - takes effect for the next local player that logs in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	bool bEnabled = false;
+
+	/** Every action mapped in this context is captured */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	TSoftObjectPtr<UInputMappingContext> MappingContext;
+};
+
+/**
+ * Settings for per-run ghost recording
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryGhostSettings
+{
+	GENERATED_BODY()
+
+	/** Off by default - takes effect at the next StartRun */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	bool bEnabled = false;
+
+	/** Pawn transforms recorded per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="1.0"))
+	float SampleRate = 20.0f;
+
+	/** Records held in memory before they reach the file - the recorder's whole memory budget */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="64"))
+	int32 BufferCapacity = 1024;
+};
+
+/**
+ * Settings for the optional WebSocket stream to the collector
+ * Batch bodies go out as frames on one long-lived connection instead of one POST each; the
+ * POST path stays in place for when the stream is down or behind.
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryStreamingSettings
+{
+	GENERATED_BODY()
+
+	/** Off by default - takes effect at the next StartNewSession */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	bool bEnabled = false;
+
+	/** ws:// or wss:// endpoint, empty = the server URL with its scheme swapped and /stream appended */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	FString URL;
+
+	/** First reconnect attempt after the stream drops, doubled per failure */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.1"))
+	float ReconnectDelay = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.1"))
+	float MaxReconnectDelay = 30.0f;
+
+	/** Seconds a dead stream may hold batches before they are POSTed instead */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float FallbackDelay = 5.0f;
+
+	/** Unacknowledged bytes on the stream before further batches are POSTed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="16"))
+	int32 MaxUnackedKilobytes = 1024;
+};
+
+/**
+ * How failed uploads are retried and how the batch size follows collector health
+ * Connection errors, timeouts, 408, 429 and 5xx are retried after an exponential backoff with
+ * full jitter, so a fleet of clients does not hit a recovering collector in lockstep. Retries
+ * are also limited by a budget earned by successful uploads. The batch size grows by a tenth of
+ * MaxBatchSize per fast success and halves on every error or slow response.
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryRetrySettings
+{
+	GENERATED_BODY()
+
+	/** Retries per upload before it is left in the spool for the next session */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0"))
+	int32 MaxRetries = 4;
+
+	/** Backoff before the first retry, doubled per attempt up to MaxDelay, then jittered */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float BaseDelay = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float MaxDelay = 30.0f;
+
+	/** Retries earned per successful upload - a collector that keeps failing is not retried harder */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float RetryBudgetRatio = 0.2f;
+
+	/** Floor for the adaptive batch size */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="1"))
+	int32 MinBatchSize = 10;
+
+	/** Responses slower than this shrink the batch size like errors do */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float SlowResponseMs = 1000.0f;
+};
+
+/**
+ * One destination for events, configured as +Sinks=(...) in ini
+ * Session and run lifecycle events always reach every sink, so each stream stays attributable.
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetrySinkSettings
+{
+	GENERATED_BODY()
+
+	/** Identifies the sink in logs, file names and GetCapturedEvents */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	ETelemetrySinkType Type = ETelemetrySinkType::Http;
+
+	/** event_type names this sink receives (e.g. "death", "position_frame"), empty = all */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	TArray<FString> EventTypes;
+
+	/** File and UDP sinks: NDJSON lines or binary batches (HTTP uses the Configure wire format) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	ETelemetryWireFormat WireFormat = ETelemetryWireFormat::Json;
+
+	/** UDP sinks: host:port */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry")
+	FString Address;
+
+	/** File sinks: start a new file beyond this size */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="64"))
+	int32 MaxFileKilobytes = 8192;
+
+	/** File sinks: oldest files beyond this many are deleted */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="1"))
+	int32 MaxFiles = 8;
+
+	/** Memory sinks: events kept */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="1"))
+	int32 MemoryCapacity = 10000;
+};
+
+/**
+ * Capture policy for one event type
+ * Sampling and rate limiting are applied before the event is built, so suppressed events cost
+ * almost nothing. Coalescing merges a burst inside the window into one event (positions keep
+ * the latest sample, repeated input actions the first, damage from one source sums the damage
+ * and keeps the first HealthBefore and last HealthAfter). Deaths are never coalesced.
+ * Each value can be overridden at runtime with the matching Telemetry.<Type>.* console variable.
+ */
+USTRUCT(BlueprintType)
+struct TELEMETRYPLUGIN_API FTelemetryEventPolicy
+{
+	GENERATED_BODY()
+
+	/** Fraction of events kept (1 = all, 0 = none), evenly spaced */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0", ClampMax="1.0"))
+	float SampleRate = 1.0f;
+
+	/** Events kept per second, bursts up to one second's worth (0 = unlimited) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float MaxEventsPerSecond = 0.0f;
+
+	/** Merge events arriving within this many seconds of the first one (0 = off) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Telemetry", meta=(ClampMin="0.0"))
+	float CoalesceWindow = 0.0f;
+};
+
 /**
  * Run data that tracks individual gameplay attempts within a session
  * Embedded in all telemetry events to provide run context
+ * Also keeps running aggregates, each updated in O(1) per event and sent as one
+ * run_summary event with run_end.
  */
 USTRUCT(BlueprintType)
 struct TELEMETRYPLUGIN_API FTelemetryRunData
@@ -32,7 +469,39 @@ struct TELEMETRYPLUGIN_API FTelemetryRunData
 	/** Why the run ended (e.g., "death", "quit", "victory") */
 	UPROPERTY(BlueprintReadWrite, Category = "Telemetry")
 	FString EndReason;
-	
+
+	/** Rooms/arenas cleared this run */
+	UPROPERTY(BlueprintReadWrite, Category = "Telemetry")
+	int32 RoomsCleared = 0;
+
+	/** Path length between consecutive position updates (world units) */
+	UPROPERTY(BlueprintReadWrite, Category = "Telemetry")
+	float DistanceTravelled = 0.0f;
+
+	/** Seconds between position updates that reported the player airborne */
+	UPROPERTY(BlueprintReadWrite, Category = "Telemetry")
+	float TimeAirborne = 0.0f;
+
+	/** Sum of all damage taken */
+	UPROPERTY(BlueprintReadWrite, Category = "Telemetry")
+	float DamageTaken = 0.0f;
+
+	/** Death events this run */
+	UPROPERTY(BlueprintReadWrite, Category = "Telemetry")
+	int32 Deaths = 0;
+
+	/** Input action triggers by action name */
+	UPROPERTY(BlueprintReadWrite, Category = "Telemetry")
+	TMap<FName, int32> InputCounts;
+
+	/** Damage taken by damage source - case-sensitive, so not exposed to Blueprint */
+	TMap<FString, float, FDefaultSetAllocator, TTelemetryCaseSensitiveKeyFuncs<float>> DamageBySource;
+
+	/** Previous position update, for distance and airborne time */
+	FVector LastPosition = FVector::ZeroVector;
+	float LastPositionTime = 0.0f;
+	bool bHasLastPosition = false;
+	bool bLastAirborne = false;
 
 	FTelemetryRunData()
 		: RunStartTime(0.0f)
@@ -51,6 +520,11 @@ struct TELEMETRYPLUGIN_API FTelemetryRunData
 		JsonObject->SetNumberField(TEXT("run_end_time"), RunEndTime);
 		JsonObject->SetNumberField(TEXT("run_total_time"), RunTotalTime);
 		JsonObject->SetStringField(TEXT("end_reason"), EndReason);
+		JsonObject->SetNumberField(TEXT("rooms_cleared"), RoomsCleared);
+		JsonObject->SetNumberField(TEXT("distance_travelled"), DistanceTravelled);
+		JsonObject->SetNumberField(TEXT("time_airborne"), TimeAirborne);
+		JsonObject->SetNumberField(TEXT("damage_taken"), DamageTaken);
+		JsonObject->SetNumberField(TEXT("deaths"), Deaths);
 		return JsonObject;
 	}
 
@@ -59,6 +533,34 @@ struct TELEMETRYPLUGIN_API FTelemetryRunData
 	{
 		return !RunID.IsEmpty() && RunEndTime == 0.0f;
 	}
+
+	/** Accumulate distance and airborne time from a position update */
+	void AddPosition(const FVector& Position, float GameTime, bool bAirborne)
+	{
+		if (bHasLastPosition)
+		{
+			DistanceTravelled += static_cast<float>(FVector::Dist(LastPosition, Position));
+			if (bLastAirborne && GameTime > LastPositionTime)
+			{
+				TimeAirborne += GameTime - LastPositionTime;
+			}
+		}
+		LastPosition = Position;
+		LastPositionTime = GameTime;
+		bHasLastPosition = true;
+		bLastAirborne = bAirborne;
+	}
+
+	void AddInput(FName ActionName)
+	{
+		++InputCounts.FindOrAdd(ActionName);
+	}
+
+	void AddDamage(const FString& Source, float Amount)
+	{
+		DamageTaken += Amount;
+		DamageBySource.FindOrAdd(Source) += Amount;
+	}
 };
 
 /**
@@ -39,11 +39,22 @@ public class TelemetryPlugin : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"Slate",
-				"SlateCore", "EnhancedInput"
+				"SlateCore", "EnhancedInput",
+				"RenderCore", // Game/render thread frame times
+				"Sockets", "Networking", // UDP sink
+				"WebSockets" // Streaming transport
 				// ... add private dependencies that you statically link with here ...
 			}
 		);
 
+		// Local collector for tests, benchmarks and soak runs, inflating upload bodies with zlib
+		// Development tooling only - the code is compiled out with UE_BUILD_SHIPPING
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			PrivateDependencyModuleNames.Add("HTTPServer");
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+		}
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{